@@ -3,15 +3,103 @@
  *
  *  Created on: Nov 4, 2025
  *      Author: user13
+ *
+ *  판단은 AutoMode_Step: 입력(시각 + 초음파 프레임) + 상태 → 출력(방향 + 속도 명령)
+ *   - 센서/시계/모터/기록을 직접 건드리지 않음 — 상태는 전부 AutoState_t 안 (인스턴스 여러 개 가능)
+ *   - 튜닝 파라미터만 PARAM() 전역 (Param_Sync 는 호출자가 주기 경계에서)
+ *   - 상태 전이는 automode.c 의 const 표 (fsm.h 엔진) — STARTUP / DRIVE / PIVOT / ARC / BUMP
+ *  보드는 AutoMode_Start / AutoMode_Update (기본 인스턴스 하나 + 센서 읽기 + AutoMode_Act + 기록)
  */
 
 #ifndef INC_AUTOMODE_H_
 #define INC_AUTOMODE_H_
 
 #include "main.h"
+#include "ultrasonic.h"
+#include "fsm.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// 상태/모드/방향 (기록 state/mode/dir 값 그대로)
+typedef enum { AUTO_ST_DRIVE, AUTO_ST_TURN } auto_st_t;
+typedef enum { AUTO_TURN_PIVOT, AUTO_TURN_ARC } auto_turn_t;
+typedef enum { AUTO_DIR_LEFT = -1, AUTO_DIR_RIGHT = +1 } auto_dir_t;
+
+// 출력: 방향핀 (move.c) + 속도 명령 (speed.c 슬루는 그대로 — 명령만 고름)
+typedef enum {
+  AUTO_ACT_KEEP = 0,       // 방향핀 그대로 (Pivot 진행 중)
+  AUTO_ACT_FORWARD,        // drive_forward
+  AUTO_ACT_PIVOT_LEFT,     // pivot_left
+  AUTO_ACT_PIVOT_RIGHT     // pivot_right
+} AutoAction_t;
+
+typedef enum {
+  AUTO_SPD_KEEP = 0,
+  AUTO_SPD_SLOW,           // auto_motor_slow (절대값 — 같은 주기의 앞 명령을 덮음)
+  AUTO_SPD_UP,             // auto_motor_speedUp
+  AUTO_SPD_LEFT_DOWN,      // auto_motor_left_speedDown  (ARC 좌 바이어스)
+  AUTO_SPD_RIGHT_DOWN,     // auto_motor_right_speedDown (ARC 우 바이어스)
+  AUTO_SPD_DOWN            // auto_motor_speedDown (TTC 거버너)
+} AutoSpeed_t;
+
+typedef struct {
+  uint32_t   now_ms;       // HAL_GetTick
+  us_frame_t us;           // US_GetFrame (거리 cm + 추적 속도/신뢰 + C 흔들림)
+  uint16_t   pwm;          // get_speed 좌우 평균 (이번 명령 전 CCR) — TTC 거버너만 씀
+} AutoInput_t;
+
+typedef struct {
+  AutoAction_t action;
+  AutoSpeed_t  speed;
+} AutoOutput_t;
+
+// 판단 상태 (예전 automode.c 파일 static 전부)
+typedef struct {
+  Fsm_t       fsm;                 // 현재 상태 / 진입 시각 / 전이 추적
+
+  // 기록용 보기 (state/mode 는 진입 동작이 맞춤 — BUMP/STARTUP 중엔 그 전 값)
+  auto_st_t   state;
+  auto_turn_t mode;
+  auto_dir_t  dir;
+  uint32_t    deadline_ms;         // ARC 최소 유지 끝
+
+  int8_t      dir_vote;
+  uint32_t    next_decide_ms;
+  uint32_t    hold_until_ms;
+
+  uint8_t     fast_close_streak;   // C 속도가 임계 밖인 연속 주기 수
+  uint8_t     fast_open_streak;
+  int16_t     vC;                  // 마지막 주기 C 접근 속도 (기록용)
+  bool        vC_ready;
+  bool        vC_wobble;
+
+  // 연속커브/방지턱/바이어스 보조
+  uint32_t    last_turn_end;
+  uint32_t    arc_chain_until;
+  uint32_t    bump_until;
+  uint32_t    speedup_cool_until;
+  uint32_t    last_arc_bias_ms;
+  uint8_t     arc_phase;
+
+  // TTC 거버너 (GOV_MODE 1): 접근 속도 = 추적기 rate_cms (L/R/C 모두, 신뢰도 통과 시)
+  bool        vL_ready;            // 마지막 주기 L/R 추적 신뢰도 (기록용)
+  bool        vR_ready;
+  uint16_t    ttc_ms;              // 마지막 주기 최소 TTC (접근 없음 = 0xFFFF)
+  uint32_t    speeddown_cool_until;
+} AutoState_t;
+
+void         AutoMode_Init(AutoState_t *st, uint32_t now_ms);
+AutoOutput_t AutoMode_Step(AutoState_t *st, const AutoInput_t *in);
+void         AutoMode_Act(AutoOutput_t out);                  // speed.c / move.c 로
+
+// fsm 상태 번호 (automode.c AUTO_FSM 표 순서)
+enum { AUTO_FSM_STARTUP = 0, AUTO_FSM_DRIVE, AUTO_FSM_PIVOT, AUTO_FSM_ARC, AUTO_FSM_BUMP, AUTO_FSM_NUM };
 
 void AutoMode_Start();
 void AutoMode_Update();
-void get_speed(uint16_t *right_pwm, uint16_t *left_pwm);
+const Fsm_t *AutoMode_Fsm(void);                              // 기본 인스턴스 (호스트 랩별 분해)
+void AutoMode_Command(const char *arg);                       // 콘솔 "fsm [reset|n]" (param.c)
+void AutoMode_Hold(bool hold);                                // 콘솔 "stop" / "go" (param.c)
+bool AutoMode_Idle(void);                                     // stop 이 모터에 반영됨 (save 허용)
 
 #endif /* INC_AUTOMODE_H_ */
@@ -0,0 +1,105 @@
+/*
+ * fsm.h — 표 구동 상태기계 (상태 / 가드 / 진입 동작 / 타임아웃은 const 표 → 플래시)
+ *
+ *  한 주기 Fsm_Step:
+ *   1) 전역 전이 (어느 상태에서나 — FSM_S_NO_GLOBAL 상태는 건너뜀)
+ *   2) 현재 상태 본문 run
+ *   3) 타임아웃 (진입 후 tmo ms) → 4) 상태의 전이 표를 순서대로, 처음 참인 가드 하나
+ *   전이 = 전이 동작(act) → 새 상태 진입 동작(entry). 전이하면 그 주기는 끝
+ *     FSM_E_GO  같은 주기에 새 상태로 1) 부터 다시 (최대 FSM_PASS_MAX 번)
+ *     FSM_BACK  직전 상태로 돌아감 — 진입 동작 없이, 타임아웃 기준 시각도 되돌림 (끼어드는 상태용)
+ *  비용: 전역 전이 수 + 현재 상태의 가드 수 (상태 수와 무관)
+ *
+ *  추적: 전이마다 (시각, from, to, 전이) 를 링에 — 같은 전이가 연달아 나면 횟수만 올림
+ *        상태별 누적 시간 (dwell) — 랩/구간마다 빼서 어디서 시간을 쓰는지
+ *  콘솔(USART2): "fsm" 누적 시간 + 최근 전이, "fsm reset" (automode.c AutoMode_Command)
+ */
+
+#ifndef INC_FSM_H_
+#define INC_FSM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define FSM_STATE_MAX    8u
+#define FSM_TRACE_N     64u      // 2의 거듭제곱
+#define FSM_PASS_MAX     4u
+
+#define FSM_BACK       0xFFu     // FsmEdge_t.to: 직전 상태로
+
+// FsmEdge_t.flags
+#define FSM_E_GO       0x01u
+// FsmState_t.flags
+#define FSM_S_NO_GLOBAL 0x01u
+
+// FsmTrace_t.edge: 상태 전이 표 번호, 아니면
+#define FSM_EDGE_GLOBAL 0x80u    // | 전역 전이 번호
+#define FSM_EDGE_TMO    0x7Fu
+
+typedef bool (*fsm_guard_t)(void *ctx);
+typedef void (*fsm_act_t)(void *ctx);
+
+typedef struct {
+  const char  *name;       // 추적 출력용
+  fsm_guard_t  guard;      // 부작용 없이 (타임아웃 전이는 안 봄)
+  fsm_act_t    act;        // 전이 동작 (진입 동작 앞, NULL 가능)
+  uint8_t      to;         // 상태 번호 또는 FSM_BACK
+  uint8_t      flags;
+} FsmEdge_t;
+
+typedef struct {
+  const char      *name;
+  fsm_act_t        entry;       // NULL 가능
+  fsm_act_t        run;         // 머무는 주기마다 (전이 검사 앞)
+  uint16_t         tmo_ms;      // 0 = 타임아웃 없음
+  const int16_t   *tmo_ref;     // NULL 아니면 tmo_ms 대신 *tmo_ref [ms] (주기마다 읽음 — 런타임 파라미터 등)
+  uint8_t          flags;
+  FsmEdge_t        tmo;         // 타임아웃 전이 (guard 무시)
+  const FsmEdge_t *edge;
+  uint8_t          edge_num;
+} FsmState_t;
+
+typedef struct {
+  const char       *name;
+  const FsmState_t *state;
+  uint8_t           state_num;
+  const FsmEdge_t  *global;
+  uint8_t           global_num;
+} FsmDef_t;
+
+typedef struct {
+  uint32_t t_ms;           // 첫 전이 시각
+  uint8_t  from, to;
+  uint8_t  edge;           // FSM_EDGE_* 참고
+  uint8_t  rep;            // 같은 전이 연속 횟수 (255 에서 멈춤)
+} FsmTrace_t;
+
+typedef struct {
+  const FsmDef_t *def;
+  uint8_t    cur, prev;
+  uint32_t   entered_ms;          // 타임아웃 기준
+  uint32_t   prev_entered_ms;     // FSM_BACK 으로 되돌릴 값
+  uint32_t   since_ms;            // dwell 기준 (상태가 바뀔 때마다)
+  uint32_t   dwell_ms[FSM_STATE_MAX];
+  uint32_t   transitions;
+  uint32_t   head;                // 기록한 전이 수 (링 위치는 & (N-1))
+  FsmTrace_t trace[FSM_TRACE_N];
+} Fsm_t;
+
+// start 의 진입 동작은 부르지 않음 (호출자가 초기 상태를 직접 맞춤)
+void     Fsm_Init(Fsm_t *f, const FsmDef_t *def, uint8_t start, uint32_t now_ms);
+void     Fsm_Step(Fsm_t *f, void *ctx, uint32_t now_ms);
+
+static inline uint8_t Fsm_State(const Fsm_t *f) { return f->cur; }
+
+// 상태별 누적 시간 [ms] (지금 상태의 진행분 포함)
+void     Fsm_Dwell(const Fsm_t *f, uint32_t now_ms, uint32_t out[FSM_STATE_MAX]);
+// k 번째로 최근 전이 (0 = 마지막), 없으면 false
+bool     Fsm_TraceAt(const Fsm_t *f, uint16_t k, FsmTrace_t *out);
+uint16_t Fsm_TraceNum(const Fsm_t *f);
+const char *Fsm_EdgeName(const Fsm_t *f, const FsmTrace_t *t);
+void     Fsm_ResetStats(Fsm_t *f, uint32_t now_ms);
+
+void     Fsm_Dump(const Fsm_t *f, uint32_t now_ms, uint16_t n);   // printf: dwell + 최근 n 개 전이
+
+#endif /* INC_FSM_H_ */
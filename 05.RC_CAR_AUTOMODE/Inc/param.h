@@ -0,0 +1,89 @@
+/*
+ * param.h — 런타임 튜닝 파라미터 테이블 (automode.c / speed.c)
+ *
+ *  - 필드마다 ID / 타입 / 범위 / 기본값 (param.c PARAM_DESC)
+ *  - 플래시 마지막 섹터에 버전 블록으로 저장, 부팅 시 로드 (없거나 깨지면 기본값)
+ *  - UART 한 줄 명령:  list | get NAME | set NAME VALUE | save | load | default
+ *  - 변경은 편집본에만 반영되고, 제어 루프 시작(Param_Sync)에서 한꺼번에 적용
+ */
+
+#ifndef INC_PARAM_H_
+#define INC_PARAM_H_
+
+#include "main.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define PARAM_VERSION  2u   // 필드 의미가 바뀌면 올림 (추가만 하면 그대로 — 뒤쪽은 기본값)
+
+#define PARAM_SPEED_BASE_DEF  390   // SPEED_BASE 기본값 (speed.c 가 Param_Init 전 초기값으로도 씀)
+
+typedef enum {
+  // automode.c — 코너 판단 임계
+  P_FRONT_PIVOT_CM = 0,
+  P_FRONT_ARC_CM,
+  P_FRONT_CLEAR_CM,
+  P_FRONT_TOO_CLOSE,
+  // automode.c — 회전/커브 유지 시간, 안정화
+  P_TURN_MS,
+  P_ARC_MIN_MS,
+  P_ARC_MAX_MS,
+  P_DECIDE_EVERY_MS,
+  P_HOLD_DRIVE_MS,
+  P_HOLD_TURN_MS,
+  // automode.c — C 접근 속도 [cm/s] (v2: 예전 ΔC [cm/주기] 자리)
+  P_VC_FAST_CLOSE_CMS,
+  P_VC_FAST_OPEN_CMS,
+  P_DC_CLOSE_STREAK_N,
+  P_DC_OPEN_STREAK_N,
+  // speed.c — CCR 단위
+  P_SPEED_MIN,
+  P_SPEED_BASE,
+  P_SPEED_CRUISE,
+  P_SPEED_MAX,
+  P_STEP_UP,
+  P_STEP_DOWN,
+  P_STEP_DIFF,
+  // automode.c — 방지턱 감지 / 연속커브 / 속도 거버너 (v1 블록 뒤에 추가)
+  P_BUMP_WINDOW_MS,
+  P_BUMP_HOLD_MS,
+  P_CHAIN_MS,
+  P_GOV_SLOW_CM,
+  P_GOV_FAST_CM,
+  // automode.c — TTC 거버너 (v2 블록 뒤에 추가)
+  P_GOV_MODE,
+  P_GOV_TTC_MS,
+
+  P_NUM
+} param_id_t;
+
+typedef enum { PT_U8, PT_U16, PT_I16 } param_type_t;
+
+typedef struct {
+  const char  *name;
+  param_type_t type;
+  int16_t      min, max, def;
+} param_desc_t;
+
+// 제어 루프가 읽는 현재값 (쓰기는 Param_Sync 만)
+extern int16_t g_param[P_NUM];
+#define PARAM(name)  (g_param[P_##name])
+
+void  Param_Init(void);                     // 부팅 시 1회 (플래시 → 실패 시 기본값)
+void  Param_Sync(void);                     // 제어 루프 시작에서 호출
+
+const param_desc_t *Param_Desc(param_id_t id);
+int   Param_Find(const char *name);         // 없으면 -1
+bool  Param_Set(param_id_t id, int32_t v);  // 범위/상호조건 위반 시 false
+bool  Param_Load(void);
+bool  Param_Save(void);                     // 섹터 지우기 동안 CPU 정지 (콘솔 save 는 AutoMode_Idle 일 때만)
+void  Param_Default(void);
+
+void  Param_Exec(const char *line);         // 명령 한 줄 처리 (결과는 printf)
+
+// UART 명령 수신 (USART2)
+void  Param_UartStart(UART_HandleTypeDef *huart);
+void  Param_UartRxCplt(UART_HandleTypeDef *huart);   // HAL_UART_RxCpltCallback 에서
+void  Param_Poll(void);                               // 태스크에서: 받은 줄 처리
+
+#endif /* INC_PARAM_H_ */
@@ -0,0 +1,56 @@
+/*
+ * prof.h — DWT 사이클 카운터 프로파일링 프로브
+ *
+ *  const uint32_t t0 = Prof_Begin();  ...  Prof_End(PROF_xxx, t0);
+ *   - 프로브마다 호출 수 / 최소 / 최대 / 합 + log2 히스토그램 (bin k = 2^k ~ 2^(k+1)-1 사이클)
+ *   - Prof_End 는 CYCCNT 읽기 + 덧셈/비교 몇 개 + CLZ (약 20 사이클) → 상시 켜 둠
+ *   - 한 프로브는 한 문맥(ISR 또는 한 태스크)에서만 갱신 → 잠금 없음
+ *   - CYCCNT 는 100MHz 에서 42.9초마다 돎 — 한 구간이 그보다 짧으면 뺄셈으로 충분
+ *
+ *  콘솔(USART2): "prof" 표 출력, "prof reset" 통계 초기화 (param.c)
+ *  PROF_ENABLE=0 으로 빌드하면 프로브가 전부 사라짐
+ */
+
+#ifndef INC_PROF_H_
+#define INC_PROF_H_
+
+#include "main.h"
+#include <stdint.h>
+
+#ifndef PROF_ENABLE
+#define PROF_ENABLE  1
+#endif
+
+typedef enum {
+  PROF_TIM4_IRQ = 0,   // TIM4_IRQHandler 전체 (업데이트 + 에코 마감 CC4, 캡처 에지는 DMA)
+  PROF_EDGE_DMA_IRQ,   // DMA1_Stream0/3/7 (캡처 링 하프/완료 = 하강 에지 → 태스크 알림)
+  PROF_US_PROCESS,     // processUltrasonic_All
+  PROF_US_FILTER,      // filter_once
+  PROF_AUTO_UPDATE,    // AutoMode_Update (Param_Sync + 판단 + 기록 포함)
+  PROF_APPLY_PWM,      // apply_pwm (speed.c)
+  PROF_NUM
+} prof_id_t;
+
+#define PROF_BINS  32u
+
+typedef struct {
+  uint32_t calls;
+  uint32_t min, max;
+  uint64_t sum;
+  uint32_t hist[PROF_BINS];
+} prof_stat_t;
+
+#if PROF_ENABLE
+static inline uint32_t Prof_Begin(void) { return DWT->CYCCNT; }
+void Prof_End(prof_id_t id, uint32_t t0);
+#else
+static inline uint32_t Prof_Begin(void) { return 0u; }
+static inline void     Prof_End(prof_id_t id, uint32_t t0) { (void)id; (void)t0; }
+#endif
+
+void Prof_Init(void);                                  // DWT 켜고 통계 초기화 (main.c)
+void Prof_Reset(void);
+void Prof_Get(prof_id_t id, prof_stat_t *out);         // 일관된 스냅샷
+void Prof_Command(const char *arg);                    // 콘솔 "prof [reset]"
+
+#endif /* INC_PROF_H_ */
@@ -0,0 +1,82 @@
+/*
+ * recorder.h — 주행 기록기 (제어 주기마다 고정 크기 바이너리 레코드)
+ *
+ *  - AutoMode_Update 끝에서 1레코드 → RAM 링 (항상 켜짐, 최근 REC_RING_N 개 보관)
+ *  - USART2 DMA 로 백그라운드 송출 (rec on) / 벽에 박은 뒤 링 통째로 덤프 (rec dump)
+ *  - 레코드 형식이 바뀌면 REC_VERSION 을 올림 (호스트 디코더가 버전으로 풀이를 고르고 CRC 로 검사)
+ *
+ *  레코드 36B, little-endian (Cortex-M4 / x86 동일)
+ *    off  0  sync     0xA5
+ *    off  1  version  REC_VERSION
+ *    off  2  seq      레코드 번호 (끊기면 드롭)
+ *    off  4  tick     HAL_GetTick [ms]
+ *    off  8  echo_us  [L,R,C] 원시 에코 폭 (ultrasonic.c echoTime)
+ *    off 14  dist_cm  [L,R,C] 필터 출력 (filter_distance_cm)
+ *             ↑ 둘 다 그 주기 판단에 쓴 US_GetFrame 프레임 (Rec_Frame 인자)
+ *    off 20  state / mode / dir / flags   (automode.c s_state/s_mode/s_dir)
+ *    off 24  vC       C 추적 속도 [cm/s] (us_frame_t rate_cms[C], v1 은 ΔC 3샘플 평균 [cm/주기])
+ *    off 26  vL, vR   L/R 추적 속도 [cm/s] (rate_cms[L/R], v3 부터 — TTC 거버너 입력)
+ *    off 30  ccr1     TIM3 CCR1 (우)
+ *    off 32  ccr2     TIM3 CCR2 (좌)
+ *    off 34  crc      CRC-16/CCITT (0xFFFF 시작), off 0~33
+ *
+ *  115200bps 에서 36B × 200Hz = 7.2KB/s (대역 약 63%)
+ */
+
+#ifndef INC_RECORDER_H_
+#define INC_RECORDER_H_
+
+#include "main.h"
+#include "ultrasonic.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define REC_VERSION   3u
+#define REC_SYNC      0xA5u
+#define REC_RING_N    512u     // 2의 거듭제곱, 5ms 주기면 약 2.5초 (18KB)
+
+// flags
+#define REC_F_BUMP     0x01u   // 방지턱 통과 중
+#define REC_F_STARTUP  0x02u   // 시작 직후 회전 금지 구간
+#define REC_F_VC_READY 0x04u   // C 추적 신뢰도가 판단 기준 이상 (automode VC_CONF_MIN)
+#define REC_F_WOBBLE   0x08u   // C 추적 혁신이 번갈아 튐
+#define REC_F_VL_READY 0x10u   // L 추적 신뢰도가 판단 기준 이상
+#define REC_F_VR_READY 0x20u   // R
+
+typedef struct {
+  uint8_t  sync;
+  uint8_t  version;
+  uint16_t seq;
+  uint32_t tick;
+  uint16_t echo_us[3];
+  uint16_t dist_cm[3];
+  uint8_t  state;
+  uint8_t  mode;
+  int8_t   dir;
+  uint8_t  flags;
+  int16_t  vC;
+  int16_t  vL;
+  int16_t  vR;
+  uint16_t ccr1;
+  uint16_t ccr2;
+  uint16_t crc;
+} rec_t;
+
+_Static_assert(sizeof(rec_t) == 36, "rec_t layout is part of the log format");
+
+typedef enum {
+  REC_RING = 0,   // 링에만 기록 (기본)
+  REC_STREAM,     // 기록 + 실시간 송출
+  REC_DUMP        // 기록 멈추고 링 전체 송출 → 끝나면 REC_RING
+} rec_mode_t;
+
+void     Rec_Init(UART_HandleTypeDef *huart);
+void     Rec_Frame(const us_frame_t *us, uint8_t state, uint8_t mode, int8_t dir, uint8_t flags, int16_t vC);
+void     Rec_SetMode(rec_mode_t m);
+void     Rec_UartTxCplt(UART_HandleTypeDef *huart);   // HAL_UART_TxCpltCallback 에서
+void     Rec_Command(const char *arg);                // 콘솔 "rec [on|off|dump]" (param.c)
+bool     Rec_Last(rec_t *out);                        // 가장 최근 레코드 (호스트 replay 비교용)
+
+uint16_t Rec_Crc16(const void *data, uint32_t len);
+
+#endif /* INC_RECORDER_H_ */
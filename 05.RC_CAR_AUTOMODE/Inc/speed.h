@@ -28,5 +28,6 @@ void auto_motor_right_speedUp();
 void auto_motor_left_speedDown();
 void auto_motor_right_speedDown();
 void auto_motor_slow();
+void get_speed(uint16_t *right_pwm, uint16_t *left_pwm);   // 현재 CCR1/CCR2 명령값 (거버너 입력)
 
 #endif /* INC_SPEED_H_ */
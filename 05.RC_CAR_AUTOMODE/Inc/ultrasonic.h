@@ -14,8 +14,14 @@
 #include "gpio.h"
 
 #include "delay_us.h"
+#include "cmsis_os2.h"
+#include "us_sched.h"
+#include "us_median.h"
+#include "us_track.h"
 #include "stdio.h"
+#include <stdbool.h>
 
+// TRIG 는 TIM1 CC1/CC2 DMA 가 BSRR 한 곳에 쓰므로 세 핀 모두 같은 포트여야 함 (ultrasonic.c)
 #define TRIG_PORT_LEFT	  GPIOC
 #define TRIG_PIN_LEFT	    GPIO_PIN_8
 #define TRIG_PORT_RIGHT	  GPIOC
@@ -35,9 +41,75 @@ void US_Update();
 void US_Init();
 void US_FilterInit();
 
+// 이벤트 구동: 하강 엣지 ISR 이 task 에 US_FLAG_ECHO 를 세움 → US_Update, 없으면 US_IdleMs 만큼 잠
+#define US_FLAG_ECHO  0x0001u
+void US_SetNotify(osThreadId_t task);
+uint32_t US_IdleMs(void);
+
+// true: TIM1 이 슬롯 순서대로 트리거를 혼자 돌림 (US_TRIG_AUTONOMOUS=1 이면 US_Init 에서 켬)
+void US_SetAutoTrigger(bool on);
+
+// 트리거 슬롯 정책 (us_sched.c)
+//  SEQ : L-C-R-C 한 개씩 (기본)
+//  PAIR: L+R 동시 → C, 기대 에코 창 밖 샘플 보류 — 고정 모드에서도 에코가 다 오면 12ms 에서 마감
+//  RISK: 속도/C 접근 속도/회전 상태로 센서별 가중치 → 슬롯마다 한 개씩 골라 쏨
+void       US_SetSchedule(us_sched_t s);   // 다음 US_Update 에서 반영
+us_sched_t US_GetSchedule(void);
+void       US_Command(const char *arg);    // 콘솔 "us [seq|pair|risk|adapt|fixed|med=L/R/C|temp=C]" (param.c)
+
+// automode 주기마다: 정책 입력 (C 추적 속도 [cm/s], 주행 상태, 회전 방향)
+void       US_SetDriveHint(int16_t vC, us_drive_t drive, int8_t dir);
+// 직전 1초 창의 센서별 실제 샷 수 [L,R,C]
+void       US_GetRate(uint16_t out[3]);
+
+// 슬롯 길이: true 면 쏜 센서 에코가 다 온 뒤 (버스트 + 에코 x2 + 잔향 여유) 로 조기 마감,
+// 무에코 / 범위 밖이 섞이면 TRIG_GAP_MS 가드 (US_GAP_ADAPTIVE 가 부팅 기본값)
+void US_SetAdaptiveGap(bool on);
+bool US_GetAdaptiveGap(void);
+
+// 에코 마감: 고정/적응 트리거 모두 샷마다 TIM4 CH4 비교로 ECHO_DEADLINE_US(25ms) 뒤 마감을 걺
+//  그때까지 하강 엣지가 없으면 (무에코 38ms 펄스, 모듈 무응답, 캡처가 falling 에 걸린 채) 채널을 끄고
+//  거리를 US_OPEN_CM 으로 — 이전값을 그대로 두지 않고 "4m 안에 아무것도 없음" 을 따로 알림
+//  그 센서는 모듈이 무에코 펄스를 끝낼 때까지 (~40ms) 슬롯에서 빠짐, 자율 트리거(US_SetAutoTrigger)에선 안 씀
+#define US_OPEN_CM  401u
+
+// 센서별 미디언 창 [L,R,C] (1..US_MED_WIN_MAX, 빌드 시 MEDIAN_WIN_L/R/C) — 다음 US_Update 에서 현재 출력으로 새 창을 채움
+bool US_SetMedianWin(const uint8_t win[3]);   // 범위 밖이면 false
+void US_GetMedianWin(uint8_t win[3]);
+
 uint16_t US_Left_cm();
 uint16_t US_Right_cm();
 uint16_t US_Center_cm();
 
+// 타임스탬프 [us]: TIM4 (1MHz) 카운터 + 업데이트 IRQ 횟수로 늘린 32비트, 샘플은 에코 하강 엣지 시각
+//  캡처값은 샷을 건 시각 기준으로 늘리므로 태스크가 늦게 꺼내도 65.5ms 한 바퀴로 헷갈리지 않음 — 프레임 사이 비교 / 속도 / 지연 계산 모두 이 시간축
+//  US_*_cm_age: 같은 필터 출력 + 그 값이 된 샘플의 나이 (age_us NULL 가능)
+//  프레임 타임아웃으로 이전값을 다시 넣어도 나이는 원래 샘플 기준으로 계속 늘어남
+uint16_t US_Left_cm_age(uint32_t *age_us);
+uint16_t US_Right_cm_age(uint32_t *age_us);
+uint16_t US_Center_cm_age(uint32_t *age_us);
+uint32_t US_Now_us(void);
+void     US_GetStamp_us(uint32_t out[3]);   // [L,R,C] 필터 출력 샘플의 타임스탬프
+void     US_TimOverflow(void);              // main.c HAL_TIM_PeriodElapsedCallback (TIM4)
+
+// [L,R,C] 순서 (recorder.c)
+void US_GetEcho_us(uint16_t out[3]);
+void US_GetFiltered_cm(uint16_t out[3]);
+
+// 필터 출력 한 벌 — 세 값이 같은 시점의 것 (automode 판단 / 기록용)
+//  sonic 태스크가 에코 처리 / 프레임 마감 뒤 한 번에 내놓음, 읽는 쪽은 잠금/인터럽트 차단 없이 복사
+enum { US_L = 0, US_R = 1, US_C = 2 };
+typedef struct {
+  uint32_t seq;          // 프레임 번호 (필터 출력을 내놓을 때마다 +1, 0 = 부팅 초기값)
+  uint16_t cm[3];        // [L,R,C] 필터 출력
+  uint16_t echo_us[3];   // [L,R,C] 마지막 원시 에코
+  uint16_t mm[3];        // [L,R,C] 마지막으로 받아들인 원시 거리 [mm] (기온 보정, us_range.h — 무에코면 US_OPEN_CM x 10)
+  uint32_t ts_us[3];     // [L,R,C] 필터 출력 샘플의 타임스탬프 (US_Now_us 와 같은 시간축)
+  int16_t  rate_cms[3];  // [L,R,C] 추적 속도 [cm/s] (+ 멀어짐, - 다가옴, us_track.c)
+  uint8_t  conf[3];      // [L,R,C] 추적 신뢰도 0..100 (새로 시작하면 25, 이상치마다 절반)
+  uint8_t  wobble;       // 추적 혁신이 번갈아 튐 (bit US_L/US_R/US_C) — 벽에 붙어 앞뒤로 흔들림
+} us_frame_t;
+void US_GetFrame(us_frame_t *f);
+
 
 #endif /* INC_ULTRASONIC_H_ */
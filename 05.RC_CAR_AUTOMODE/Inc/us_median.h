@@ -0,0 +1,34 @@
+/*
+ * us_median.h — 초음파 슬라이딩 미디언 (센서마다 창 하나, ultrasonic.c)
+ *
+ *  - 창을 정렬된 채로 유지: 샘플마다 가장 오래된 것 하나 빼고 새것 하나 넣음
+ *    (이진 탐색 두 번 + 두 위치 사이만 한 칸씩 밀기 — 예전처럼 창 전체 복사 + 정렬 안 함)
+ *  - 샘플 = (거리, 타임스탬프) 쌍, 같은 거리는 도착 순서
+ *  - 창 크기는 센서마다 1..US_MED_WIN_MAX (홀수 권장)
+ */
+
+#ifndef INC_US_MEDIAN_H_
+#define INC_US_MEDIAN_H_
+
+#include <stdint.h>
+
+#define US_MED_WIN_MAX  15u
+
+typedef struct {
+  uint16_t cm;
+  uint32_t ts_us;
+} us_med_sample_t;
+
+typedef struct {
+  us_med_sample_t ring[US_MED_WIN_MAX];     // 도착 순서 (ring[wpos] 가 가장 오래된 것)
+  us_med_sample_t sorted[US_MED_WIN_MAX];   // cm 오름차순
+  uint8_t         win;
+  uint8_t         wpos;
+} us_median_t;
+
+// 창을 win 개의 (cm, ts) 로 채움 (win 은 1..US_MED_WIN_MAX 로 자름)
+void     US_MedInit(us_median_t *m, uint8_t win, uint16_t cm, uint32_t ts_us);
+// 샘플 하나 넣고 중앙값 — *ts_out = 중앙값 샘플의 타임스탬프 (같은 거리가 여럿이면 가장 최근)
+uint16_t US_MedPush(us_median_t *m, uint16_t cm, uint32_t ts_us, uint32_t *ts_out);
+
+#endif /* INC_US_MEDIAN_H_ */
@@ -0,0 +1,53 @@
+/*
+ * us_sched.h — 초음파 트리거 슬롯 정책 (ultrasonic.c 가 슬롯마다 "다음에 쏠 센서" 를 물어봄)
+ *
+ *  - 정책 = 고정 순서 표(slots) 또는 상황을 보고 고르는 함수(next)
+ *  - 새 정책은 us_sched.c 에 us_policy_t 하나 + US_POLICY[] 에 등록 (us_sched_t 에 이름 추가)
+ *  - next 는 sonic 태스크에서만 불림 → 정책 내부 상태에 잠금 없음
+ *
+ *  센서 비트: bit0=L, bit1=R, bit2=C (한 슬롯에 여러 비트 = 한 TRIG 펄스로 같이 쏨)
+ *  배열 순서는 [L,R,C] (US_GetEcho_us 와 같음)
+ */
+
+#ifndef INC_US_SCHED_H_
+#define INC_US_SCHED_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define US_SLOT_L  0x01u
+#define US_SLOT_R  0x02u
+#define US_SLOT_C  0x04u
+
+// automode.c 가 주기마다 알려주는 주행 상태 (US_SetDriveHint)
+typedef enum { US_DRV_STRAIGHT = 0, US_DRV_PIVOT, US_DRV_ARC } us_drive_t;
+
+// 정책이 보는 현재 상황 (슬롯을 쏘기 직전 ultrasonic.c 가 채움)
+typedef struct {
+  uint32_t   now_ms;
+  uint16_t   cm[3];       // 필터 출력
+  uint32_t   age_ms[3];   // 마지막으로 쏜 뒤 지난 시간
+  int16_t    vC;          // C 추적 속도 [cm/s] (음수 = 앞벽 접근)
+  us_drive_t drive;
+  int8_t     dir;         // 회전 방향 -1 좌 / +1 우 (drive != STRAIGHT 일 때)
+  uint16_t   ccr_l;       // TIM3 CCR2 (좌)
+  uint16_t   ccr_r;       // TIM3 CCR1 (우)
+} us_view_t;
+
+typedef struct {
+  const char    *name;
+  const uint8_t *slots;      // 고정 순서 (NULL 이면 next) — 자율 트리거(TIM1 순환)는 이 표, 없으면 seq 표
+  uint8_t        n;
+  uint8_t        close_ms;   // 고정 슬롯 모드에서 쏜 센서 에코가 다 오면 이 길이로 마감 (0 = TRIG_GAP_MS 유지)
+  bool           crosstalk;  // 동시 발사 — 기대 에코 창으로 crosstalk/잔향 거름
+  void         (*reset)(void);
+  uint8_t      (*next)(const us_view_t *v);
+} us_policy_t;
+
+typedef enum { US_SCHED_SEQ = 0, US_SCHED_PAIR, US_SCHED_RISK, US_SCHED_NUM } us_sched_t;
+
+extern const us_policy_t *const US_POLICY[US_SCHED_NUM];
+
+int US_PolicyFind(const char *name);   // 없으면 -1
+
+#endif /* INC_US_SCHED_H_ */
@@ -0,0 +1,37 @@
+/*
+ * us_track.h — 초음파 거리/속도 추적 (센서마다 알파-베타 필터 하나, ultrasonic.c)
+ *
+ *  - 받아들인 원시 샘플마다 예측 → 혁신(측정 - 예측) → 보정, dt 는 캡처 타임스탬프 차
+ *  - 혁신이 게이트(기본 + 속도 불확실성 x dt) 밖이면 이상치로 보고 상태를 안 건드림
+ *    연속 US_TRK_MAX_MISS 번이면 진짜 거리 변화(벽이 바뀜)로 보고 새 측정으로 다시 시작
+ *    (속도는 첫 이상치와 마지막 샘플 두 점으로)
+ *  - 신뢰도 0..100: 게이트 안 샘플이면 올라가고 (혁신이 작을수록 더), 이상치면 절반
+ *  - 속도 부호: + 멀어짐, - 다가옴 [cm/s]
+ */
+
+#ifndef INC_US_TRACK_H_
+#define INC_US_TRACK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define US_TRK_MAX_MISS   2u
+
+typedef struct {
+  float    x;          // 거리 [cm]
+  float    v;          // 속도 [cm/s]
+  uint32_t ts_us;      // 마지막 보정 시각
+  float    r_prev;     // 직전 혁신 [cm] (흔들림 판정)
+  float    held_cm;    // 첫 이상치 (연속 이상치로 다시 시작할 때 두 점 속도)
+  uint32_t held_ts;
+  uint8_t  conf;       // 0..100
+  uint8_t  miss;       // 연속 이상치 수
+  bool     init;
+  bool     wobble;     // 직전 두 혁신이 부호가 반대고 둘 다 1cm 이상
+} us_track_t;
+
+void US_TrkReset(us_track_t *t);
+// 샘플 하나 (거리 [cm], 측정 시각 [us]) — 게이트 안이면 true
+bool US_TrkUpdate(us_track_t *t, float cm, uint32_t ts_us);
+
+#endif /* INC_US_TRACK_H_ */
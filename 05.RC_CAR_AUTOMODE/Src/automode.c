@@ -7,307 +7,494 @@
 #include "speed.h"
 #include "move.h"
 #include "main.h"
+#include "param.h"
+#include "recorder.h"
+#include "prof.h"
 #include <stdbool.h>
 #include <stdint.h>
-
-// ====== 튜닝 상수 ======
-enum {
-  // 코너 판단 임계 (히스테리시스)
-  FRONT_PIVOT_CM   = 64,
-  FRONT_ARC_CM     = 79,
-  FRONT_CLEAR_CM   = 75,
-
-  // 회전/커브 유지 시간
-  TURN_MS          = 350,
-  ARC_MIN_MS       = 300,
-  ARC_MAX_MS       = 900,
-
-  // 안정화(기본값)
-  DECIDE_EVERY_MS  = 30,
-  HOLD_DRIVE_MS    = 150,
-  HOLD_TURN_MS     = 130,
-
-  // 너무 가까움 임계 (정지 금지 정책: 즉시 Pivot)
-  FRONT_TOO_CLOSE  = 12
-};
-
-// ====== 상태/보조 ======
-typedef enum { ST_DRIVE, ST_TURN } state_t;
-typedef enum { TURN_PIVOT, TURN_ARC } mode_t;
-typedef enum { TURN_LEFT=-1, TURN_RIGHT=+1 } dir_t;
-
-static state_t  s_state = ST_DRIVE;
-static mode_t   s_mode;
-static dir_t    s_dir;
-static uint32_t s_deadline_ms = 0;
-
-static int8_t   dir_vote = 0;
-static uint32_t s_next_decide_ms = 0;
-static uint32_t s_hold_until_ms  = 0;
-
-static uint32_t s_no_turn_until = 0;
-
-// ΔC 추적
-static int16_t  s_prevC = 0;
-static int16_t  s_dC_buf[3] = {0,0,0};
-static uint8_t  s_dC_idx = 0;
-static uint8_t  s_dC_warm = 0;
-#define DC_FAST_CLOSE_CM   (-3)
-#define DC_FAST_OPEN_CM    (+3)
-static uint8_t s_fast_close_streak = 0;
-static uint8_t s_fast_open_streak  = 0;
-#define DC_CLOSE_STREAK_N  2
-#define DC_OPEN_STREAK_N   2
-
-// 연속커브/방지턱/바이어스 보조
-static uint32_t s_last_turn_end   = 0;
-static uint32_t s_arc_chain_until = 0;
-static bool     s_in_bump         = false;
-static uint32_t s_bump_until      = 0;
-static uint32_t s_speedup_cool_until = 0;
-
-static uint32_t s_last_arc_bias_ms   = 0;
-static uint8_t  s_arc_phase          = 0;
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ====== 튜닝 파라미터 ======
+// FRONT_*_CM, TURN_MS, ARC_*_MS, DECIDE_EVERY_MS, HOLD_*_MS, VC_*, DC_*, BUMP_*, CHAIN_MS, GOV_* 는
+// param.c 런타임 테이블
+// (UART 로 변경, 플래시 저장) — PARAM(이름) 으로 읽음
+
+// ====== 상태 ======
+// 판단 상태는 AutoState_t (automode.h) — 여기엔 보드용 기본 인스턴스만
+static AutoState_t s_auto;
+static us_frame_t  s_us;               // 이번 주기 판단에 쓴 초음파 프레임 (기록도 같은 것)
+
+// C 접근 속도 (ultrasonic.c 추적기 → 프레임 rate_cms/conf/wobble)
+#define VC_CONF_MIN      40u     // 이 신뢰도 미만이면 속도 판단 안 함 (새로 시작 직후 / 이상치 연속)
+#define VC_WOBBLE_CMS    75      // 방지턱: 혁신이 번갈아 튀는데 평균 속도는 이 안쪽
+#define VC_SETTLED_CMS   37      // 방지턱 해제: 속도가 이 안쪽으로 가라앉음
+#define VC_CENTER_OPEN  150      // ARC 출구: C 가 이 이상으로 멀어짐
+
+// TTC 거버너 (GOV_MODE 1)
+#define TTC_CLOSE_CMS     15     // 이보다 느린 접근은 무시 (필터 1cm 계단 / 차체 흔들림)
+#define TTC_NONE      0xFFFFu
+#define GOV_DOWN_COOL_MS  40u    // STEP_DOWN 연속 간격 (한 번에 바닥까지 안 떨어지게)
 
 // ====== 유틸 ======
 static inline bool     valid_cm(uint16_t x){ return (x >= 2 && x <= 300); }
+static inline bool     open_cm(uint16_t x){ return (x == US_OPEN_CM); }   // 무에코 = 4m 안에 없음 → 트임
 static inline uint16_t clamp16(uint16_t v, uint16_t lo, uint16_t hi){ return (v<lo)?lo:(v>hi)?hi:v; }
 static inline int16_t  i16_abs(int16_t v){ return (v>=0)?v:(int16_t)(-v); }
 
-// ====== 시작 ======
-void AutoMode_Start(void)
+// ====== 한 주기 문맥 (가드/동작이 공유, 상태 아님) ======
+typedef struct {
+  AutoState_t *st;
+  AutoOutput_t o;
+  uint32_t     now;
+  uint16_t     L, C, R;
+  uint16_t     pwm;
+  int16_t      vC, vL, vR;
+  bool         vC_ready, vL_ready, vR_ready;
+  bool         in_chain;
+  uint32_t     decide_ms, hold_drv;
+  bool         can_decide;
+  // DRIVE 본문이 계산 → 가드 / ARC 진입이 씀
+  auto_dir_t   dir;
+  bool         sharpU, softL, can_switch, allow_pivot;
+  uint16_t     pivot_th, arc_th;
+} auto_ctx_t;
+
+#define CTX(p)  ((auto_ctx_t *)(p))
+
+// ====== 공통 ======
+static inline void vote(AutoState_t *st, uint16_t L, uint16_t R)
 {
-  const uint32_t now = HAL_GetTick();
-  s_no_turn_until = now + 1500;  // 1.5s
-  dir_vote = 0;
-  s_state = ST_DRIVE;
-
-  s_prevC = US_Center_cm();
-  s_dC_buf[0] = s_dC_buf[1] = s_dC_buf[2] = 0;
-  s_dC_idx = 0; s_dC_warm = 0;
-  s_fast_close_streak = 0; s_fast_open_streak = 0;
-
-  s_last_turn_end   = now;
-  s_arc_chain_until = now;
-  s_in_bump = false; s_bump_until = now;
-  s_speedup_cool_until = now;
-  s_last_arc_bias_ms = 0;
-  s_arc_phase = 0;
+  int d = (R > L) ? +1 : -1;
+  st->dir_vote += d; if (st->dir_vote>+2) st->dir_vote=+2; if (st->dir_vote<-2) st->dir_vote=-2;
 }
 
-// ====== 메인 ======
-void AutoMode_Update(void)
+static inline AutoAction_t pivot_of(auto_dir_t dir)
 {
-  const uint32_t now = HAL_GetTick();
+  return (dir == AUTO_DIR_RIGHT) ? AUTO_ACT_PIVOT_RIGHT : AUTO_ACT_PIVOT_LEFT;
+}
+
+// 의사결정 주기 (STARTUP / 비상 Pivot 주기에는 안 돎)
+static inline void decide_tick(auto_ctx_t *c)
+{
+  c->can_decide = ((int32_t)(c->now - c->st->next_decide_ms) >= 0);
+  if (c->can_decide) c->st->next_decide_ms = c->now + c->decide_ms;
+}
+
+static inline uint32_t ttc_of(uint16_t cm, int16_t rate)   // [ms], 다가오지 않으면 TTC_NONE
+{
+  if (!valid_cm(cm) || rate > -TTC_CLOSE_CMS) return TTC_NONE;
+  const uint32_t t = (uint32_t)cm * 1000u / (uint32_t)(-rate);
+  return (t < TTC_NONE) ? t : TTC_NONE;
+}
 
-  // 센서
-  const uint16_t L = US_Left_cm();
-  const uint16_t C = US_Center_cm();
-  const uint16_t R = US_Right_cm();
+// ====== STARTUP: 회전 금지 ======
+static void startup_run(void *p) { CTX(p)->o = (AutoOutput_t){ AUTO_ACT_FORWARD, AUTO_SPD_SLOW }; }
+static void startup_done(void *p) { CTX(p)->o = (AutoOutput_t){ AUTO_ACT_KEEP, AUTO_SPD_KEEP }; }   // 이 주기는 DRIVE 가 처음부터
 
-  // ΔC 업데이트
-  int16_t dC_now = (int16_t)C - (int16_t)s_prevC;
-  s_prevC = C;
-  s_dC_buf[s_dC_idx] = dC_now;
-  s_dC_idx = (uint8_t)((s_dC_idx + 1) % 3);
-  if (s_dC_warm < 3) s_dC_warm++;
+// ====== 전역: 비상 Pivot / 방지턱 ======
+static bool g_too_close(void *p) { return CTX(p)->C <= PARAM(FRONT_TOO_CLOSE); }
+static void g_too_close_act(void *p) { vote(CTX(p)->st, CTX(p)->L, CTX(p)->R); }
 
-  int16_t dC_avg = (int16_t)((int32_t)s_dC_buf[0] + s_dC_buf[1] + s_dC_buf[2]) / 3;
-  const bool dC_ready = (s_dC_warm >= 3);
+static bool g_bump(void *p)
+{
+  const auto_ctx_t *c = CTX(p);
+  const AutoState_t *st = c->st;
+  if (Fsm_State(&st->fsm) == AUTO_FSM_BUMP) return false;
+  if ((int32_t)(c->now - st->last_turn_end) > PARAM(BUMP_WINDOW_MS) || !c->vC_ready) return false;
+  const bool vc_wobble = st->vC_wobble && (i16_abs(c->vC) <= VC_WOBBLE_CMS);
+  return vc_wobble && c->C >= 45 && c->C <= 85;
+}
+static void g_bump_act(void *p)
+{
+  auto_ctx_t *c = CTX(p);
+  c->st->bump_until = c->now + (c->in_chain ? PARAM(BUMP_HOLD_MS) * 3u / 4u : (uint32_t)PARAM(BUMP_HOLD_MS));   // 체인 중엔 3/4
+}
 
-  if (dC_ready && dC_avg <= DC_FAST_CLOSE_CM) s_fast_close_streak++; else s_fast_close_streak = 0;
-  if (dC_ready && dC_avg >= DC_FAST_OPEN_CM)  s_fast_open_streak++;  else s_fast_open_streak  = 0;
+// ====== 속도 거버너 (DRIVE 본문) ======
+static inline uint32_t speedup_cool(const AutoState_t *st)
+{
+  return (st->fast_open_streak >= PARAM(DC_OPEN_STREAK_N)) ? 140u : 100u;
+}
 
-  // STARTUP 금지
-  if ((int32_t)(now - s_no_turn_until) < 0) {
-    drive_forward(); auto_motor_slow(); return;
+static inline uint16_t nearest_cm(const auto_ctx_t *c)
+{
+  const uint16_t near = (c->L < c->R) ? c->L : c->R;
+  return (near < c->C) ? near : c->C;
+}
+
+// GOV_MODE 0: 가장 가까운 벽 거리 컷오프 (GOV_SLOW_CM 미만 = 최저속, GOV_FAST_CM 이상 = 가속)
+static void gov_dist(auto_ctx_t *c)
+{
+  AutoState_t *st = c->st;
+  const uint16_t min_all = nearest_cm(c);
+
+  if      (min_all < PARAM(GOV_SLOW_CM)) {        // 코너 초입 과속 억제
+    c->o.speed = AUTO_SPD_SLOW;
+  } else {
+    if ((int32_t)(c->now - st->speedup_cool_until) >= 0) {
+      if (min_all >= PARAM(GOV_FAST_CM)) {
+        c->o.speed = AUTO_SPD_UP;
+        st->speedup_cool_until = c->now + speedup_cool(st);
+      }
+    }
   }
+}
 
-  // 비상 Pivot
-  if (C <= FRONT_TOO_CLOSE) {
-    int d = (R > L) ? +1 : -1;
-    dir_vote += d; if (dir_vote>+2) dir_vote=+2; if (dir_vote<-2) dir_vote=-2;
-    s_dir = (dir_vote >= 0) ? TURN_RIGHT : TURN_LEFT;
+// GOV_MODE 1: 충돌까지 시간 TTC = 거리 / 접근 속도 (L/R/C 추적 속도, 신뢰도 통과한 것 중 최소)
+//  접근 속도 ∝ PWM 으로 보고 TTC 가 GOV_TTC_MS 가 되는 PWM 까지 — 넘으면 STEP_DOWN (SPEED_MIN 까지), 여유 있으면 STEP_UP
+//  최저속(SLOW)은 모드 0 과 같은 거리 하한만 — TTC 로 SLOW 를 내면 허용 PWM 이 속도에 비례해서
+//  좁은 통로에서 SLOW 에 갇힘 (느려질수록 접근 속도도 줄어 TTC 가 안 늘어남)
+static void gov_ttc(auto_ctx_t *c)
+{
+  AutoState_t *st = c->st;
+  uint32_t ttc = c->vC_ready ? ttc_of(c->C, c->vC) : TTC_NONE;
+  const uint32_t tl = c->vL_ready ? ttc_of(c->L, c->vL) : TTC_NONE;
+  const uint32_t tr = c->vR_ready ? ttc_of(c->R, c->vR) : TTC_NONE;
+  if (tl < ttc) ttc = tl;
+  if (tr < ttc) ttc = tr;
+  st->ttc_ms = (uint16_t)ttc;
+
+  const uint32_t pwm = (c->pwm != 0u) ? c->pwm : 1u;
+  const uint32_t allowed = (ttc == TTC_NONE) ? (uint32_t)PARAM(SPEED_MAX) : pwm * ttc / (uint32_t)PARAM(GOV_TTC_MS);
+
+  if (nearest_cm(c) < PARAM(GOV_SLOW_CM)) {
+    c->o.speed = AUTO_SPD_SLOW;
+  } else if (allowed < pwm && pwm > (uint32_t)PARAM(SPEED_MIN)) {
+    if ((int32_t)(c->now - st->speeddown_cool_until) >= 0) {
+      c->o.speed = AUTO_SPD_DOWN;
+      st->speeddown_cool_until = c->now + GOV_DOWN_COOL_MS;
+    }
+  } else if (allowed >= pwm + PARAM(STEP_UP) && (int32_t)(c->now - st->speedup_cool_until) >= 0) {
+    c->o.speed = AUTO_SPD_UP;
+    st->speedup_cool_until = c->now + speedup_cool(st);
+  }
+}
 
-    s_state = ST_TURN; s_mode = TURN_PIVOT;
-    s_deadline_ms   = now + TURN_MS;
-    s_hold_until_ms = now + HOLD_TURN_MS;
+// ====== DRIVE ======
+static void drive_entry(void *p) { CTX(p)->st->state = AUTO_ST_DRIVE; }
 
-    s_in_bump = false;
-    auto_motor_slow();
-    if (s_dir == TURN_RIGHT) pivot_right(); else pivot_left();
-    return;
+static void drive_run(void *p)
+{
+  auto_ctx_t *c = CTX(p);
+  AutoState_t *st = c->st;
+  const uint16_t L = c->L, C = c->C, R = c->R;
+  decide_tick(c);
+
+  // 속도 거버너
+  c->o.action = AUTO_ACT_FORWARD;
+  if (PARAM(GOV_MODE) == 1) gov_ttc(c);
+  else                      gov_dist(c);
+
+  // 방향 스트릭
+  if (c->can_decide) vote(st, L, R);
+  c->dir = (st->dir_vote >= 0) ? AUTO_DIR_RIGHT : AUTO_DIR_LEFT;
+
+  // 타입 분기용 좌우 차
+  int16_t lr_diff = (int16_t)L - (int16_t)R;
+  int16_t lr_abs  = (lr_diff >= 0) ? lr_diff : (int16_t)(-lr_diff);
+  c->sharpU = (st->fast_close_streak >= 2) && (lr_abs <= 10);
+  c->softL  = (lr_abs >= 20) && (st->fast_close_streak == 0);
+
+  c->can_switch = c->can_decide && ((int32_t)(c->now - st->hold_until_ms) >= 0);
+  if (!c->can_switch) return;
+
+  uint16_t PIVOT_TH = PARAM(FRONT_PIVOT_CM);
+  uint16_t ARC_TH   = PARAM(FRONT_ARC_CM);
+
+  // C 접근 속도 기반 임계 보정 먼저
+  if (c->vC_ready) {
+    if (st->fast_close_streak >= PARAM(DC_CLOSE_STREAK_N)) { PIVOT_TH += 4; ARC_TH += 3; }
+    else if (st->fast_open_streak >= PARAM(DC_OPEN_STREAK_N)) {
+      ARC_TH = (ARC_TH > 3) ? (uint16_t)(ARC_TH - 3) : ARC_TH;
+    }
   }
 
-  // 연속커브 윈도우
-  const bool in_chain = ((int32_t)(now - s_arc_chain_until) < 0);
-
-  // 결정주기(체인 가속), DRV 홀드
-  const uint32_t decide_ms = in_chain ? 16u : (uint32_t)DECIDE_EVERY_MS;
-  const uint32_t hold_drv  = in_chain ? 70u : (uint32_t)HOLD_DRIVE_MS;
-
-  // 의사결정 주기
-  const bool can_decide = ((int32_t)(now - s_next_decide_ms) >= 0);
-  if (can_decide) s_next_decide_ms = now + decide_ms;
-
-  // 방지턱 감지
-  if (!s_in_bump && (int32_t)(now - s_last_turn_end) <= 350 && dC_ready) {
-    bool dc_wobble =
-      (i16_abs(dC_avg) <= 2) &&
-      ( (s_dC_buf[(s_dC_idx+2)%3] > 0 && s_dC_buf[(s_dC_idx+1)%3] < 0) ||
-        (s_dC_buf[(s_dC_idx+2)%3] < 0 && s_dC_buf[(s_dC_idx+1)%3] > 0) );
-    if (dc_wobble && C >= 45 && C <= 85) {
-      s_in_bump = true;
-      s_bump_until = now + (in_chain ? 180u : 240u);
+  // 체인에서 Pivot 완화
+  if (c->in_chain && PIVOT_TH >= 2) PIVOT_TH = (uint16_t)(PIVOT_TH - 2);
+
+  c->pivot_th = clamp16(PIVOT_TH, 40, 90);
+  c->arc_th   = clamp16(ARC_TH,   55, 95);
+
+  // softL이라도 아주 가까우면 Pivot 허용(예외)
+  c->allow_pivot = !c->softL || C <= (uint16_t)(c->pivot_th - 4);
+}
+
+static bool drive_to_pivot(void *p) { const auto_ctx_t *c = CTX(p); return c->can_switch && c->C <= c->pivot_th && c->allow_pivot; }
+static bool drive_to_arc(void *p)   { const auto_ctx_t *c = CTX(p); return c->can_switch && c->C <= c->arc_th; }
+
+// 회전 끝 → 직진 복귀 (Pivot 시간 만료 / ARC 출구)
+static void end_turn(void *p)
+{
+  auto_ctx_t *c = CTX(p);
+  AutoState_t *st = c->st;
+  st->hold_until_ms = c->now + c->hold_drv;
+  c->o.action = AUTO_ACT_FORWARD; c->o.speed = AUTO_SPD_SLOW;
+
+  st->last_turn_end   = c->now;
+  st->arc_chain_until = c->now + PARAM(CHAIN_MS);
+
+  st->arc_phase = 0;
+}
+
+// ====== PIVOT (시간 = TURN_MS, 표의 타임아웃) ======
+static void pivot_entry(void *p)
+{
+  auto_ctx_t *c = CTX(p);
+  AutoState_t *st = c->st;
+  st->dir = (st->dir_vote >= 0) ? AUTO_DIR_RIGHT : AUTO_DIR_LEFT;
+  st->state = AUTO_ST_TURN; st->mode = AUTO_TURN_PIVOT;
+  st->hold_until_ms = c->now + PARAM(HOLD_TURN_MS);
+  c->o.speed = AUTO_SPD_SLOW; c->o.action = pivot_of(st->dir);
+}
+
+static void pivot_run(void *p) { decide_tick(CTX(p)); }
+
+// ====== ARC ======
+static void arc_entry(void *p)
+{
+  auto_ctx_t *c = CTX(p);
+  AutoState_t *st = c->st;
+  st->state = AUTO_ST_TURN; st->mode = AUTO_TURN_ARC; st->dir = c->dir;
+  uint32_t arc_min = PARAM(ARC_MIN_MS);
+  if (c->sharpU) arc_min = 240;       // U자면 약간 짧게
+  st->deadline_ms   = c->now + arc_min;
+  st->hold_until_ms = c->now + PARAM(HOLD_TURN_MS);
+
+  st->arc_phase  = c->softL ? 1 : 0;  // 완만 ㄱ자는 약하게 시작
+  st->last_arc_bias_ms = 0;
+
+  c->o.speed = AUTO_SPD_SLOW; c->o.action = AUTO_ACT_FORWARD;
+}
+
+// 바이어스 램프다운(프레임당 1회, 단계적 약화) — 이 주기에 출구면 end_turn 이 출력을 덮음
+static void arc_run(void *p)
+{
+  auto_ctx_t *c = CTX(p);
+  AutoState_t *st = c->st;
+  decide_tick(c);
+  c->o.action = AUTO_ACT_FORWARD;
+  if ((int32_t)(c->now - st->last_arc_bias_ms) >= 0) {
+    if (st->arc_phase <= 2) {
+      c->o.speed = (st->dir == AUTO_DIR_RIGHT) ? AUTO_SPD_RIGHT_DOWN : AUTO_SPD_LEFT_DOWN;
     }
+    st->last_arc_bias_ms = c->now + PARAM(DECIDE_EVERY_MS);
+    if (st->arc_phase < 3) st->arc_phase++;
   }
+}
 
-  if (s_in_bump) {
-    drive_forward();
-    auto_motor_speedUp();
-    if ((int32_t)(now - s_speedup_cool_until) >= 0) s_speedup_cool_until = now + 120;
-    if ( (int32_t)(now - s_bump_until) >= 0 || (dC_ready && i16_abs(dC_avg) <= 1) ) s_in_bump = false;
-    return;
+// 출구 조기복귀(보수화) / 최소 유지 뒤 C 트임 / 최대 시간
+static bool arc_exit(void *p)
+{
+  const auto_ctx_t *c = CTX(p);
+  const AutoState_t *st = c->st;
+  const bool arc_min_elapsed = ((int32_t)(c->now - st->deadline_ms) >= 0);
+  const bool arc_too_long    = ((int32_t)(c->now - st->deadline_ms) >= (int32_t)(PARAM(ARC_MAX_MS) - PARAM(ARC_MIN_MS)));
+
+  bool center_open = open_cm(c->C) || (c->vC_ready && (c->vC >= VC_CENTER_OPEN) && (st->fast_open_streak >= 3));
+  uint16_t side_far = (st->dir == AUTO_DIR_RIGHT) ? c->L : c->R;   // 바깥쪽
+  bool outer_open = open_cm(side_far) || (valid_cm(side_far) && (side_far >= 82));
+
+  uint16_t CLEAR_TH = PARAM(FRONT_CLEAR_CM) + 2;   // 기본 +2
+  if (st->fast_open_streak >= PARAM(DC_OPEN_STREAK_N) && CLEAR_TH > 2) {
+    CLEAR_TH = (uint16_t)(CLEAR_TH - 2);    // 급개방 지속 시 원래 수준으로
   }
+  CLEAR_TH = clamp16(CLEAR_TH, 50, 90);
 
-  switch (s_state)
-  {
-    case ST_DRIVE:
-    {
-      // 속도 거버너
-      drive_forward();
-      uint16_t near = (L < R) ? L : R;
-      uint16_t min_all = (near < C) ? near : C;
-
-      const bool fast_open_now = (dC_ready && dC_avg >= DC_FAST_OPEN_CM && s_fast_open_streak >= DC_OPEN_STREAK_N);
-
-      if      (min_all < 62) {        // 코너 초입 과속 억제
-        auto_motor_slow();
-      } else {
-        if ((int32_t)(now - s_speedup_cool_until) >= 0) {
-          if (min_all >= 68) {
-            auto_motor_speedUp();
-            s_speedup_cool_until = now + (fast_open_now ? 140 : 100);
-          }
-        }
-      }
+  return (arc_min_elapsed && center_open && outer_open) ||
+         (c->C >= CLEAR_TH && arc_min_elapsed) ||
+         arc_too_long;
+}
 
-      // 방향 스트릭
-      if (can_decide) {
-        int d = (R > L) ? +1 : -1;
-        dir_vote += d; if (dir_vote>+2) dir_vote=+2; if (dir_vote<-2) dir_vote=-2;
-      }
-      dir_t dir = (dir_vote >= 0) ? TURN_RIGHT : TURN_LEFT;
-
-      // 타입 분기용 좌우 차
-      int16_t lr_diff = (int16_t)L - (int16_t)R;
-      int16_t lr_abs  = (lr_diff >= 0) ? lr_diff : (int16_t)(-lr_diff);
-      bool sharpU = dC_ready && (dC_avg <= DC_FAST_CLOSE_CM) && (s_fast_close_streak >= 2) && (lr_abs <= 10);
-      bool softL  = (lr_abs >= 20) && !(dC_ready && dC_avg <= DC_FAST_CLOSE_CM);
-
-      const bool can_switch = can_decide && ((int32_t)(now - s_hold_until_ms) >= 0);
-
-      if (can_switch) {
-        uint16_t PIVOT_TH = FRONT_PIVOT_CM;
-        uint16_t ARC_TH   = FRONT_ARC_CM;
-
-        // ΔC 기반 임계 보정 먼저
-        if (dC_ready) {
-          if (s_fast_close_streak >= DC_CLOSE_STREAK_N) { PIVOT_TH += 4; ARC_TH += 3; }
-          else if (s_fast_open_streak >= DC_OPEN_STREAK_N) {
-            ARC_TH = (ARC_TH > 3) ? (uint16_t)(ARC_TH - 3) : ARC_TH;
-          }
-        }
-
-        // 체인에서 Pivot 완화
-        if (in_chain && PIVOT_TH >= 2) PIVOT_TH = (uint16_t)(PIVOT_TH - 2);
-
-        PIVOT_TH = clamp16(PIVOT_TH, 40, 90);
-        ARC_TH   = clamp16(ARC_TH,   55, 95);
-
-        // softL이라도 아주 가까우면 Pivot 허용(예외)
-        bool allow_pivot = !softL;
-        if (!allow_pivot && C <= (uint16_t)(PIVOT_TH - 4)) allow_pivot = true;
-
-        if (C <= PIVOT_TH && allow_pivot) {
-          s_state = ST_TURN; s_mode = TURN_PIVOT; s_dir = dir;
-          s_deadline_ms   = now + TURN_MS;
-          s_hold_until_ms = now + HOLD_TURN_MS;
-          auto_motor_slow();
-          if (s_dir == TURN_RIGHT) pivot_right(); else pivot_left();
-          break;
-        } else if (C <= ARC_TH) {
-          s_state = ST_TURN; s_mode = TURN_ARC; s_dir = dir;
-          uint32_t arc_min = ARC_MIN_MS;
-          if (sharpU) arc_min = 240;       // U자면 약간 짧게
-          s_deadline_ms   = now + arc_min;
-          s_hold_until_ms = now + HOLD_TURN_MS;
-
-          s_arc_phase  = softL ? 1 : 0;    // 완만 ㄱ자는 약하게 시작
-          s_last_arc_bias_ms = 0;
-
-          auto_motor_slow();
-          drive_forward();
-          break;
-        }
-      }
-    } break;
-
-    case ST_TURN:
-    {
-      if (s_mode == TURN_PIVOT) {
-        if ((int32_t)(s_deadline_ms - now) <= 0) {
-          s_state = ST_DRIVE;
-          s_hold_until_ms = now + hold_drv;
-          drive_forward(); auto_motor_slow();
-
-          s_last_turn_end   = now;
-          s_arc_chain_until = now + 350;
-
-          s_arc_phase = 0;
-          break;
-        }
-      }
-      else { // TURN_ARC
-        const bool arc_min_elapsed = ((int32_t)(now - s_deadline_ms) >= 0);
-        const bool arc_too_long    = ((int32_t)(now - s_deadline_ms) >= (int32_t)(ARC_MAX_MS - ARC_MIN_MS));
-
-        // 출구 조기복귀(보수화)
-        bool center_open = dC_ready && (dC_avg >= +4) && (s_fast_open_streak >= 3);
-        uint16_t side_far = (s_dir == TURN_RIGHT) ? L : R;   // 바깥쪽
-        bool outer_open = valid_cm(side_far) && (side_far >= 82);
-
-        uint16_t CLEAR_TH = FRONT_CLEAR_CM + 2;   // 기본 +2
-        if (dC_ready && s_fast_open_streak >= DC_OPEN_STREAK_N && CLEAR_TH > 2) {
-          CLEAR_TH = (uint16_t)(CLEAR_TH - 2);    // 급개방 지속 시 원래 수준으로
-        }
-        CLEAR_TH = clamp16(CLEAR_TH, 50, 90);
-
-        if ( (arc_min_elapsed && center_open && outer_open) ||
-             (C >= CLEAR_TH && arc_min_elapsed) ||
-             arc_too_long) {
-          s_state = ST_DRIVE;
-          s_hold_until_ms = now + hold_drv;
-          drive_forward(); auto_motor_slow();
-
-          s_last_turn_end   = now;
-          s_arc_chain_until = now + 350;
-
-          s_arc_phase = 0;
-          break;
-        }
-
-        // 바이어스 램프다운(프레임당 1회, 단계적 약화)
-        drive_forward();
-        if ((int32_t)(now - s_last_arc_bias_ms) >= 0) {
-          if (s_arc_phase <= 2) {
-            if (s_dir == TURN_RIGHT) { auto_motor_right_speedDown(); }
-            else                      { auto_motor_left_speedDown();  }
-          }
-          s_last_arc_bias_ms = now + DECIDE_EVERY_MS;
-          if (s_arc_phase < 3) s_arc_phase++;
-        }
-      }
-    } break;
+// ====== BUMP: 방지턱 통과 (끼어드는 상태 — 끝나면 그 전 상태로, PIVOT 시간은 계속 흐름) ======
+static void bump_run(void *p)
+{
+  auto_ctx_t *c = CTX(p);
+  decide_tick(c);
+  c->o.action = AUTO_ACT_FORWARD;
+  c->o.speed  = AUTO_SPD_UP;
+  if ((int32_t)(c->now - c->st->speedup_cool_until) >= 0) c->st->speedup_cool_until = c->now + 120;
+}
+
+static bool bump_done(void *p)
+{
+  const auto_ctx_t *c = CTX(p);
+  return (int32_t)(c->now - c->st->bump_until) >= 0 || (c->vC_ready && i16_abs(c->vC) <= VC_SETTLED_CMS);
+}
+
+// ====== 전이 표 (상태 추가 = 본문/가드 함수 + 여기 한 줄 + automode.h 번호) ======
+static const FsmEdge_t GLOBAL_EDGES[] = {
+  { "too_close", g_too_close, g_too_close_act, AUTO_FSM_PIVOT, 0 },          // 비상 Pivot (PIVOT 중이면 다시 시작)
+  { "bump",      g_bump,      g_bump_act,      AUTO_FSM_BUMP,  FSM_E_GO },   // 같은 주기에 BUMP 본문
+};
+static const FsmEdge_t DRIVE_EDGES[] = {
+  { "pivot", drive_to_pivot, NULL, AUTO_FSM_PIVOT, 0 },
+  { "arc",   drive_to_arc,   NULL, AUTO_FSM_ARC,   0 },
+};
+static const FsmEdge_t ARC_EDGES[] = {
+  { "clear", arc_exit, end_turn, AUTO_FSM_DRIVE, 0 },
+};
+static const FsmEdge_t BUMP_EDGES[] = {
+  { "settled", bump_done, NULL, FSM_BACK, 0 },
+};
+
+#define EDGES(t)  (t), (uint8_t)(sizeof (t) / sizeof (t)[0])
+
+static const FsmState_t AUTO_STATES[AUTO_FSM_NUM] = {
+  //                 이름       진입         본문          타임아웃                          플래그            타임아웃 전이
+  [AUTO_FSM_STARTUP] = { "STARTUP", NULL,        startup_run, 1500, NULL,               FSM_S_NO_GLOBAL,
+                         { "go", NULL, startup_done, AUTO_FSM_DRIVE, FSM_E_GO }, NULL, 0 },
+  [AUTO_FSM_DRIVE]   = { "DRIVE",   drive_entry, drive_run,   0,    NULL,               0,
+                         { 0 }, EDGES(DRIVE_EDGES) },
+  [AUTO_FSM_PIVOT]   = { "PIVOT",   pivot_entry, pivot_run,   0,    &PARAM(TURN_MS),    0,
+                         { "turned", NULL, end_turn, AUTO_FSM_DRIVE, 0 }, NULL, 0 },
+  [AUTO_FSM_ARC]     = { "ARC",     arc_entry,   arc_run,     0,    NULL,               0,
+                         { 0 }, EDGES(ARC_EDGES) },
+  [AUTO_FSM_BUMP]    = { "BUMP",    NULL,        bump_run,    0,    NULL,               0,
+                         { 0 }, EDGES(BUMP_EDGES) },
+};
+_Static_assert(AUTO_FSM_NUM <= FSM_STATE_MAX, "AUTO_STATES 가 FSM_STATE_MAX 보다 큼");
+
+static const FsmDef_t AUTO_FSM = {
+  "automode", AUTO_STATES, AUTO_FSM_NUM, EDGES(GLOBAL_EDGES)
+};
+
+// ====== 시작 ======
+void AutoMode_Init(AutoState_t *st, uint32_t now)
+{
+  *st = (AutoState_t){0};
+  Fsm_Init(&st->fsm, &AUTO_FSM, AUTO_FSM_STARTUP, now);   // 1.5s 회전 금지
+  st->dir_vote = 0;
+  st->state = AUTO_ST_DRIVE;
+
+  st->last_turn_end   = now;
+  st->arc_chain_until = now;
+  st->bump_until = now;
+  st->speedup_cool_until = now;
+  st->last_arc_bias_ms = 0;
+  st->arc_phase = 0;
+  st->ttc_ms = TTC_NONE;
+  st->speeddown_cool_until = now;
+}
+
+void AutoMode_Start(void)
+{
+  AutoMode_Init(&s_auto, HAL_GetTick());
+}
+
+const Fsm_t *AutoMode_Fsm(void) { return &s_auto.fsm; }
+
+// ====== 판단 (센서/시계/모터 없이 입력 → 출력) ======
+AutoOutput_t AutoMode_Step(AutoState_t *st, const AutoInput_t *in)
+{
+  auto_ctx_t c = { .st = st, .o = { AUTO_ACT_KEEP, AUTO_SPD_KEEP }, .now = in->now_ms };
+
+  // 센서 — 세 값을 한 프레임에서 (sonic 태스크가 중간에 갱신해도 R>L 투표가 프레임을 섞지 않게)
+  c.L = in->us.cm[US_L];
+  c.C = in->us.cm[US_C];
+  c.R = in->us.cm[US_R];
+  c.pwm = in->pwm;
+
+  // C 접근 속도 [cm/s] (음수 = 다가옴)
+  c.vC = in->us.rate_cms[US_C];
+  c.vC_ready = (in->us.conf[US_C] >= VC_CONF_MIN);
+  st->vC = c.vC;
+  st->vC_ready  = c.vC_ready;
+  st->vC_wobble = c.vC_ready && (in->us.wobble & (1u << US_C));
+
+  // L/R 접근 속도 — TTC 거버너만 씀
+  c.vL = in->us.rate_cms[US_L];
+  c.vR = in->us.rate_cms[US_R];
+  c.vL_ready = (in->us.conf[US_L] >= VC_CONF_MIN);
+  c.vR_ready = (in->us.conf[US_R] >= VC_CONF_MIN);
+  st->vL_ready = c.vL_ready;
+  st->vR_ready = c.vR_ready;
+
+  if (c.vC_ready && c.vC <= PARAM(VC_FAST_CLOSE_CMS)) { if (st->fast_close_streak < 255u) st->fast_close_streak++; } else st->fast_close_streak = 0;
+  if (c.vC_ready && c.vC >= PARAM(VC_FAST_OPEN_CMS))  { if (st->fast_open_streak  < 255u) st->fast_open_streak++;  } else st->fast_open_streak  = 0;
+
+  // 연속커브 윈도우 — 결정주기(체인 가속), DRV 홀드
+  c.in_chain  = ((int32_t)(c.now - st->arc_chain_until) < 0);
+  c.decide_ms = c.in_chain ? 16u : (uint32_t)PARAM(DECIDE_EVERY_MS);
+  c.hold_drv  = c.in_chain ? 70u : (uint32_t)PARAM(HOLD_DRIVE_MS);
+
+  Fsm_Step(&st->fsm, &c, c.now);
+  return c.o;
+}
+
+// ====== 출력 → 모터 (speed.c 슬루 / move.c 방향핀) ======
+void AutoMode_Act(AutoOutput_t out)
+{
+  switch (out.speed) {
+    case AUTO_SPD_SLOW:       auto_motor_slow();            break;
+    case AUTO_SPD_UP:         auto_motor_speedUp();         break;
+    case AUTO_SPD_LEFT_DOWN:  auto_motor_left_speedDown();  break;
+    case AUTO_SPD_RIGHT_DOWN: auto_motor_right_speedDown(); break;
+    case AUTO_SPD_DOWN:       auto_motor_speedDown();       break;
+    default: break;
   }
+  switch (out.action) {
+    case AUTO_ACT_FORWARD:     drive_forward(); break;
+    case AUTO_ACT_PIVOT_LEFT:  pivot_left();    break;
+    case AUTO_ACT_PIVOT_RIGHT: pivot_right();   break;
+    default: break;
+  }
+}
+
+// 콘솔 stop/go — debug 태스크가 요청, automode 태스크가 주기 경계에서 반영
+static volatile bool s_hold_req = false;
+static volatile bool s_held     = false;
+
+void AutoMode_Hold(bool hold) { s_hold_req = hold; }
+bool AutoMode_Idle(void)      { return s_hold_req && s_held; }
+
+// 한 주기: 파라미터 반영 → 센서/시계 읽기 → 판단 → 모터 → 기록
+// (판단의 중간 return 과 무관하게 주기당 1레코드)
+void AutoMode_Update(void)
+{
+  const uint32_t t0 = Prof_Begin();
+  Param_Sync();   // UART/플래시에서 바뀐 파라미터는 주기 경계에서만 반영
+
+  if (s_hold_req) {   // 정지 유지: 판단/기록 없이 모터만 세움
+    motor_stop();
+    s_held = true;
+    Prof_End(PROF_AUTO_UPDATE, t0);
+    return;
+  }
+  if (s_held) {       // 재출발은 STARTUP 부터 (멈춘 동안의 타이머/투표는 버림)
+    s_held = false;
+    AutoMode_Start();
+  }
+
+  AutoInput_t in;
+  in.now_ms = HAL_GetTick();
+  US_GetFrame(&in.us);
+  uint16_t pr, pl;
+  get_speed(&pr, &pl);
+  in.pwm = (uint16_t)((pr + pl) / 2u);
+  s_us = in.us;
+  AutoMode_Act(AutoMode_Step(&s_auto, &in));
+
+  const AutoState_t *st = &s_auto;
+  uint8_t flags = 0;
+  if (Fsm_State(&st->fsm) == AUTO_FSM_BUMP)    flags |= REC_F_BUMP;
+  if (Fsm_State(&st->fsm) == AUTO_FSM_STARTUP) flags |= REC_F_STARTUP;
+  if (st->vC_ready)  flags |= REC_F_VC_READY;
+  if (st->vC_wobble) flags |= REC_F_WOBBLE;
+  if (st->vL_ready)  flags |= REC_F_VL_READY;
+  if (st->vR_ready)  flags |= REC_F_VR_READY;
+  Rec_Frame(&s_us, (uint8_t)st->state, (uint8_t)st->mode, (int8_t)st->dir, flags, st->vC);
+  US_SetDriveHint(st->vC, (st->state == AUTO_ST_DRIVE) ? US_DRV_STRAIGHT : (st->mode == AUTO_TURN_ARC) ? US_DRV_ARC : US_DRV_PIVOT,
+                  (int8_t)st->dir);
+  Prof_End(PROF_AUTO_UPDATE, t0);
+}
+
+// 콘솔 "fsm" (기본 인스턴스): 상태별 누적 시간 + 최근 전이
+void AutoMode_Command(const char *arg)
+{
+  if      (arg[0] == '\0')        Fsm_Dump(&s_auto.fsm, HAL_GetTick(), 16u);
+  else if (!strcmp(arg, "reset")) { Fsm_ResetStats(&s_auto.fsm, HAL_GetTick()); printf("OK fsm reset\r\n"); }
+  else if (arg[0] >= '1' && arg[0] <= '9') Fsm_Dump(&s_auto.fsm, HAL_GetTick(), (uint16_t)atoi(arg));
+  else                             printf("ERR fsm [reset|n]\r\n");
 }
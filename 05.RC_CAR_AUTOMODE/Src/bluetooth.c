@@ -7,6 +7,8 @@
 
 
 #include "bluetooth.h"
+#include "param.h"
+#include "recorder.h"
 
 
 uint8_t serial_RxData;
@@ -17,8 +19,21 @@ volatile uint8_t forward=0, backward=0, right=0, left=0;
 volatile uint8_t speedUp=0, speedDown=0;
 volatile uint8_t noDir=0, stop=0;
 
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+	if(huart->Instance == USART2)
+	{
+		Rec_UartTxCplt(huart);     // 주행 기록 DMA 송출 (recorder.c)
+	}
+}
+
 void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
 {
+	if(huart->Instance == USART2)
+	{
+		Param_UartRxCplt(huart);   // 튜닝 파라미터 명령 (param.c)
+		return;
+	}
 	if(huart->Instance == USART1)
 	{
 	HAL_UART_Transmit (&huart2, &bluetooth_RxData, 1, 1000);
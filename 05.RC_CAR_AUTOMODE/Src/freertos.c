@@ -28,6 +28,7 @@
 #include "cmsis_os2.h"
 #include "ultrasonic.h"        // US_Left_cm/Right/Center
 #include "automode.h"          // 자동주행 상태 getter (아래 참고)
+#include "param.h"             // UART 파라미터 명령
 #include "stdio.h"
 /* USER CODE END Includes */
 
@@ -142,10 +143,12 @@ void ultrasonic(void *argument)
   /* Infinite loop */
 	US_Init();
 	US_FilterInit();
+	US_SetNotify(osThreadGetId());   // 에코 하강 엣지 ISR 이 이 태스크를 깨움
   for(;;)
   {
   	US_Update();
-    osDelay(10);
+  	// 에코 완료 알림 or 다음 트리거/타임아웃 시각까지 잠 (10ms 폴링 대신)
+  	osThreadFlagsWait(US_FLAG_ECHO, osFlagsWaitAny, US_IdleMs());
   }
   /* USER CODE END ultrasonic */
 }
@@ -183,6 +186,8 @@ void debugtask(void *argument)
   /* Infinite loop */
   for(;;)
   {
+  	Param_Poll();   // USART2 로 받은 파라미터 명령 처리
+  	osDelay(20);
 //  		printf("[TURN] F=%u L=%u R=%u\n", US_Center_cm(), US_Left_cm(), US_Right_cm());
 //
 //      osDelay(200);
@@ -0,0 +1,142 @@
+/*
+ * fsm.c — 표 구동 상태기계 엔진 + 전이 추적
+ */
+
+#include "fsm.h"
+#include <stdio.h>
+#include <string.h>
+
+void Fsm_Init(Fsm_t *f, const FsmDef_t *def, uint8_t start, uint32_t now)
+{
+  memset(f, 0, sizeof *f);
+  f->def = def;
+  f->cur = f->prev = start;
+  f->entered_ms = f->prev_entered_ms = now;
+  f->since_ms = now;
+}
+
+static void trace(Fsm_t *f, uint32_t now, uint8_t from, uint8_t to, uint8_t edge)
+{
+  if (f->head != 0u) {
+    FsmTrace_t *last = &f->trace[(f->head - 1u) & (FSM_TRACE_N - 1u)];
+    if (last->from == from && last->to == to && last->edge == edge) {
+      if (last->rep < 255u) last->rep++;
+      return;
+    }
+  }
+  f->trace[f->head & (FSM_TRACE_N - 1u)] = (FsmTrace_t){ now, from, to, edge, 1u };
+  f->head++;
+}
+
+static void go(Fsm_t *f, void *ctx, uint32_t now, const FsmEdge_t *e, uint8_t edge)
+{
+  const uint8_t from = f->cur;
+  const bool back = (e->to == FSM_BACK);
+  const uint8_t to = back ? f->prev : e->to;
+  const uint32_t entered = back ? f->prev_entered_ms : now;
+
+  if (e->act) e->act(ctx);
+
+  f->dwell_ms[from] += now - f->since_ms;
+  f->since_ms = now;
+  f->prev = from; f->prev_entered_ms = f->entered_ms;
+  f->cur  = to;   f->entered_ms = entered;
+  f->transitions++;
+  trace(f, now, from, to, edge);
+
+  if (!back && f->def->state[to].entry) f->def->state[to].entry(ctx);
+}
+
+void Fsm_Step(Fsm_t *f, void *ctx, uint32_t now)
+{
+  const FsmDef_t *d = f->def;
+
+  for (uint8_t pass = 0; pass < FSM_PASS_MAX; ++pass) {
+    const FsmState_t *s = &d->state[f->cur];
+    const FsmEdge_t  *e = NULL;
+    uint8_t id = 0;
+
+    // 1) 전역 전이
+    if ((s->flags & FSM_S_NO_GLOBAL) == 0u) {
+      for (uint8_t i = 0; i < d->global_num; ++i) {
+        if (d->global[i].guard(ctx)) { e = &d->global[i]; id = (uint8_t)(FSM_EDGE_GLOBAL | i); break; }
+      }
+    }
+
+    if (e == NULL) {
+      // 2) 본문
+      if (s->run) s->run(ctx);
+
+      // 3) 타임아웃 → 4) 가드 (표 순서)
+      const bool has_tmo = (s->tmo_ref != NULL) || (s->tmo_ms != 0u);
+      const uint32_t tmo = (s->tmo_ref != NULL) ? (uint32_t)(uint16_t)*s->tmo_ref : s->tmo_ms;
+      if (has_tmo && (int32_t)(now - f->entered_ms) >= (int32_t)tmo) {
+        e = &s->tmo; id = FSM_EDGE_TMO;
+      } else {
+        for (uint8_t i = 0; i < s->edge_num; ++i) {
+          if (s->edge[i].guard(ctx)) { e = &s->edge[i]; id = i; break; }
+        }
+      }
+    }
+
+    if (e == NULL) return;
+    go(f, ctx, now, e, id);
+    if ((e->flags & FSM_E_GO) == 0u) return;
+  }
+}
+
+void Fsm_Dwell(const Fsm_t *f, uint32_t now, uint32_t out[FSM_STATE_MAX])
+{
+  memcpy(out, f->dwell_ms, sizeof f->dwell_ms);
+  out[f->cur] += now - f->since_ms;
+}
+
+uint16_t Fsm_TraceNum(const Fsm_t *f)
+{
+  return (f->head < FSM_TRACE_N) ? (uint16_t)f->head : (uint16_t)FSM_TRACE_N;
+}
+
+bool Fsm_TraceAt(const Fsm_t *f, uint16_t k, FsmTrace_t *out)
+{
+  if (k >= Fsm_TraceNum(f)) return false;
+  *out = f->trace[(f->head - 1u - k) & (FSM_TRACE_N - 1u)];
+  return true;
+}
+
+const char *Fsm_EdgeName(const Fsm_t *f, const FsmTrace_t *t)
+{
+  const FsmDef_t *d = f->def;
+  if (t->edge == FSM_EDGE_TMO) return d->state[t->from].tmo.name ? d->state[t->from].tmo.name : "timeout";
+  if (t->edge & FSM_EDGE_GLOBAL) {
+    const uint8_t i = t->edge & (uint8_t)~FSM_EDGE_GLOBAL;
+    return (i < d->global_num) ? d->global[i].name : "?";
+  }
+  return (t->edge < d->state[t->from].edge_num) ? d->state[t->from].edge[t->edge].name : "?";
+}
+
+void Fsm_ResetStats(Fsm_t *f, uint32_t now)
+{
+  memset(f->dwell_ms, 0, sizeof f->dwell_ms);
+  f->since_ms = now;
+  f->transitions = 0;
+  f->head = 0;
+}
+
+void Fsm_Dump(const Fsm_t *f, uint32_t now, uint16_t n)
+{
+  const FsmDef_t *d = f->def;
+  uint32_t dw[FSM_STATE_MAX];
+  Fsm_Dwell(f, now, dw);
+
+  printf("fsm %s  now %s  transitions %lu\r\n", d->name, d->state[f->cur].name, (unsigned long)f->transitions);
+  for (uint8_t i = 0; i < d->state_num; ++i)
+    printf("  %-8s %6lu.%03lu s\r\n", d->state[i].name, (unsigned long)(dw[i] / 1000u), (unsigned long)(dw[i] % 1000u));
+
+  FsmTrace_t t;
+  for (uint16_t k = (n < Fsm_TraceNum(f)) ? n : Fsm_TraceNum(f); k-- > 0u; ) {
+    if (!Fsm_TraceAt(f, k, &t)) continue;
+    printf("  %8lu  %-8s -> %-8s %s", (unsigned long)t.t_ms, d->state[t.from].name, d->state[t.to].name, Fsm_EdgeName(f, &t));
+    if (t.rep > 1u) printf(" x%u", t.rep);
+    printf("\r\n");
+  }
+}
@@ -19,6 +19,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include "cmsis_os.h"
+#include "dma.h"
 #include "tim.h"
 #include "usart.h"
 #include "gpio.h"
@@ -29,6 +30,9 @@
 #include "stdio.h"
 #include "bluetooth.h"
 #include "ultrasonic.h"
+#include "param.h"
+#include "recorder.h"
+#include "prof.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -99,18 +103,26 @@ int main(void)
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_TIM3_Init();
   MX_USART2_UART_Init();
   MX_USART1_UART_Init();
   MX_TIM4_Init();
   MX_TIM11_Init();
+  MX_TIM1_Init();
   /* USER CODE BEGIN 2 */
   HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_1);
   HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_2);
   HAL_TIM_Base_Start(&htim11); // for delay_us() Function
-  HAL_TIM_IC_Start_IT(&htim4, TIM_CHANNEL_1);
-  HAL_TIM_IC_Start_IT(&htim4, TIM_CHANNEL_2);
-  HAL_TIM_IC_Start_IT(&htim4, TIM_CHANNEL_3);
+  // 에코 캡처: CC 인터럽트 없이 DMA 로 에지 링에 (요청 / 스트림 시작은 ultrasonic.c)
+  HAL_TIM_IC_Start(&htim4, TIM_CHANNEL_1);
+  HAL_TIM_IC_Start(&htim4, TIM_CHANNEL_2);
+  HAL_TIM_IC_Start(&htim4, TIM_CHANNEL_3);
+
+  Prof_Init();                  // DWT 사이클 카운터 (prof 명령)
+  Param_Init();                 // 튜닝 파라미터: 플래시 → 실패 시 기본값
+  Param_UartStart(&huart2);     // USART2 한 줄 명령 (list/get/set/save/load/default)
+  Rec_Init(&huart2);            // 주행 기록 링 (rec on/dump 로 USART2 DMA 송출)
 
   /* USER CODE END 2 */
 
@@ -205,7 +217,10 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
     HAL_IncTick();
   }
   /* USER CODE BEGIN Callback 1 */
-
+  if (htim->Instance == TIM4)
+  {
+    US_TimOverflow();   // 초음파 타임스탬프 상위 16비트
+  }
   /* USER CODE END Callback 1 */
 }
 
@@ -0,0 +1,319 @@
+/*
+ * param.c — 런타임 튜닝 파라미터 테이블
+ *
+ *  편집본(s_edit) ← UART 명령 / 플래시 로드 / 기본값
+ *  현재값(g_param) ← Param_Sync 에서 편집본 통째로 복사 (제어 주기 중간에 값이 섞이지 않게)
+ */
+
+#include "param.h"
+#include "recorder.h"
+#include "prof.h"
+#include "ultrasonic.h"
+#include "automode.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ==== 플래시 배치 (STM32F411RE: Sector 7, 0x08060000, 128KB — 코드와 겹치지 않는 마지막 섹터) ====
+// 이미지가 이 섹터에 닿으면 링크 실패: param_flash.ld (링커 스크립트 끝에 INCLUDE)
+#ifndef PARAM_FLASH_ADDR
+#define PARAM_FLASH_ADDR    0x08060000u
+#endif
+#define PARAM_FLASH_SECTOR  FLASH_SECTOR_7
+#define PARAM_MAGIC         0x304D5250u   // "PRM0"
+
+typedef struct {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t count;          // 저장 당시 P_NUM (뒤에 필드가 추가돼도 앞쪽은 그대로 로드)
+  int16_t  v[P_NUM];
+  uint32_t crc;            // magic ~ v[] CRC32
+} param_block_t;
+
+// ==== 필드 정의 ====
+static const param_desc_t PARAM_DESC[P_NUM] = {
+  [P_FRONT_PIVOT_CM]    = { "FRONT_PIVOT_CM",    PT_U16,   20,  150,   64 },
+  [P_FRONT_ARC_CM]      = { "FRONT_ARC_CM",      PT_U16,   20,  200,   79 },
+  [P_FRONT_CLEAR_CM]    = { "FRONT_CLEAR_CM",    PT_U16,   20,  200,   75 },
+  [P_FRONT_TOO_CLOSE]   = { "FRONT_TOO_CLOSE",   PT_U16,    2,   60,   12 },
+  [P_TURN_MS]           = { "TURN_MS",           PT_U16,   50, 2000,  350 },
+  [P_ARC_MIN_MS]        = { "ARC_MIN_MS",        PT_U16,   50, 2000,  300 },
+  [P_ARC_MAX_MS]        = { "ARC_MAX_MS",        PT_U16,  100, 5000,  900 },
+  [P_DECIDE_EVERY_MS]   = { "DECIDE_EVERY_MS",   PT_U16,    5,  500,   30 },
+  [P_HOLD_DRIVE_MS]     = { "HOLD_DRIVE_MS",     PT_U16,    0, 2000,  150 },
+  [P_HOLD_TURN_MS]      = { "HOLD_TURN_MS",      PT_U16,    0, 2000,  130 },
+  [P_VC_FAST_CLOSE_CMS] = { "VC_FAST_CLOSE_CMS", PT_I16, -300,  -10, -110 },
+  [P_VC_FAST_OPEN_CMS]  = { "VC_FAST_OPEN_CMS",  PT_I16,   10,  300,  110 },
+  [P_DC_CLOSE_STREAK_N] = { "DC_CLOSE_STREAK_N", PT_U8,     1,   10,    2 },
+  [P_DC_OPEN_STREAK_N]  = { "DC_OPEN_STREAK_N",  PT_U8,     1,   10,    2 },
+  [P_SPEED_MIN]         = { "SPEED_MIN",         PT_U16,    0, 1009,  390 },
+  [P_SPEED_BASE]        = { "SPEED_BASE",        PT_U16,    0, 1009,  PARAM_SPEED_BASE_DEF },
+  [P_SPEED_CRUISE]      = { "SPEED_CRUISE",      PT_U16,    0, 1009,  520 },
+  [P_SPEED_MAX]         = { "SPEED_MAX",         PT_U16,    0, 1009,  780 },
+  [P_STEP_UP]           = { "STEP_UP",           PT_U16,    1,  500,   40 },
+  [P_STEP_DOWN]         = { "STEP_DOWN",         PT_U16,    1,  500,  150 },
+  [P_STEP_DIFF]         = { "STEP_DIFF",         PT_U16,    1,  500,   50 },
+  [P_BUMP_WINDOW_MS]    = { "BUMP_WINDOW_MS",    PT_U16,    0, 2000,  350 },
+  [P_BUMP_HOLD_MS]      = { "BUMP_HOLD_MS",      PT_U16,    0, 2000,  240 },
+  [P_CHAIN_MS]          = { "CHAIN_MS",          PT_U16,    0, 2000,  350 },
+  [P_GOV_SLOW_CM]       = { "GOV_SLOW_CM",       PT_U16,   20,  200,   62 },
+  [P_GOV_FAST_CM]       = { "GOV_FAST_CM",       PT_U16,   20,  200,   68 },
+  [P_GOV_MODE]          = { "GOV_MODE",          PT_U8,     0,    1,    0 },
+  [P_GOV_TTC_MS]        = { "GOV_TTC_MS",        PT_U16,  100, 3000,  800 },
+};
+
+int16_t g_param[P_NUM];
+
+static int16_t          s_edit[P_NUM];
+static volatile uint8_t s_pending = 0;
+
+// ==== 유틸 ====
+static uint32_t crc32(const void *data, uint32_t len)
+{
+  const uint8_t *p = (const uint8_t *)data;
+  uint32_t c = 0xFFFFFFFFu;
+  while (len--) {
+    c ^= *p++;
+    for (uint8_t k = 0; k < 8; ++k) c = (c >> 1) ^ (0xEDB88320u & (uint32_t)-(int32_t)(c & 1u));
+  }
+  return ~c;
+}
+
+// 필드 간 조건 (개별 범위는 PARAM_DESC)
+static bool check_all(const int16_t *v)
+{
+  if (v[P_ARC_MIN_MS] > v[P_ARC_MAX_MS]) return false;
+  if (v[P_GOV_SLOW_CM] > v[P_GOV_FAST_CM]) return false;
+  if (v[P_SPEED_MIN]  > v[P_SPEED_BASE] || v[P_SPEED_BASE]   > v[P_SPEED_MAX]) return false;
+  if (v[P_SPEED_MIN]  > v[P_SPEED_CRUISE] || v[P_SPEED_CRUISE] > v[P_SPEED_MAX]) return false;
+  return true;
+}
+
+static void defaults(int16_t *v)
+{
+  for (uint8_t i = 0; i < P_NUM; ++i) v[i] = PARAM_DESC[i].def;
+}
+
+// 편집본 통째로 교체 (Param_Sync 가 반쯤 바뀐 값을 복사하지 않도록)
+static void commit_edit(const int16_t *v)
+{
+  __disable_irq();
+  memcpy(s_edit, v, sizeof s_edit);
+  s_pending = 1;
+  __enable_irq();
+}
+
+static bool ieq(const char *a, const char *b)
+{
+  for (; *a && *b; ++a, ++b) {
+    char x = *a, y = *b;
+    if (x >= 'a' && x <= 'z') x = (char)(x - 32);
+    if (y >= 'a' && y <= 'z') y = (char)(y - 32);
+    if (x != y) return false;
+  }
+  return *a == *b;
+}
+
+// ==== 공개 ====
+void Param_Init(void)
+{
+  if (!Param_Load()) Param_Default();
+  Param_Sync();
+}
+
+void Param_Sync(void)
+{
+  if (!s_pending) return;
+  __disable_irq();
+  memcpy(g_param, s_edit, sizeof g_param);
+  s_pending = 0;
+  __enable_irq();
+}
+
+const param_desc_t *Param_Desc(param_id_t id)
+{
+  return (id < P_NUM) ? &PARAM_DESC[id] : NULL;
+}
+
+int Param_Find(const char *name)
+{
+  for (uint8_t i = 0; i < P_NUM; ++i) {
+    if (ieq(name, PARAM_DESC[i].name)) return i;
+  }
+  return -1;
+}
+
+bool Param_Set(param_id_t id, int32_t v)
+{
+  if (id >= P_NUM) return false;
+  const param_desc_t *d = &PARAM_DESC[id];
+  if (v < d->min || v > d->max) return false;
+
+  int16_t next[P_NUM];
+  __disable_irq();
+  memcpy(next, s_edit, sizeof next);
+  __enable_irq();
+  next[id] = (int16_t)v;
+  if (!check_all(next)) return false;
+
+  commit_edit(next);
+  return true;
+}
+
+bool Param_Load(void)
+{
+  const param_block_t *b = (const param_block_t *)PARAM_FLASH_ADDR;
+  if (b->magic != PARAM_MAGIC || (b->version != PARAM_VERSION && b->version != 1u)) return false;
+  if (b->count == 0 || b->count > P_NUM) return false;
+  if (b->crc != crc32(b, (uint32_t)offsetof(param_block_t, crc))) return false;
+
+  int16_t v[P_NUM];
+  defaults(v);
+  for (uint8_t i = 0; i < b->count; ++i) {
+    const param_desc_t *d = &PARAM_DESC[i];
+    if (b->version == 1u && (i == P_VC_FAST_CLOSE_CMS || i == P_VC_FAST_OPEN_CMS)) continue;   // v1: cm/주기 → 기본값
+    if (b->v[i] >= d->min && b->v[i] <= d->max) v[i] = b->v[i];
+  }
+  if (!check_all(v)) return false;
+
+  commit_edit(v);
+  return true;
+}
+
+bool Param_Save(void)
+{
+  param_block_t b;
+  memset(&b, 0xFF, sizeof b);
+  b.magic   = PARAM_MAGIC;
+  b.version = PARAM_VERSION;
+  b.count   = P_NUM;
+  __disable_irq();
+  memcpy(b.v, s_edit, sizeof b.v);
+  __enable_irq();
+  b.crc = crc32(&b, (uint32_t)offsetof(param_block_t, crc));
+
+  FLASH_EraseInitTypeDef ei = {
+    .TypeErase    = FLASH_TYPEERASE_SECTORS,
+    .Sector       = PARAM_FLASH_SECTOR,
+    .NbSectors    = 1,
+    .VoltageRange = FLASH_VOLTAGE_RANGE_3,
+  };
+  uint32_t sector_err = 0;
+  bool ok = false;
+
+  HAL_FLASH_Unlock();
+  __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR |
+                         FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+  if (HAL_FLASHEx_Erase(&ei, &sector_err) == HAL_OK) {
+    const uint32_t *w = (const uint32_t *)&b;
+    ok = true;
+    for (uint32_t i = 0; i < sizeof b / 4u && ok; ++i) {
+      ok = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, PARAM_FLASH_ADDR + i * 4u, w[i]) == HAL_OK;
+    }
+  }
+  HAL_FLASH_Lock();
+
+  return ok && memcmp((const void *)PARAM_FLASH_ADDR, &b, sizeof b) == 0;
+}
+
+void Param_Default(void)
+{
+  int16_t v[P_NUM];
+  defaults(v);
+  commit_edit(v);
+}
+
+// ==== 명령 ====
+static void print_one(uint8_t i)
+{
+  const param_desc_t *d = &PARAM_DESC[i];
+  printf("%-18s %6d  [%d..%d] def %d%s\r\n", d->name, s_edit[i], d->min, d->max, d->def,
+         (s_edit[i] != g_param[i]) ? "  (pending)" : "");
+}
+
+void Param_Exec(const char *line)
+{
+  char buf[48];
+  char *arg[3] = { NULL, NULL, NULL };
+  uint8_t n = 0;
+
+  snprintf(buf, sizeof buf, "%s", line);
+  for (char *p = buf; *p && n < 3; ) {
+    while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') ++p;
+    if (*p == '\0') break;
+    arg[n++] = p;
+    while (*p && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') ++p;
+    if (*p) *p++ = '\0';
+  }
+  if (n == 0) return;
+
+  if (ieq(arg[0], "list")) {
+    printf("param v%u (%u fields)\r\n", PARAM_VERSION, P_NUM);
+    for (uint8_t i = 0; i < P_NUM; ++i) print_one(i);
+  }
+  else if (ieq(arg[0], "get") && n == 2) {
+    const int id = Param_Find(arg[1]);
+    if (id < 0) printf("ERR unknown %s\r\n", arg[1]); else print_one((uint8_t)id);
+  }
+  else if (ieq(arg[0], "set") && n == 3) {
+    const int id = Param_Find(arg[1]);
+    char *end;
+    const long v = strtol(arg[2], &end, 0);
+    if (id < 0)                               printf("ERR unknown %s\r\n", arg[1]);
+    else if (*end != '\0')                    printf("ERR value %s\r\n", arg[2]);
+    else if (!Param_Set((param_id_t)id, v))   printf("ERR range %s %ld\r\n", arg[1], v);
+    else                                      print_one((uint8_t)id);
+  }
+  else if (ieq(arg[0], "save") && !AutoMode_Idle()) printf("ERR running (stop first)\r\n");
+  else if (ieq(arg[0], "save"))    printf("%s", Param_Save() ? "OK saved\r\n" : "ERR flash\r\n");
+  else if (ieq(arg[0], "load"))    printf(Param_Load() ? "OK loaded\r\n" : "ERR no valid block\r\n");
+  else if (ieq(arg[0], "default")) { Param_Default(); printf("OK default\r\n"); }
+  else if (ieq(arg[0], "stop"))    { AutoMode_Hold(true);  printf("OK stop\r\n"); }
+  else if (ieq(arg[0], "go"))      { AutoMode_Hold(false); printf("OK go\r\n"); }
+  else if (ieq(arg[0], "rec"))     Rec_Command(n > 1 ? arg[1] : "");
+  else if (ieq(arg[0], "prof"))    Prof_Command(n > 1 ? arg[1] : "");
+  else if (ieq(arg[0], "us"))      US_Command(n > 1 ? arg[1] : "");
+  else if (ieq(arg[0], "fsm"))     AutoMode_Command(n > 1 ? arg[1] : "");
+  else printf("ERR cmd (list | get N | set N V | stop | save | go | load | default | rec [on|off|dump] | prof [reset] | us [seq|pair|risk|adapt|fixed|med=L/R/C|temp=C] | fsm [reset|n])\r\n");
+}
+
+// ==== UART 수신 (ISR 에서 한 줄 모으고, 처리는 태스크에서) ====
+#define PARAM_LINE_MAX  48u
+
+static UART_HandleTypeDef *s_huart;
+static uint8_t             s_rx;
+static char                s_acc[PARAM_LINE_MAX];
+static uint8_t             s_acc_len = 0;
+static char                s_line[PARAM_LINE_MAX];
+static volatile uint8_t    s_line_ready = 0;
+
+void Param_UartStart(UART_HandleTypeDef *huart)
+{
+  s_huart = huart;
+  HAL_UART_Receive_IT(s_huart, &s_rx, 1);
+}
+
+void Param_UartRxCplt(UART_HandleTypeDef *huart)
+{
+  if (huart != s_huart) return;
+
+  if (s_rx == '\r' || s_rx == '\n') {
+    if (s_acc_len > 0 && !s_line_ready) {       // 이전 줄 처리 중이면 버림
+      memcpy(s_line, s_acc, s_acc_len);
+      s_line[s_acc_len] = '\0';
+      s_line_ready = 1;
+    }
+    s_acc_len = 0;
+  } else if (s_acc_len < PARAM_LINE_MAX - 1u) {
+    s_acc[s_acc_len++] = (char)s_rx;
+  }
+  HAL_UART_Receive_IT(s_huart, &s_rx, 1);
+}
+
+void Param_Poll(void)
+{
+  if (!s_line_ready) return;
+  Param_Exec(s_line);
+  s_line_ready = 0;
+}
@@ -0,0 +1,88 @@
+/*
+ * prof.c — DWT 사이클 카운터 프로파일링
+ */
+
+#include "prof.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char *const NAME[PROF_NUM] = {
+  [PROF_TIM4_IRQ]     = "tim4_irq",
+  [PROF_EDGE_DMA_IRQ] = "edge_dma_irq",
+  [PROF_US_PROCESS]   = "us_process",
+  [PROF_US_FILTER]    = "us_filter",
+  [PROF_AUTO_UPDATE]  = "auto_update",
+  [PROF_APPLY_PWM]    = "apply_pwm",
+};
+
+static prof_stat_t s_stat[PROF_NUM];
+static uint32_t    s_since_ms;     // 통계 시작 시각 (CPU 점유율 분모)
+
+void Prof_Reset(void)
+{
+  __disable_irq();
+  memset(s_stat, 0, sizeof s_stat);
+  for (uint8_t i = 0; i < PROF_NUM; ++i) s_stat[i].min = UINT32_MAX;
+  s_since_ms = HAL_GetTick();
+  __enable_irq();
+}
+
+void Prof_Init(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;   // 디버거 없이도 DWT 사용
+  DWT->CYCCNT = 0u;
+  DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
+  Prof_Reset();
+}
+
+#if PROF_ENABLE
+void Prof_End(prof_id_t id, uint32_t t0)
+{
+  const uint32_t dc = DWT->CYCCNT - t0;
+  prof_stat_t *s = &s_stat[id];
+  s->calls++;
+  s->sum += dc;
+  if (dc < s->min) s->min = dc;
+  if (dc > s->max) s->max = dc;
+  s->hist[dc ? 31u - (uint32_t)__builtin_clz(dc) : 0u]++;
+}
+#endif
+
+void Prof_Get(prof_id_t id, prof_stat_t *out)
+{
+  __disable_irq();
+  *out = s_stat[id];
+  __enable_irq();
+}
+
+static void dump(void)
+{
+  const uint32_t ms  = HAL_GetTick() - s_since_ms;
+  const uint32_t mhz = SystemCoreClock / 1000000u;
+  printf("prof %lu.%03lu s @ %lu MHz\r\n", (unsigned long)(ms / 1000u), (unsigned long)(ms % 1000u), (unsigned long)mhz);
+  printf("%-12s %9s %8s %8s %8s %8s %7s\r\n", "probe", "calls", "min", "mean", "max", "max_us", "cpu%");
+  for (uint8_t i = 0; i < PROF_NUM; ++i) {
+    prof_stat_t s;
+    Prof_Get((prof_id_t)i, &s);
+    if (s.calls == 0u) { printf("%-12s %9s\r\n", NAME[i], "-"); continue; }
+    const uint32_t mean = (uint32_t)(s.sum / s.calls);
+    // 점유율 [0.001%] = 합 / (경과 ms × 사이클/ms)
+    const uint64_t budget = (uint64_t)(ms ? ms : 1u) * (SystemCoreClock / 1000u);
+    const uint32_t milli  = (uint32_t)(s.sum * 100000u / budget);
+    printf("%-12s %9lu %8lu %8lu %8lu %8lu %3lu.%03lu\r\n", NAME[i], (unsigned long)s.calls,
+           (unsigned long)s.min, (unsigned long)mean, (unsigned long)s.max,
+           (unsigned long)(s.max / (mhz ? mhz : 1u)), (unsigned long)(milli / 1000u), (unsigned long)(milli % 1000u));
+    printf("  log2");
+    for (uint8_t k = 0; k < PROF_BINS; ++k) {
+      if (s.hist[k]) printf(" %u:%lu", k, (unsigned long)s.hist[k]);
+    }
+    printf("\r\n");
+  }
+}
+
+void Prof_Command(const char *arg)
+{
+  if      (arg[0] == '\0')         dump();
+  else if (!strcmp(arg, "reset"))  { Prof_Reset(); printf("OK prof reset\r\n"); }
+  else                             printf("ERR prof [reset]\r\n");
+}
@@ -0,0 +1,138 @@
+/*
+ * recorder.c — 주행 기록기
+ *
+ *  쓰기: autocontrol 태스크 (Rec_Frame, 주기당 1회)
+ *  읽기: USART2 DMA — 링의 연속 구간을 한 번에 보내고, TxCplt 에서 다음 구간
+ *  송출 중 링이 차면 새 레코드를 버림 (DMA 가 읽는 중인 칸을 덮지 않게) → seq 가 건너뜀
+ */
+
+#include "recorder.h"
+#include "ultrasonic.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#define REC_CHUNK_MAX  32u     // DMA 1회 최대 레코드 수 (1.1KB)
+
+static rec_t               s_ring[REC_RING_N];
+static volatile uint32_t   s_head = 0;      // 다음 쓸 위치 (누적)
+static volatile uint32_t   s_tail = 0;      // 다음 보낼 위치 (누적)
+static volatile uint32_t   s_inflight = 0;  // DMA 로 나가는 중인 레코드 수
+static volatile rec_mode_t s_mode = REC_RING;
+static uint16_t            s_seq = 0;
+static uint32_t            s_dropped = 0;
+static UART_HandleTypeDef *s_huart;
+
+uint16_t Rec_Crc16(const void *data, uint32_t len)
+{
+  const uint8_t *p = (const uint8_t *)data;
+  uint16_t c = 0xFFFFu;
+  while (len--) {
+    c ^= (uint16_t)(*p++ << 8);
+    for (uint8_t k = 0; k < 8; ++k) c = (c & 0x8000u) ? (uint16_t)((c << 1) ^ 0x1021u) : (uint16_t)(c << 1);
+  }
+  return c;
+}
+
+// 보낼 게 있고 DMA 가 놀고 있으면 다음 구간 시작 (태스크/ISR 양쪽에서 호출)
+static void kick(void)
+{
+  __disable_irq();
+  if (s_inflight == 0 && s_mode != REC_RING && s_head != s_tail) {
+    const uint32_t at  = s_tail & (REC_RING_N - 1u);
+    uint32_t n = s_head - s_tail;
+    if (n > REC_RING_N - at) n = REC_RING_N - at;     // 링 끝에서 끊음
+    if (n > REC_CHUNK_MAX)   n = REC_CHUNK_MAX;
+    s_inflight = n;
+    __enable_irq();
+    if (HAL_UART_Transmit_DMA(s_huart, (uint8_t *)&s_ring[at], (uint16_t)(n * sizeof(rec_t))) != HAL_OK) {
+      s_inflight = 0;    // printf 가 점유 중이면 다음 프레임에 재시도
+    }
+    return;
+  }
+  __enable_irq();
+}
+
+void Rec_Init(UART_HandleTypeDef *huart)
+{
+  s_huart = huart;
+  s_head = s_tail = s_inflight = 0;
+  s_seq = 0; s_dropped = 0;
+  s_mode = REC_RING;
+}
+
+void Rec_Frame(const us_frame_t *us, uint8_t state, uint8_t mode, int8_t dir, uint8_t flags, int16_t vC)
+{
+  if (s_mode == REC_DUMP) { kick(); return; }   // 덤프 중엔 링 고정
+
+  const uint32_t head = s_head;
+  if (s_mode == REC_STREAM && head - s_tail >= REC_RING_N) {
+    s_dropped++; s_seq++;
+    kick();
+    return;
+  }
+
+  rec_t *r = &s_ring[head & (REC_RING_N - 1u)];
+  r->sync    = REC_SYNC;
+  r->version = REC_VERSION;
+  r->seq     = s_seq++;
+  r->tick    = HAL_GetTick();
+  memcpy(r->echo_us, us->echo_us, sizeof r->echo_us);   // automode 가 이번 주기에 본 프레임 그대로
+  memcpy(r->dist_cm, us->cm, sizeof r->dist_cm);
+  r->state   = state;
+  r->mode    = mode;
+  r->dir     = dir;
+  r->flags   = flags;
+  r->vC      = vC;
+  r->vL      = us->rate_cms[US_L];
+  r->vR      = us->rate_cms[US_R];
+  r->ccr1    = (uint16_t)TIM3->CCR1;
+  r->ccr2    = (uint16_t)TIM3->CCR2;
+  r->crc     = Rec_Crc16(r, offsetof(rec_t, crc));
+
+  __disable_irq();
+  s_head = head + 1u;
+  if (s_mode == REC_RING && s_head - s_tail > REC_RING_N) s_tail = s_head - REC_RING_N;   // 오래된 것부터 덮음
+  __enable_irq();
+
+  kick();
+}
+
+void Rec_SetMode(rec_mode_t m)
+{
+  __disable_irq();
+  if (m == REC_STREAM && s_mode != REC_STREAM) s_tail = s_head;   // 지금부터 실시간
+  if (m == REC_DUMP && s_head - s_tail > REC_RING_N) s_tail = s_head - REC_RING_N;
+  s_mode = m;
+  __enable_irq();
+  kick();
+}
+
+void Rec_UartTxCplt(UART_HandleTypeDef *huart)
+{
+  if (huart != s_huart || s_inflight == 0) return;
+  s_tail += s_inflight;
+  s_inflight = 0;
+  if (s_mode == REC_DUMP && s_tail == s_head) s_mode = REC_RING;   // 덤프 끝 → 다시 기록
+  kick();
+}
+
+bool Rec_Last(rec_t *out)
+{
+  __disable_irq();
+  const uint32_t head = s_head;
+  if (head != 0u) *out = s_ring[(head - 1u) & (REC_RING_N - 1u)];
+  __enable_irq();
+  return head != 0u;
+}
+
+void Rec_Command(const char *arg)
+{
+  if      (arg[0] == '\0')            printf("rec mode %u head %lu tail %lu dropped %lu (v%u, %u B)\r\n",
+                                             (unsigned)s_mode, (unsigned long)s_head, (unsigned long)s_tail,
+                                             (unsigned long)s_dropped, REC_VERSION, (unsigned)sizeof(rec_t));
+  else if (!strcmp(arg, "on"))        { printf("OK rec on\r\n");   Rec_SetMode(REC_STREAM); }
+  else if (!strcmp(arg, "dump"))      { printf("OK rec dump\r\n"); Rec_SetMode(REC_DUMP); }
+  else if (!strcmp(arg, "off"))       { Rec_SetMode(REC_RING); printf("OK rec off\r\n"); }
+  else                                printf("ERR rec [on|off|dump]\r\n");
+}
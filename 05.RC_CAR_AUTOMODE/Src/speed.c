@@ -8,36 +8,34 @@
 
 #include "speed.h"
 #include "tim.h"       // __HAL_TIM_SET_COMPARE 사용 시
+#include "param.h"
+#include "prof.h"
 #include <stdio.h>
 
 // ==== TUNING (필드에서 조정) ====
-#define SPEED_MIN       390u   // 이전 400 → 저속 코너링 확보
-#define SPEED_BASE      390u   // 이전 400
-#define SPEED_CRUISE    520u   // 목표 순항 근처(옵션)
-#define SPEED_MAX       780u   // 이전 800
-
-#define STEP_UP          40u   // 가속은 작게 (관성 축적 억제)
-#define STEP_DOWN       150u   // 감속은 크게 (벽 근접 시 민첩)
-#define STEP_DIFF        50u   // 좌/우 미세 보정 1회량 (과하지 않게)
+// SPEED_MIN/BASE/CRUISE/MAX, STEP_UP/DOWN/DIFF 는 param.c 런타임 테이블 (UART set → save)
+//  - STEP_UP 작게 (관성 축적 억제), STEP_DOWN 크게 (벽 근접 시 민첩)
 
 extern TIM_HandleTypeDef htim3; // TIM3 CH1=Right, CH2=Left (보드에 맞게)
 
 // ==== 내부 상태 ====
-static uint16_t rightMotorSpeed = SPEED_BASE;
-static uint16_t leftMotorSpeed  = SPEED_BASE;
+static uint16_t rightMotorSpeed = PARAM_SPEED_BASE_DEF;   // SPEED_BASE 기본값 (Param_Init 전 호출 대비)
+static uint16_t leftMotorSpeed  = PARAM_SPEED_BASE_DEF;
 
 // ==== 유틸 ====
 static inline uint16_t clamp16(uint16_t v)
 {
-    if (v < SPEED_MIN) return SPEED_MIN;
-    if (v > SPEED_MAX) return SPEED_MAX;
+    if (v < PARAM(SPEED_MIN)) return PARAM(SPEED_MIN);
+    if (v > PARAM(SPEED_MAX)) return PARAM(SPEED_MAX);
     return v;
 }
 
 static inline void apply_pwm(void)
 {
+    const uint32_t t0 = Prof_Begin();
     __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, rightMotorSpeed); // CCR1 (Right)
     __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_2, leftMotorSpeed);  // CCR2 (Left)
+    Prof_End(PROF_APPLY_PWM, t0);
 }
 
 // ===== (레거시) motor_* API =====
@@ -48,46 +46,46 @@ void motor_speedInit(void)
     // 타이머 현재값을 베이스로 삼고, 비정상 범위면 안전값으로 보정
     rightMotorSpeed = clamp16((uint16_t)TIM3->CCR1);
     leftMotorSpeed  = clamp16((uint16_t)TIM3->CCR2);
-    if (rightMotorSpeed < SPEED_MIN || rightMotorSpeed > SPEED_MAX) rightMotorSpeed = SPEED_BASE;
-    if (leftMotorSpeed  < SPEED_MIN || leftMotorSpeed  > SPEED_MAX) leftMotorSpeed  = SPEED_BASE;
+    if (rightMotorSpeed < PARAM(SPEED_MIN) || rightMotorSpeed > PARAM(SPEED_MAX)) rightMotorSpeed = PARAM(SPEED_BASE);
+    if (leftMotorSpeed  < PARAM(SPEED_MIN) || leftMotorSpeed  > PARAM(SPEED_MAX)) leftMotorSpeed  = PARAM(SPEED_BASE);
     apply_pwm();
 }
 
 void motor_speedUp(void)
 {
-    rightMotorSpeed = clamp16((uint16_t)(rightMotorSpeed + STEP_UP));
-    leftMotorSpeed  = clamp16((uint16_t)(leftMotorSpeed  + STEP_UP));
+    rightMotorSpeed = clamp16((uint16_t)(rightMotorSpeed + PARAM(STEP_UP)));
+    leftMotorSpeed  = clamp16((uint16_t)(leftMotorSpeed  + PARAM(STEP_UP)));
     apply_pwm();
 }
 
 void motor_speedDown(void)
 {
     // 감속은 강하게. 너무 낮아지지 않도록 클램프
-    rightMotorSpeed = (rightMotorSpeed > SPEED_MIN + STEP_DOWN)
-                    ? (uint16_t)(rightMotorSpeed - STEP_DOWN)
-                    : SPEED_MIN;
-    leftMotorSpeed  = (leftMotorSpeed  > SPEED_MIN + STEP_DOWN)
-                    ? (uint16_t)(leftMotorSpeed  - STEP_DOWN)
-                    : SPEED_MIN;
+    rightMotorSpeed = (rightMotorSpeed > PARAM(SPEED_MIN) + PARAM(STEP_DOWN))
+                    ? (uint16_t)(rightMotorSpeed - PARAM(STEP_DOWN))
+                    : PARAM(SPEED_MIN);
+    leftMotorSpeed  = (leftMotorSpeed  > PARAM(SPEED_MIN) + PARAM(STEP_DOWN))
+                    ? (uint16_t)(leftMotorSpeed  - PARAM(STEP_DOWN))
+                    : PARAM(SPEED_MIN);
     apply_pwm();
 }
 
 void motor_left_speedUp(void)
 {
     // 좌 바퀴 가속, 우 바퀴 약감속(코너 바깥바퀴/안쪽바퀴 느낌)
-    leftMotorSpeed  = clamp16((uint16_t)(leftMotorSpeed  + STEP_DIFF));
-    rightMotorSpeed = (rightMotorSpeed > SPEED_MIN + STEP_DIFF/2)
-                    ? (uint16_t)(rightMotorSpeed - STEP_DIFF/2)
-                    : SPEED_MIN;
+    leftMotorSpeed  = clamp16((uint16_t)(leftMotorSpeed  + PARAM(STEP_DIFF)));
+    rightMotorSpeed = (rightMotorSpeed > PARAM(SPEED_MIN) + PARAM(STEP_DIFF)/2)
+                    ? (uint16_t)(rightMotorSpeed - PARAM(STEP_DIFF)/2)
+                    : PARAM(SPEED_MIN);
     apply_pwm();
 }
 
 void motor_right_speedUp(void)
 {
-    rightMotorSpeed = clamp16((uint16_t)(rightMotorSpeed + STEP_DIFF));
-    leftMotorSpeed  = (leftMotorSpeed > SPEED_MIN + STEP_DIFF/2)
-                    ? (uint16_t)(leftMotorSpeed - STEP_DIFF/2)
-                    : SPEED_MIN;
+    rightMotorSpeed = clamp16((uint16_t)(rightMotorSpeed + PARAM(STEP_DIFF)));
+    leftMotorSpeed  = (leftMotorSpeed > PARAM(SPEED_MIN) + PARAM(STEP_DIFF)/2)
+                    ? (uint16_t)(leftMotorSpeed - PARAM(STEP_DIFF)/2)
+                    : PARAM(SPEED_MIN);
     apply_pwm();
 }
 
@@ -107,55 +105,55 @@ void pwm_sweep_test(void)
 
 void auto_motor_speedInit(void)
 {
-    rightMotorSpeed = leftMotorSpeed = clamp16(SPEED_BASE);
+    rightMotorSpeed = leftMotorSpeed = clamp16(PARAM(SPEED_BASE));
     apply_pwm();
 }
 
 void auto_motor_speedUp(void)
 {
     // 평상시 가속은 항상 완만하게
-    rightMotorSpeed = clamp16((uint16_t)(rightMotorSpeed + STEP_UP));
-    leftMotorSpeed  = clamp16((uint16_t)(leftMotorSpeed  + STEP_UP));
+    rightMotorSpeed = clamp16((uint16_t)(rightMotorSpeed + PARAM(STEP_UP)));
+    leftMotorSpeed  = clamp16((uint16_t)(leftMotorSpeed  + PARAM(STEP_UP)));
     apply_pwm();
 }
 
 void auto_motor_speedDown(void)
 {
     // 급접근 상황에서 반복 호출하면 짧은 시간에 강하게 느려짐
-    rightMotorSpeed = (rightMotorSpeed > SPEED_MIN + STEP_DOWN)
-                    ? (uint16_t)(rightMotorSpeed - STEP_DOWN)
-                    : SPEED_MIN;
-    leftMotorSpeed  = (leftMotorSpeed  > SPEED_MIN + STEP_DOWN)
-                    ? (uint16_t)(leftMotorSpeed  - STEP_DOWN)
-                    : SPEED_MIN;
+    rightMotorSpeed = (rightMotorSpeed > PARAM(SPEED_MIN) + PARAM(STEP_DOWN))
+                    ? (uint16_t)(rightMotorSpeed - PARAM(STEP_DOWN))
+                    : PARAM(SPEED_MIN);
+    leftMotorSpeed  = (leftMotorSpeed  > PARAM(SPEED_MIN) + PARAM(STEP_DOWN))
+                    ? (uint16_t)(leftMotorSpeed  - PARAM(STEP_DOWN))
+                    : PARAM(SPEED_MIN);
     apply_pwm();
 }
 
 void auto_motor_left_speedUp(void)
 {
-    leftMotorSpeed = clamp16((uint16_t)(leftMotorSpeed + STEP_DIFF));
+    leftMotorSpeed = clamp16((uint16_t)(leftMotorSpeed + PARAM(STEP_DIFF)));
     apply_pwm();
 }
 
 void auto_motor_right_speedUp(void)
 {
-    rightMotorSpeed = clamp16((uint16_t)(rightMotorSpeed + STEP_DIFF));
+    rightMotorSpeed = clamp16((uint16_t)(rightMotorSpeed + PARAM(STEP_DIFF)));
     apply_pwm();
 }
 
 void auto_motor_left_speedDown(void)
 {
-    leftMotorSpeed = (leftMotorSpeed > SPEED_MIN + STEP_DIFF)
-                   ? (uint16_t)(leftMotorSpeed - STEP_DIFF)
-                   : SPEED_MIN;
+    leftMotorSpeed = (leftMotorSpeed > PARAM(SPEED_MIN) + PARAM(STEP_DIFF))
+                   ? (uint16_t)(leftMotorSpeed - PARAM(STEP_DIFF))
+                   : PARAM(SPEED_MIN);
     apply_pwm();
 }
 
 void auto_motor_right_speedDown(void)
 {
-    rightMotorSpeed = (rightMotorSpeed > SPEED_MIN + STEP_DIFF)
-                    ? (uint16_t)(rightMotorSpeed - STEP_DIFF)
-                    : SPEED_MIN;
+    rightMotorSpeed = (rightMotorSpeed > PARAM(SPEED_MIN) + PARAM(STEP_DIFF))
+                    ? (uint16_t)(rightMotorSpeed - PARAM(STEP_DIFF))
+                    : PARAM(SPEED_MIN);
     apply_pwm();
 }
 
@@ -166,3 +164,9 @@ void auto_motor_slow(void)
     leftMotorSpeed  = clamp16(300);
     apply_pwm();
 }
+
+void get_speed(uint16_t *right_pwm, uint16_t *left_pwm)
+{
+    *right_pwm = rightMotorSpeed;
+    *left_pwm  = leftMotorSpeed;
+}
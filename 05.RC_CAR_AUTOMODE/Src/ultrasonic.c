@@ -6,38 +6,164 @@
  */
 
 #include "ultrasonic.h"
+#include "prof.h"
+#include "us_sched.h"
+#include "us_median.h"
+#include "us_track.h"
+#include "us_range.h"
+#include "cmsis_os2.h"
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
 
 // ===== 튜닝/가드 =====
 #define MAX_VALID_CM       400u   // 상한(환경에 맞춰 조정)
 #define MIN_VALID_CM         2u   // 너무 작은 쓰레기 펄스 제거
-#define MEDIAN_WIN           3u   // 3 또는 5 권장
+#define MEDIAN_WIN           3u   // 센서별 기본 창 (아래 MEDIAN_WIN_L/R/C), 홀수 1..US_MED_WIN_MAX
 #define FRAME_TIMEOUT_MS    80u   // 2m 환경 기준, 프레임 타임아웃
-#define TRIG_GAP_MS         40u   // 2m 환경: 충분한 센서 간격 (L-C-R-C)
+#define TRIG_GAP_MS         40u   // 2m 환경: 충분한 센서 간격 (L-C-R-C), 적응 슬롯의 상한 / 무에코 뒤 가드
+#define ECHO_DELAY_US      460u   // TRIG 하강 → ECHO 상승 (40kHz x8 버스트 + 모듈 내부 지연)
+#define RING_MARGIN_US    2000u   // 2차 반사(에코 한 번 더) 뒤 잔향이 가라앉을 여유
+#define SLOT_MIN_MS          3u   // 적응 슬롯 하한
+#define XT_WIN_MIN_US      600u   // 기대 에코 창 최소 반폭 (약 10cm)
+#define XT_MATCH_US        300u   // 같이 쏜 센서 에코와 이만큼 가까우면 그 센서 핑으로 봄 (약 5cm)
+#define XT_MAX_REJECT        3u   // 연속 보류 상한 — 넘으면 기대값을 버리고 새로 잡음
+#define TRIG_ONEPULSE_ARR   11u   // tim.c MX_TIM1_Init Period (CC1=1 set, CC2=11 reset → 10us)
+#define ECHO_DEADLINE_US 25000u   // TRIG 뒤 이때까지 하강 엣지가 없으면 무에코 (버스트 460 + 400cm 23200 + 여유)
+#define NOECHO_HOLD_MS      40u   // 무에코면 모듈이 ECHO 를 ~38ms 붙잡음 — 그 전에 다시 쏘면 무시됨
+#define ECHO_PULSE_MAX_US 40000u  // 이보다 긴 (상승, 하강) 쌍은 짝이 어긋난 것 (무에코 펄스 ~38ms 보다 길게)
+#define EDGE_RING            4u   // 센서별 캡처 에지 링 (하프워드) — 에코 2개분, DMA 하프/완료 = 짝수 쌍의 하강 에지
+
+// 1: TIM1 이 TRIG_GAP_MS 마다 슬롯 순서대로 혼자 쏨 (태스크는 캡처 결과만 처리)
+#ifndef US_TRIG_AUTONOMOUS
+#define US_TRIG_AUTONOMOUS   0u
+#endif
+
+// 부팅 시 슬롯 길이 — 1: 쏜 센서 에코가 다 오면 측정 에코 길이로 조기 마감, 0: TRIG_GAP_MS 고정
+// (automode 판단 임계값이 고정 간격에서 튜닝돼 있어서 기본 0)
+#ifndef US_GAP_ADAPTIVE
+#define US_GAP_ADAPTIVE      0u
+#endif
+
+// 센서별 미디언 창 (US_SetMedianWin / 콘솔 us med=L/R/C 로 바꿀 수 있음)
+#ifndef MEDIAN_WIN_L
+#define MEDIAN_WIN_L         MEDIAN_WIN
+#endif
+#ifndef MEDIAN_WIN_R
+#define MEDIAN_WIN_R         MEDIAN_WIN
+#endif
+#ifndef MEDIAN_WIN_C
+#define MEDIAN_WIN_C         MEDIAN_WIN
+#endif
+
+// 부팅 시 슬롯 순서 (automode 판단 임계값은 SEQ 샘플 간격에서 튜닝돼 있음)
+#ifndef US_SCHED_DEFAULT
+#define US_SCHED_DEFAULT     US_SCHED_SEQ
+#endif
 
 // ==== 공통 배열(volatile: ISR-메인 공유) ====
 typedef enum { US_LEFT=0, US_RIGHT=1, US_CENTER=2, US_NUM=3 } us_idx_t;
 
-static volatile uint8_t  captureFlag[US_NUM]   = {0};   // 0:rising대기, 1:falling대기, 2:완료
-static volatile uint16_t IC_Value_1[US_NUM]    = {0};
-static volatile uint16_t IC_Value_2[US_NUM]    = {0};
+static volatile uint8_t  captureFlag[US_NUM]   = {0};   // 0:에지 링에서 받는 중, 3:마감(에코 없음) — 마감 ISR 이 세움
+static volatile uint32_t IC_Value_1[US_NUM]    = {0};   // 상승 / 하강 엣지 시각 (32비트, edge_stamp)
+static volatile uint32_t IC_Value_2[US_NUM]    = {0};
 static volatile uint16_t echoTime[US_NUM]      = {0};   // 1 tick = 1us 전제
 static volatile uint16_t distance_cm[US_NUM]   = {0};   // 원시 거리(필터 전)
+static volatile uint16_t distance_mm[US_NUM]   = {0};   // 같은 샘플 [mm] (기온 보정, us_range.h)
 
-// 미디언 필터 버퍼
-static uint16_t med_buf[US_NUM][MEDIAN_WIN];
-static uint8_t  med_wpos[US_NUM] = {0};
-static uint8_t  med_filled[US_NUM] = {0};
+// 타임스탬프 [us] = TIM4 카운터를 오버플로 수로 32비트로 늘린 값 (1MHz → 약 71분마다 한 바퀴)
+static volatile uint32_t tim4_ovf = 0;                   // TIM4 업데이트 IRQ 횟수 (= 상위 16비트)
+static volatile uint32_t cap_ts_us[US_NUM]    = {0};   // 마지막 하강 엣지 (마감이면 마감 시각)
+static uint32_t          sample_ts_us[US_NUM] = {0};   // distance_cm 에 받아들인 샘플의 하강 엣지
 
-// 필터 출력(최종 제공값)
+// 미디언 필터 (거리와 그 샘플의 타임스탬프를 같이, us_median.c)
+static us_median_t      med[US_NUM];
+static volatile uint8_t med_win_req[US_NUM] = { MEDIAN_WIN_L, MEDIAN_WIN_R, MEDIAN_WIN_C };   // 콘솔 → US_Update 시작에서 반영
+
+// 필터 출력(최종 제공값) + 중앙값으로 뽑힌 샘플의 타임스탬프
 static volatile uint16_t filter_distance_cm[US_NUM] = {400,400,400};
+static volatile uint32_t filter_ts_us[US_NUM] = {0};
+
+// 거리/속도 추적 (받아들인 원시 샘플마다, us_track.c) — 미디언을 거치지 않아 지연 없음
+static us_track_t trk[US_NUM];
+
+// US_GetFrame 스냅샷 — 이중 버퍼 + 순번 (쓰는 쪽은 sonic 태스크 하나)
+//  frame_seq 가 2n 이면 n 번째 프레임이 frame_buf[n&1] 에 완성, 2n+1 이면 n+1 번째를 반대쪽에 쓰는 중
+//  → 읽는 쪽은 쓰는 중이어도 완성된 쪽을 바로 복사, 그 사이 두 번 넘게 내놓았을 때만 다시
+static us_frame_t        frame_buf[2] = { { .cm = {400,400,400} } };
+static volatile uint32_t frame_seq = 0;
+static bool              frame_dirty = false;   // 내놓은 뒤 필터 출력이 바뀜
 
 // 이번 라운드에서 새 샘플 완료 비트 (bit0=L, bit1=R, bit2=C)
 static volatile uint8_t frame_mask = 0;
 
 // 프레임 타이밍
 static uint32_t frame_start_ms = 0;
+static uint32_t last_trig_ms = 0;
+
+// 트리거 슬롯 = 한 번에 같이 쏘는 센서 비트 (bit0=L, bit1=R, bit2=C — us_sched.h US_SLOT_*)
+#define US_BIT(i)      (1u << (i))
+#define TRIG_SLOT_MAX  4u
+#define RATE_WIN_MS   1000u   // 센서별 실제 샷 수 집계 창
+
+static us_sched_t          sched = US_SCHED_SEQ;
+static volatile us_sched_t sched_req = US_SCHED_DEFAULT;   // 콘솔(debug 태스크) → US_Update 시작에서 반영
+static const us_policy_t  *policy;
+static const uint8_t      *slots;       // 자율 트리거 순환 표 (정책에 고정 순서가 없으면 seq 표)
+static uint8_t             slots_n;
+static uint8_t             slot_idx = 0;
+static uint8_t             slot_mask = 0;   // 현재 슬롯에서 쏜 센서
+static uint8_t             slot_done = 0;   // 그중 에코 처리 끝난 센서
+static volatile bool       gap_adapt = US_GAP_ADAPTIVE;   // 콘솔 → 다음 슬롯 마감부터
+static uint32_t            slot_len_ms = TRIG_GAP_MS;   // 현재 슬롯 길이 (에코가 다 오면 줄어듦)
+static uint32_t            gap_sum_ms = 0;  // 슬롯 길이 누적 (콘솔 평균)
+static uint32_t            gap_n = 0;
+
+// 기대 에코 창 (동시 발사 crosstalk / 잔향 거르기)
+static uint16_t xt_expect_us[US_NUM];       // 마지막으로 받아들인 에코 (0 = 아직 없음)
+static uint16_t xt_held_us[US_NUM];         // 창 밖이라 보류한 에코 (0 = 없음)
+static uint8_t  xt_miss[US_NUM];            // 연속 보류 수
+static uint16_t slot_echo_us[US_NUM];       // 이번 슬롯에서 받은 에코 (같이 쏜 센서 비교용)
+static uint32_t xt_reject[US_NUM];
+
+// TIM1 CC1/CC2 DMA 가 TRIG 포트 BSRR 로 쓰는 워드 (set / reset)
+// 단발: [0] 만 (NDTR=1 순환), 자율: 슬롯 순서대로 순환
+static volatile uint32_t trig_set[TRIG_SLOT_MAX];
+static volatile uint32_t trig_reset[TRIG_SLOT_MAX];
+static bool trig_auto = false;
+
+// 정책 입력 (automode 태스크 → US_SetDriveHint) / 센서별 마지막 샷, 샷 수
+static volatile int16_t    hint_vC = 0;
+static volatile us_drive_t hint_drive = US_DRV_STRAIGHT;
+static volatile int8_t     hint_dir = 0;
+static uint32_t            last_shot_ms[US_NUM];
+static uint16_t            rate_cnt[US_NUM];
+static volatile uint16_t   rate_hz[US_NUM];   // 직전 RATE_WIN_MS 창의 샷 수 (= Hz)
+static uint32_t            rate_start_ms = 0;
+
+// 에코 마감 (TIM4 CH4 출력 비교) — fire_slot 이 걸고, 하강 엣지가 다 오면 캡처 ISR 이 풂
+static volatile uint8_t  dl_mask = 0;                  // 아직 하강 엣지를 기다리는 센서
+static volatile uint32_t dl_ts_us = 0;                 // 마감 시각 (CCR4 의 32비트)
+static uint32_t          noecho_until_ms[US_NUM];      // 무에코 펄스가 끝나기 전 — 이 시각까지 그 센서는 안 쏨
+static uint32_t          noecho_cnt[US_NUM];           // 마감 횟수 (콘솔)
+
+// 캡처 에지 링 — TIM4 CH1~3 양쪽 에지를 DMA 가 CCRx 에서 순환으로 받아 씀 (에지마다 ISR 없음)
+//  쓰기 위치는 NDTR 로, 읽기 위치는 sonic 태스크만 움직임 / shot_pos: 이번 샷을 건 시점의 쓰기 위치
+//  샷을 짝수 칸에서 걸면 (상승, 하강) 이 [0,1] / [2,3] → 하강 에지에서 DMA 하프/완료 인터럽트 (에코당 1번)
+static volatile uint16_t edge_ring[US_NUM][EDGE_RING];
+static uint8_t           edge_rd[US_NUM];
+static volatile uint8_t  shot_pos[US_NUM];
+
+// 링 칸마다 32비트 시각 — 태스크가 처음 볼 때 기준 시각에서 16비트 차만큼 더해 채움 (edge_stamp)
+//  edge_seen: 시각을 채운 끝 / edge_base_us: 아직 안 본 에지보다 앞선 시각 (단발: 샷을 건 시각, 자율: 지난번 본 시각)
+static uint32_t          edge_ts[US_NUM][EDGE_RING];
+static uint8_t           edge_seen[US_NUM];
+static uint32_t          edge_base_us[US_NUM];
+static uint32_t          ts_alias[US_NUM];             // 기준이 65.5ms 넘게 지나 버린 에지 수 (콘솔)
+
+// 마감에서 깨울 태스크 (sonic)
+static osThreadId_t notify_task = NULL;
 
 // Center 신선도(옵션 개선 #5)
 static uint8_t  c_valid_streak = 0;
@@ -56,17 +182,13 @@ static inline uint32_t IT_FROM_CHANNEL(uint32_t channel)
     }
 }
 
-// 콜백의 active-channel -> 인덱스
-static inline int idx_from_active(HAL_TIM_ActiveChannel active) {
-    if (active == HAL_TIM_ACTIVE_CHANNEL_2) return US_LEFT;
-    if (active == HAL_TIM_ACTIVE_CHANNEL_1) return US_RIGHT;
-    if (active == HAL_TIM_ACTIVE_CHANNEL_3) return US_CENTER;
-    return -1;
-}
+// 채널별 CC DMA (tim.c MspInit: CH1 DMA1 Stream0, CH2 Stream3, CH3 Stream7)
+static const uint16_t DMA_ID[US_NUM]  = { TIM_DMA_ID_CC2, TIM_DMA_ID_CC1, TIM_DMA_ID_CC3 };
+static const uint32_t DMA_REQ[US_NUM] = { TIM_DMA_CC2, TIM_DMA_CC1, TIM_DMA_CC3 };
+static volatile uint32_t *const CCR_OF[US_NUM] = { &TIM4->CCR2, &TIM4->CCR1, &TIM4->CCR3 };
 
-// TRIG 포트/핀 (기존 define 재사용)
-static GPIO_TypeDef* const TRIG_PORT[US_NUM] = { TRIG_PORT_LEFT, TRIG_PORT_RIGHT, TRIG_PORT_CENTER };
-static const uint16_t      TRIG_PIN [US_NUM] = { TRIG_PIN_LEFT,  TRIG_PIN_RIGHT,  TRIG_PIN_CENTER  };
+// TRIG 핀 (기존 define 재사용, 포트는 셋 다 TRIG_PORT_CENTER)
+static const uint16_t TRIG_PIN[US_NUM] = { TRIG_PIN_LEFT, TRIG_PIN_RIGHT, TRIG_PIN_CENTER };
 
 static inline void clear_cc_flags_safely(uint32_t ch)
 {
@@ -79,84 +201,357 @@ static inline void clear_cc_flags_safely(uint32_t ch)
     if (ch == TIM_CHANNEL_4) __HAL_TIM_CLEAR_FLAG(&htim4, TIM_FLAG_CC4OF);
 }
 
-static void HCSR04_Trigger(us_idx_t i)
+static void slot_close(void);
+
+// 링 쓰기 위치 (DMA 가 다음에 쓸 칸)
+static inline uint8_t edge_wr(us_idx_t i)
+{
+    return (uint8_t)((EDGE_RING - __HAL_DMA_GET_COUNTER(htim4.hdma[DMA_ID[i]])) % EDGE_RING);
+}
+
+static inline uint8_t edge_count(us_idx_t i, uint8_t from)
+{
+    return (uint8_t)((edge_wr(i) + EDGE_RING - from) % EDGE_RING);
+}
+
+// 캡처 DMA 하프/완료 (DMA1 Stream0/3/7 IRQ, 우선순위 5) — 단발 모드에선 샷마다 하강 에지 한 번
+//  자율 모드는 태스크가 TIM1 위상으로 깨므로 (auto_poll_ms) 알림 안 함
+static void edge_dma_cb(DMA_HandleTypeDef *hdma)
 {
-    uint32_t ch = CHANNEL[i];
+    (void)hdma;
+    if (!trig_auto && notify_task != NULL) osThreadFlagsSet(notify_task, US_FLAG_ECHO);
+}
+
+// CCRx → edge_ring 순환 DMA 를 0 칸부터 다시 (요청 Enable 은 따로)
+static void edge_dma_start(us_idx_t i)
+{
+    DMA_HandleTypeDef *h = htim4.hdma[DMA_ID[i]];
+    HAL_DMA_Abort(h);
+    h->XferCpltCallback     = edge_dma_cb;
+    h->XferHalfCpltCallback = edge_dma_cb;
+    HAL_DMA_Start_IT(h, (uintptr_t)CCR_OF[i], (uintptr_t)edge_ring[i], EDGE_RING);
+}
+
+// 다음 에코를 받도록 캡처 채널 준비 — 링에 남은 에지는 버리고 지금 위치부터
+//  양쪽 에지라 첫 에지가 상승이어야 함: 무에코 펄스가 끝나기 전엔 안 쏘므로 (NOECHO_HOLD_MS) ECHO 는 Low
+//  쓰기 위치가 홀수면 (상승만 받고 마감 / 잔향 에지) DMA 를 다시 걸어 짝을 맞춤 — 요청이 꺼진 동안이라 잃는 에지 없음
+static void arm_capture(us_idx_t i)
+{
+    if (edge_wr(i) & 1u) edge_dma_start(i);
+    const uint8_t wr = edge_wr(i);
 
     // (1) CC 플래그/오버캡처 플래그 안전 클리어
-    clear_cc_flags_safely(ch);
+    clear_cc_flags_safely(CHANNEL[i]);
 
-    // (2) 다음 측정은 Rising부터
-    __HAL_TIM_SET_CAPTUREPOLARITY(&htim4, ch, TIM_INPUTCHANNELPOLARITY_RISING);
+    edge_rd[i]  = wr;
+    edge_seen[i] = wr;
+    shot_pos[i] = wr;
+    edge_base_us[i] = US_Now_us();
     captureFlag[i] = 0;
 
-    // (3) 10us TRIG 펄스
-    HAL_GPIO_WritePin(TRIG_PORT[i], TRIG_PIN[i], GPIO_PIN_RESET);
-    delay_us(1);
-    HAL_GPIO_WritePin(TRIG_PORT[i], TRIG_PIN[i], GPIO_PIN_SET);
-    delay_us(10);
-    HAL_GPIO_WritePin(TRIG_PORT[i], TRIG_PIN[i], GPIO_PIN_RESET);
+    // (2) CC DMA 요청 Enable (에코 상승은 TRIG 하강 후 ~460us 라 펄스보다 먼저 켜도 됨)
+    __HAL_TIM_ENABLE_DMA(&htim4, DMA_REQ[i]);
+}
 
-    // (4) 채널 인터럽트 Enable
-    __HAL_TIM_ENABLE_IT(&htim4, IT_FROM_CHANNEL(ch));
+// TIM1 CC1/CC2 DMA 시작 — 워드 n 개를 순환하며 TRIG 포트 BSRR 로
+static void trig_dma_start(uint32_t n)
+{
+    DMA_HandleTypeDef *set = htim1.hdma[TIM_DMA_ID_CC1];
+    DMA_HandleTypeDef *rst = htim1.hdma[TIM_DMA_ID_CC2];
+
+    HAL_DMA_Abort(set);
+    HAL_DMA_Abort(rst);
+    HAL_DMA_Start(set, (uintptr_t)trig_set,   (uintptr_t)&TRIG_PORT_CENTER->BSRR, n);
+    HAL_DMA_Start(rst, (uintptr_t)trig_reset, (uintptr_t)&TRIG_PORT_CENTER->BSRR, n);
+    __HAL_TIM_ENABLE_DMA(&htim1, TIM_DMA_CC1 | TIM_DMA_CC2);
 }
 
-// HCSR04_Trigger 래퍼
-void HCSR04_TRIGGER_LEFT(void)   { HCSR04_Trigger(US_LEFT); }
-void HCSR04_TRIGGER_RIGHT(void)  { HCSR04_Trigger(US_RIGHT); }
-void HCSR04_TRIGGER_CENTER(void) { HCSR04_Trigger(US_CENTER); }
+static uint16_t slot_pins(uint8_t mask)
+{
+    uint16_t pins = 0u;
+    for (uint8_t i = 0; i < US_NUM; ++i) if (mask & US_BIT(i)) pins |= TRIG_PIN[i];
+    return pins;
+}
 
-void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef *htim)
+// 샷 마감 시각을 CH4 에 — 지금부터 ECHO_DEADLINE_US 뒤 CC4 인터럽트 (TRIG 펄스 전에 걸어 둠)
+static void arm_deadline(uint8_t mask)
 {
-    if (htim->Instance != TIM4) return;
+    __HAL_TIM_DISABLE_IT(&htim4, TIM_IT_CC4);
+    dl_mask = mask;
+    dl_ts_us = US_Now_us() + ECHO_DEADLINE_US;
+    __HAL_TIM_SET_COMPARE(&htim4, TIM_CHANNEL_4, (uint16_t)dl_ts_us);
+    __HAL_TIM_CLEAR_FLAG(&htim4, TIM_FLAG_CC4);
+    __HAL_TIM_ENABLE_IT(&htim4, TIM_IT_CC4);
+}
 
-    int i = idx_from_active(htim->Channel);
-    if (i < 0) return;
+// 슬롯의 센서들을 한 펄스로 같이 쏨 — 실제로 쏜 센서 비트
+//  직전 샷이 무에코였던 센서는 NOECHO_HOLD_MS 동안 뺌 (모듈이 아직 ECHO 를 붙잡고 있어서 또 마감될 뿐)
+static uint8_t fire_slot(uint8_t mask)
+{
+    if (trig_auto) return 0u;   // TIM1 이 순서대로 쏘는 중
 
-    uint32_t ch = CHANNEL[i];
+    const uint32_t now = HAL_GetTick();
+    for (uint8_t i = 0; i < US_NUM; ++i) {
+        if ((mask & US_BIT(i)) && (int32_t)(now - noecho_until_ms[i]) < 0) mask &= (uint8_t)~US_BIT(i);
+    }
+
+    __HAL_TIM_DISABLE_IT(&htim4, TIM_IT_CC4);   // 지난 샷 마감이 새로 건 센서를 건드리지 않게
+    for (uint8_t i = 0; i < US_NUM; ++i) if (mask & US_BIT(i)) arm_capture((us_idx_t)i);
+    slot_mask = mask;
+    slot_done = 0u;
+    slot_len_ms = TRIG_GAP_MS;
+    if (mask == 0u) { slot_close(); return 0u; }
+    arm_deadline(mask);
+
+    // 10us TRIG 펄스: TIM1 one-pulse (CC1 에서 set, CC2 에서 reset 을 DMA 가 씀) → CPU 는 CEN 한 번
+    const uint16_t pins = slot_pins(mask);
+    trig_set[0]   = pins;
+    trig_reset[0] = (uint32_t)pins << 16;
+    __HAL_TIM_ENABLE(&htim1);
+    return mask;
+}
 
-    if (captureFlag[i] == 0) {
-        IC_Value_1[i] = HAL_TIM_ReadCapturedValue(htim, ch);
-        captureFlag[i] = 1;
-        __HAL_TIM_SET_CAPTUREPOLARITY(htim, ch, TIM_INPUTCHANNELPOLARITY_FALLING);
+// 단일 센서 트리거 래퍼
+void HCSR04_TRIGGER_LEFT(void)   { fire_slot(US_BIT(US_LEFT)); }
+void HCSR04_TRIGGER_RIGHT(void)  { fire_slot(US_BIT(US_RIGHT)); }
+void HCSR04_TRIGGER_CENTER(void) { fire_slot(US_BIT(US_CENTER)); }
+
+// main.c HAL_TIM_PeriodElapsedCallback (TIM4 업데이트)
+void US_TimOverflow(void)
+{
+    tim4_ovf++;
+}
+
+// 상위 = 업데이트 IRQ 횟수, 아직 안 센 업데이트가 걸려 있으면 (IRQ 차단 중 / 같은 ISR 안) 카운터가 작을 때만 +1
+//  HAL 은 UIF 를 지운 뒤 콜백을 부르므로 그 사이에 끼어드는 TIM4 보다 높은 우선순위 ISR 에선 부르지 말 것
+uint32_t US_Now_us(void)
+{
+    uint32_t hi, cnt;
+    bool pend;
+    do {
+        hi   = tim4_ovf;
+        cnt  = __HAL_TIM_GET_COUNTER(&htim4);
+        pend = __HAL_TIM_GET_FLAG(&htim4, TIM_FLAG_UPDATE);
+    } while (hi != tim4_ovf);
+    if (pend && cnt < 0x8000u) hi++;
+    return (hi << 16) | (cnt & 0xFFFFu);
+}
+
+// 에코 마감: 이번 샷에서 에지를 둘(상승, 하강) 다 받지 못한 센서는 무에코 — DMA 요청을 끄고 (늦은 엣지는 안 받음) 태스크를 깨움
+//  상승만 온 채든 아무것도 안 온 채(모듈 무응답)든 같이 풀림 / 에지는 링에 있지만 태스크가 아직 안 본 센서는 그대로 (깨우기만)
+static void echo_deadline(TIM_HandleTypeDef *htim)
+{
+    __HAL_TIM_DISABLE_IT(htim, TIM_IT_CC4);
+    const uint8_t armed = dl_mask;
+    dl_mask = 0u;
+    if (armed == 0u) return;
+
+    uint8_t late = 0u;
+    for (uint8_t i = 0; i < US_NUM; ++i) {
+        if ((armed & US_BIT(i)) && edge_count((us_idx_t)i, shot_pos[i]) < 2u) late |= (uint8_t)US_BIT(i);
     }
-    else if (captureFlag[i] == 1) {
-        IC_Value_2[i] = HAL_TIM_ReadCapturedValue(htim, ch);
-        captureFlag[i] = 2; // 완료
-        __HAL_TIM_SET_CAPTUREPOLARITY(htim, ch, TIM_INPUTCHANNELPOLARITY_RISING);
+
+    const uint32_t ts = dl_ts_us;
+    for (uint8_t i = 0; i < US_NUM; ++i) {
+        if (!(late & US_BIT(i))) continue;
+        __HAL_TIM_DISABLE_DMA(htim, DMA_REQ[i]);
+        cap_ts_us[i] = ts;
+        captureFlag[i] = 3;
     }
+    // ISR 우선순위 5 = syscall 허용 범위
+    if (notify_task != NULL) osThreadFlagsSet(notify_task, US_FLAG_ECHO);
 }
 
-static inline uint16_t getTimeDifference(uint16_t start, uint16_t end)
+void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim)
 {
-    return (uint16_t)(end - start);  // 16-bit 래핑 보정
+    if (htim->Instance == TIM4 && htim->Channel == HAL_TIM_ACTIVE_CHANNEL_4) echo_deadline(htim);
 }
 
-static void process_one(TIM_HandleTypeDef *htim, us_idx_t i)
+static void filter_sample(us_idx_t s);
+static void apply_schedule(us_sched_t s);
+
+static inline uint16_t absdiff_u16(uint16_t a, uint16_t b) { return (a > b) ? (uint16_t)(a - b) : (uint16_t)(b - a); }
+
+// 동시 발사 모드: 직전에 받아들인 에코 ± 창 밖이면 거름
+//  - 같은 슬롯에서 같이 쏜 센서 에코와 같으면 그 센서 핑이 샌 것(crosstalk) → 버림
+//  - 아니면 한 번 보류, 다음 샷도 보류값 근처면 실제 거리 변화로 보고 받아들임
+//  - XT_MAX_REJECT 번 연속 걸러지면 기대값이 틀렸다고 보고 그대로 받아들임
+static bool echo_in_window(us_idx_t i, uint16_t echo)
 {
-    if (captureFlag[i] == 2) {
-        echoTime[i] = getTimeDifference(IC_Value_1[i], IC_Value_2[i]); // tick=1us
-        // 1tick=1us → 거리[cm] ≈ echo(us)/58
-        uint16_t cm = (uint16_t)(echoTime[i] / 58u);
+    const uint16_t expect = xt_expect_us[i];
+    if (policy->crosstalk && expect != 0u && xt_miss[i] < XT_MAX_REJECT) {
+        uint16_t win = expect / 4u;
+        if (win < XT_WIN_MIN_US) win = XT_WIN_MIN_US;
+        if (absdiff_u16(echo, expect) > win) {
+            bool cross = false;
+            for (uint8_t j = 0; j < US_NUM; ++j) {
+                if (j != i && (slot_done & US_BIT(j)) && slot_echo_us[j] != 0u &&
+                    absdiff_u16(echo, slot_echo_us[j]) <= XT_MATCH_US) cross = true;
+            }
+            if (cross || xt_held_us[i] == 0u || absdiff_u16(echo, xt_held_us[i]) > win) {
+                if (!cross) xt_held_us[i] = echo;
+                xt_miss[i]++;
+                xt_reject[i]++;
+                return false;
+            }
+        }
+    }
+    xt_expect_us[i] = echo;
+    xt_held_us[i] = 0u;
+    xt_miss[i] = 0u;
+    return true;
+}
 
-        // (4) 비정상 샘플 거르기 (0/과대값) — 이전값 유지
-        if (cm >= MIN_VALID_CM && cm <= MAX_VALID_CM) {
-            distance_cm[i] = cm;  // 정상값만 반영
+// 링에 새로 들어온 에지를 32비트 시각으로 — 기준 시각에서 (캡처값 - 기준 하위 16비트) 만큼
+//  기준 뒤 65.5ms 안에 온 에지만 모호하지 않음
+//  단발: 기준 = 샷을 건 시각, 에지는 마감(25ms) 안에만 받음 → 태스크가 늦게 봐도 그대로 맞음
+//  자율: 기준 = 지난번 본 시각 — 그 사이가 65.5ms 를 넘었으면 몇 바퀴 돌았는지 모르므로 쌍 단위로 버림
+static void edge_stamp(us_idx_t i)
+{
+    const uint32_t now  = US_Now_us();
+    const uint8_t  wr   = edge_wr(i);
+    const uint32_t base = edge_base_us[i];
+    uint8_t k = edge_seen[i];
+
+    if (trig_auto && (now - base) > 0xFFFFu && k != wr) {
+        // 짝 없는 마지막 에지(하강을 기다리는 상승)만 남김 — 가장 최근 에지라 지금에서 거꾸로
+        const uint8_t n = (uint8_t)((wr + EDGE_RING - edge_rd[i]) % EDGE_RING);
+        ts_alias[i] += (uint32_t)(n & ~1u);
+        edge_rd[i] = k = (uint8_t)((wr + EDGE_RING - (n & 1u)) % EDGE_RING);
+        if (k != wr) edge_ts[i][k] = now - (uint16_t)((uint16_t)now - edge_ring[i][k]);
+    } else {
+        for (; k != wr; k = (uint8_t)((k + 1u) % EDGE_RING)) {
+            edge_ts[i][k] = base + (uint16_t)(edge_ring[i][k] - (uint16_t)base);
         }
+    }
+    edge_seen[i] = wr;
+    if (trig_auto) edge_base_us[i] = now;   // 지금 링 밖 에지는 모두 지금 뒤 (쓰기 위치를 지금 다음에 읽음)
+}
+
+// 링에 안 읽은 (상승, 하강) 쌍이 있으면 IC_Value_1/2 로 꺼냄
+//  폭이 ECHO_PULSE_MAX_US 보다 길면 하강부터 잡혀 짝이 어긋난 것 → 한 에지 버리고 다시 맞춤
+static bool edge_pair(us_idx_t i)
+{
+    edge_stamp(i);
+    uint8_t rd = edge_rd[i];
+    uint8_t n  = (uint8_t)((edge_seen[i] + EDGE_RING - rd) % EDGE_RING);
+    for (; n >= 2u; --n, rd = (uint8_t)((rd + 1u) % EDGE_RING)) {
+        const uint32_t rise = edge_ts[i][rd];
+        const uint32_t fall = edge_ts[i][(rd + 1u) % EDGE_RING];
+        if (fall - rise > ECHO_PULSE_MAX_US) continue;
+        IC_Value_1[i] = rise;
+        IC_Value_2[i] = fall;
+        edge_rd[i] = (uint8_t)((rd + 2u) % EDGE_RING);
+        return true;
+    }
+    edge_rd[i] = rd;
+    return false;
+}
 
+static void process_one(TIM_HandleTypeDef *htim, us_idx_t i)
+{
+    if (captureFlag[i] == 3) {
+        // 마감까지 에코 없음 → 열린 공간 (이전값을 그대로 두지 않음), 속도는 다음 에코부터 새로
+        echoTime[i] = 0u;
+        distance_cm[i] = US_OPEN_CM;
+        distance_mm[i] = US_OPEN_CM * 10u;
+        sample_ts_us[i] = cap_ts_us[i];
+        US_TrkReset(&trk[i]);
+        noecho_until_ms[i] = last_shot_ms[i] + NOECHO_HOLD_MS;
+        noecho_cnt[i]++;
         captureFlag[i] = 0;
-        __HAL_TIM_DISABLE_IT(htim, IT_FROM_CHANNEL(CHANNEL[i]));
+        slot_echo_us[i] = 0u;
+    }
+    else if (edge_pair(i)) {
+        cap_ts_us[i] = IC_Value_2[i];
+        echoTime[i] = (uint16_t)(IC_Value_2[i] - IC_Value_1[i]); // tick=1us, ECHO_PULSE_MAX_US 이하
+        // 1tick=1us → 거리[mm] = echo x 기온 보정 음속 (Q16, us_range.h), cm 는 반올림
+        const uint16_t mm = US_EchoToMm(echoTime[i]);
+        const uint16_t cm = (uint16_t)((mm + 5u) / 10u);
+
+        // (4) 비정상 샘플 거르기 (0/과대값, 기대 창 밖) — 이전값 유지
+        if (cm >= MIN_VALID_CM && cm <= MAX_VALID_CM && echo_in_window(i, echoTime[i])) {
+            distance_cm[i] = cm;  // 정상값만 반영
+            distance_mm[i] = mm;
+            sample_ts_us[i] = cap_ts_us[i];
+            // 측정 시각 = 에코 중간 (하강 엣지 - 에코/2), 거리는 mm 그대로
+            US_TrkUpdate(&trk[i], (float)mm * 0.1f, cap_ts_us[i] - echoTime[i] / 2u);
+        }
 
-        // 이번 라운드 갱신 완료 비트 설정
-        frame_mask |= (1u << i);
+        // 단발 모드: 샷당 한 쌍 — 요청을 끄고 뒤따른 에지(잔향)는 버림
+        if (!trig_auto) {
+            __HAL_TIM_DISABLE_DMA(htim, DMA_REQ[i]);
+            edge_rd[i] = edge_seen[i] = edge_wr(i);
+        }
+        slot_echo_us[i] = echoTime[i];
     }
+    else return;
+
+    slot_done |= (uint8_t)US_BIT(i);
+    if (slot_done == slot_mask) {
+        // 다 받음 → 마감 해제 (ISR 는 에지 수로 다시 보므로 그 사이 떠도 아무것도 안 함)
+        if (!trig_auto) { __HAL_TIM_DISABLE_IT(htim, TIM_IT_CC4); dl_mask = 0u; }
+        slot_close();
+    }
+
+    // 이번 라운드 갱신 완료 비트 설정
+    frame_mask |= (1u << i);
+
+    // 새 샘플은 프레임 경계를 기다리지 않고 바로 미디언에 넣음
+    filter_sample(i);
+}
+
+// 추적 속도 [cm/s] 반올림
+static int16_t trk_rate(us_idx_t i)
+{
+    const float v = trk[i].v;
+    return (int16_t)(v + ((v < 0.0f) ? -0.5f : 0.5f));
+}
+
+// 필터 출력이 바뀌었으면 다음 프레임으로 내놓음 (에코 처리 / 프레임 마감 끝에서 한 번)
+static void frame_publish(void)
+{
+    if (!frame_dirty) return;
+    frame_dirty = false;
+
+    const uint32_t n = (frame_seq >> 1) + 1u;
+    us_frame_t *f = &frame_buf[n & 1u];
+    frame_seq++;   // 홀수: n 번째 쓰는 중 (n-1 번째는 반대쪽에 그대로)
+    __DMB();
+    f->seq = n;
+    for (uint8_t i = 0; i < US_NUM; ++i) {
+        f->cm[i]      = filter_distance_cm[i];
+        f->echo_us[i] = echoTime[i];
+        f->mm[i]      = distance_mm[i];
+        f->ts_us[i]   = filter_ts_us[i];
+        f->rate_cms[i] = trk_rate(i);
+        f->conf[i]     = trk[i].conf;
+    }
+    f->wobble = (uint8_t)((trk[US_LEFT].wobble ? 1u << US_L : 0u) | (trk[US_RIGHT].wobble ? 1u << US_R : 0u)
+                        | (trk[US_CENTER].wobble ? 1u << US_C : 0u));
+    __DMB();
+    frame_seq++;
+}
+
+void US_GetFrame(us_frame_t *out)
+{
+    uint32_t s;
+    do {
+        s = frame_seq;
+        __DMB();
+        *out = frame_buf[(s >> 1) & 1u];
+        __DMB();
+    } while ((uint32_t)(frame_seq - (s & ~1u)) > 2u);   // 복사하던 버퍼에 다음다음 프레임을 쓰기 시작함
 }
 
 void processUltrasonic_All(void)
 {
+    const uint32_t t0 = Prof_Begin();
     process_one(&htim4, US_LEFT);
     process_one(&htim4, US_RIGHT);
     process_one(&htim4, US_CENTER);
+    frame_publish();
+    Prof_End(PROF_US_PROCESS, t0);
 }
 
 // 초기화
@@ -166,64 +561,127 @@ void US_Init(void)
     distance_cm[US_LEFT]   = 400u;
     distance_cm[US_RIGHT]  = 400u;
     distance_cm[US_CENTER] = 400u;
+    for (uint8_t i = 0; i < US_NUM; ++i) distance_mm[i] = 4000u;
     filter_distance_cm[US_LEFT]   = 400u;
     filter_distance_cm[US_RIGHT]  = 400u;
     filter_distance_cm[US_CENTER] = 400u;
     frame_mask = 0u;
     frame_start_ms = 0u;
+    last_trig_ms = 0u;
     c_valid_streak = 0u;
+    slot_idx = slot_mask = slot_done = 0u;
+    slot_len_ms = TRIG_GAP_MS;
+    gap_sum_ms = gap_n = 0u;
+    memset(xt_expect_us, 0, sizeof xt_expect_us);
+    memset(xt_held_us, 0, sizeof xt_held_us);
+    memset(xt_miss, 0, sizeof xt_miss);
+    memset(xt_reject, 0, sizeof xt_reject);
+    memset(last_shot_ms, 0, sizeof last_shot_ms);
+    memset(rate_cnt, 0, sizeof rate_cnt);
+    rate_start_ms = 0u;
+    memset(sample_ts_us, 0, sizeof sample_ts_us);
+    for (uint8_t i = 0; i < US_NUM; ++i) US_TrkReset(&trk[i]);
+    dl_mask = 0u;
+    memset(noecho_until_ms, 0, sizeof noecho_until_ms);
+    memset(noecho_cnt, 0, sizeof noecho_cnt);
+    memset(ts_alias, 0, sizeof ts_alias);
+
+    // 캡처 에지 링: CCRx → edge_ring 하프워드 순환 DMA (요청은 arm_capture 가 켬)
+    for (uint8_t i = 0; i < US_NUM; ++i) {
+        __HAL_TIM_DISABLE_DMA(&htim4, DMA_REQ[i]);
+        edge_dma_start((us_idx_t)i);
+        edge_rd[i] = edge_seen[i] = shot_pos[i] = 0u;
+        captureFlag[i] = 0u;
+    }
+
+    // 타임스탬프 상위 16비트: TIM4 업데이트 IRQ (HAL_TIM_IC_Start 는 캡처만 켬)
+    __HAL_TIM_CLEAR_FLAG(&htim4, TIM_FLAG_UPDATE);
+    __HAL_TIM_ENABLE_IT(&htim4, TIM_IT_UPDATE);
+
+    // TRIG 펄스: TIM1 단발 모드 + DMA 1워드 순환
+    trig_auto = true;             // 아래 호출이 항상 단발 모드를 설정하도록
+    US_SetAutoTrigger(false);
+    apply_schedule(sched_req);
+#if US_TRIG_AUTONOMOUS
+    US_SetAutoTrigger(true);
+#endif
+}
+
+// on: TIM1 이 TRIG_GAP_MS 주기로 슬롯을 순환하며 쏨 (OPM 해제, 캡처 DMA 상시 Enable)
+// off: 단발 모드로 복귀 — US_Update 가 HCSR04_Trigger 로 하나씩 쏨
+void US_SetAutoTrigger(bool on)
+{
+    if (on == trig_auto) return;
+
+    __HAL_TIM_DISABLE(&htim1);
+    __HAL_TIM_SET_COUNTER(&htim1, 0);
+
+    if (on) {
+        // 자율 모드는 TIM1 이 언제 쏘는지 태스크가 모름 → 샷 마감 없음 (프레임 타임아웃만)
+        __HAL_TIM_DISABLE_IT(&htim4, TIM_IT_CC4);
+        dl_mask = 0u;
+        for (uint8_t k = 0; k < slots_n; ++k) {
+            trig_set[k]   = slot_pins(slots[k]);
+            trig_reset[k] = (uint32_t)slot_pins(slots[k]) << 16;
+        }
+        arm_capture(US_LEFT);
+        arm_capture(US_RIGHT);
+        arm_capture(US_CENTER);
+        htim1.Instance->CR1 &= ~TIM_CR1_OPM;
+        __HAL_TIM_SET_AUTORELOAD(&htim1, TRIG_GAP_MS * 1000u - 1u);   // 1MHz, 16bit → 65ms 까지
+    } else {
+        __HAL_TIM_DISABLE_IT(&htim4, TIM_IT_CC4);
+        __HAL_TIM_DISABLE_DMA(&htim4, TIM_DMA_CC1 | TIM_DMA_CC2 | TIM_DMA_CC3);
+        dl_mask = 0u;
+        htim1.Instance->CR1 |= TIM_CR1_OPM;
+        __HAL_TIM_SET_AUTORELOAD(&htim1, TRIG_ONEPULSE_ARR);
+    }
+
+    trig_auto = on;
+    trig_dma_start(on ? slots_n : 1u);
+
+    if (on) {
+        frame_start_ms = HAL_GetTick();
+        __HAL_TIM_ENABLE(&htim1);
+    }
 }
 
 void US_FilterInit(void)
 {
     for (int s = 0; s < US_NUM; ++s) {
-        for (uint8_t k = 0; k < MEDIAN_WIN; ++k) med_buf[s][k] = 400u;
-        med_wpos[s] = 0u;
-        med_filled[s] = MEDIAN_WIN;
+        US_MedInit(&med[s], med_win_req[s], 400u, 0u);
         filter_distance_cm[s] = 400u;
+        filter_ts_us[s] = 0u;
     }
+    frame_dirty = true;
+    frame_publish();
 }
 
-// 아주 작은 N(<=5)에 적합한 삽입정렬 기반 미디안
-static inline uint16_t median_of(uint16_t *arr, uint8_t n)
+static inline void median_push_sample(us_idx_t s, uint16_t sample, uint32_t ts)
 {
-    for (uint8_t i = 1; i < n; ++i) {
-        uint16_t key = arr[i];
-        int8_t j = (int8_t)i - 1;
-        while (j >= 0 && arr[j] > key) {
-            arr[j + 1] = arr[j];
-            --j;
-        }
-        arr[j + 1] = key;
-    }
-    return arr[n / 2]; // n=3→idx1, n=5→idx2
+    // 클램프 후 창에 넣고 중앙값 (무에코 US_OPEN_CM 은 그대로)
+    if (sample > MAX_VALID_CM && sample != US_OPEN_CM) sample = MAX_VALID_CM;
+    uint32_t ts_med;
+    filter_distance_cm[s] = US_MedPush(&med[s], sample, ts, &ts_med);
+    filter_ts_us[s] = ts_med;
 }
 
-static inline void median_push_sample(us_idx_t s, uint16_t sample)
+// 창 크기 변경 — 현재 출력으로 새 창을 채움 (sonic 태스크에서만)
+static void apply_median_win(void)
 {
-    // 클램프 후 저장
-    if (sample > MAX_VALID_CM) sample = MAX_VALID_CM;
-    med_buf[s][med_wpos[s]] = sample;
-
-    // 포인터 갱신
-    med_wpos[s] = (uint8_t)((med_wpos[s] + 1u) % MEDIAN_WIN);
-    if (med_filled[s] < MEDIAN_WIN) med_filled[s]++;
-
-    // 중앙값 계산: 현재 버퍼 스냅샷 복사 후 median
-    uint16_t tmp[MEDIAN_WIN];
-    uint8_t n = med_filled[s];
-    for (uint8_t i = 0; i < n; ++i) tmp[i] = med_buf[s][i];
-
-    filter_distance_cm[s] = median_of(tmp, n);
+    for (uint8_t s = 0; s < US_NUM; ++s) {
+        if (med_win_req[s] != med[s].win) US_MedInit(&med[s], med_win_req[s], filter_distance_cm[s], filter_ts_us[s]);
+    }
 }
 
-static inline void filter_once(void)
+// 프레임 타임아웃으로 채우는 이전값도 원래 샘플 시각을 달고 들어감 → 묵은 센서는 나이가 계속 늘어남
+static void filter_sample(us_idx_t s)
 {
-    median_push_sample(US_LEFT,   distance_cm[US_LEFT]);
-    median_push_sample(US_RIGHT,  distance_cm[US_RIGHT]);
-    median_push_sample(US_CENTER, distance_cm[US_CENTER]);
+    median_push_sample(s, distance_cm[s], sample_ts_us[s]);
+    frame_dirty = true;
 
     // Center 신선도 스트릭(옵션 개선 #5)
+    if (s != US_CENTER) return;
     uint16_t c = filter_distance_cm[US_CENTER];
     if (c >= MIN_VALID_CM && c <= MAX_VALID_CM) {
         if (c_valid_streak < 255) c_valid_streak++;
@@ -232,23 +690,175 @@ static inline void filter_once(void)
     }
 }
 
-void US_Update(void)
+// 프레임 마감: 이번 프레임에 새 샘플이 없던 센서만 이전값으로 채움 (미디언 창 구성은 예전과 같음)
+static inline void filter_once(void)
 {
-    static uint32_t last_ms = 0;
+    const uint32_t t0 = Prof_Begin();
+    if (!(frame_mask & (1u << US_LEFT)))   filter_sample(US_LEFT);
+    if (!(frame_mask & (1u << US_RIGHT)))  filter_sample(US_RIGHT);
+    if (!(frame_mask & (1u << US_CENTER))) filter_sample(US_CENTER);
+    frame_publish();
+    Prof_End(PROF_US_FILTER, t0);
+}
+
+void US_SetNotify(osThreadId_t task)
+{
+    notify_task = task;
+}
+
+void US_SetSchedule(us_sched_t s)
+{
+    sched_req = s;
+}
+
+us_sched_t US_GetSchedule(void)
+{
+    return sched;
+}
 
+void US_SetDriveHint(int16_t vC, us_drive_t drive, int8_t dir)
+{
+    hint_vC    = vC;
+    hint_drive = drive;
+    hint_dir   = dir;
+}
+
+void US_GetRate(uint16_t out[3])
+{
+    for (uint8_t i = 0; i < US_NUM; ++i) out[i] = rate_hz[i];
+}
+
+void US_SetAdaptiveGap(bool on)
+{
+    gap_adapt = on;
+}
+
+bool US_GetAdaptiveGap(void)
+{
+    return gap_adapt;
+}
+
+bool US_SetMedianWin(const uint8_t win[3])
+{
+    for (uint8_t i = 0; i < US_NUM; ++i) {
+        if (win[i] < 1u || win[i] > US_MED_WIN_MAX) return false;
+    }
+    for (uint8_t i = 0; i < US_NUM; ++i) med_win_req[i] = win[i];
+    return true;
+}
+
+void US_GetMedianWin(uint8_t win[3])
+{
+    for (uint8_t i = 0; i < US_NUM; ++i) win[i] = med_win_req[i];
+}
+
+// 슬롯 모드 전환 (sonic 태스크에서만)
+static void apply_schedule(us_sched_t s)
+{
+    const bool was_auto = trig_auto;
+    if (was_auto) US_SetAutoTrigger(false);
+
+    sched    = s;
+    policy   = US_POLICY[s];
+    slots    = policy->slots ? policy->slots : US_POLICY[US_SCHED_SEQ]->slots;
+    slots_n  = policy->slots ? policy->n     : US_POLICY[US_SCHED_SEQ]->n;
+    slot_idx = 0u;
+    if (policy->reset) policy->reset();
+    memset(xt_expect_us, 0, sizeof xt_expect_us);
+    memset(xt_held_us, 0, sizeof xt_held_us);
+    memset(xt_miss, 0, sizeof xt_miss);
+    slot_len_ms = TRIG_GAP_MS;
+    if (slot_done == slot_mask) slot_close();   // 쏜 게 없거나 다 받은 슬롯이면 바로 마감 기준
+
+    if (was_auto) US_SetAutoTrigger(true);
+}
+
+// 쏜 센서 에코가 다 옴 → 가장 긴 에코로 슬롯 길이 결정
+//  TRIG 하강 + 버스트 + 에코 x2 (벽-차-벽 2차 반사가 다음 샷 창에 들어오지 않게) + 잔향 여유
+//  범위 밖(무에코 타임아웃 펄스 포함)이 하나라도 있으면 TRIG_GAP_MS 가드 유지
+//  crosstalk 로 짧게 잡힌 에코는 자기 핑이 아직 날아가는 중이라 기대 에코 쪽 길이를 씀
+static void slot_close(void)
+{
+    if (!gap_adapt) {
+        if (policy->close_ms != 0u) slot_len_ms = policy->close_ms;
+        return;
+    }
+
+    uint32_t echo_max = 0u;
+    for (uint8_t i = 0; i < US_NUM; ++i) {
+        if (!(slot_mask & US_BIT(i))) continue;
+        uint32_t e = slot_echo_us[i];
+        if (e == 0u) continue;   // 마감(무에코): 이미 ECHO_DEADLINE_US 지남, 핑은 4m 넘게 날아감
+        const uint32_t cm = (US_EchoToMm((uint16_t)e) + 5u) / 10u;
+        if (cm < MIN_VALID_CM || cm > MAX_VALID_CM) return;
+        if (xt_expect_us[i] > e) e = xt_expect_us[i];
+        if (e > echo_max) echo_max = e;
+    }
+    uint32_t len = (ECHO_DELAY_US + 2u * echo_max + RING_MARGIN_US + 999u) / 1000u;
+    if (len < SLOT_MIN_MS) len = SLOT_MIN_MS;
+    if (len < slot_len_ms) slot_len_ms = len;
+}
+
+// 현재 슬롯 길이: 에코가 다 오기 전이면 TRIG_GAP_MS
+static inline uint32_t slot_gap_ms(void)
+{
+    return slot_len_ms;
+}
+
+// 정책에 다음 슬롯을 물어봄 (고정 순서면 표를 돎)
+static uint8_t next_slot(uint32_t now)
+{
+    if (policy->next == NULL) {
+        const uint8_t m = policy->slots[slot_idx];
+        slot_idx = (uint8_t)((slot_idx + 1u) % policy->n);
+        return m;
+    }
+
+    us_view_t v;
+    v.now_ms = now;
+    for (uint8_t i = 0; i < US_NUM; ++i) {
+        v.cm[i]     = filter_distance_cm[i];
+        v.age_ms[i] = now - last_shot_ms[i];
+    }
+    v.vC    = hint_vC;
+    v.drive = hint_drive;
+    v.dir   = hint_dir;
+    v.ccr_l = (uint16_t)TIM3->CCR2;
+    v.ccr_r = (uint16_t)TIM3->CCR1;
+    return policy->next(&v) & (uint8_t)(US_BIT(US_NUM) - 1u);
+}
+
+// 센서별 샷 수 → RATE_WIN_MS 창마다 rate_hz 로
+static void count_shots(uint32_t now, uint8_t mask)
+{
+    if (rate_start_ms == 0u) rate_start_ms = now;
+    if ((uint32_t)(now - rate_start_ms) >= RATE_WIN_MS) {
+        for (uint8_t i = 0; i < US_NUM; ++i) { rate_hz[i] = rate_cnt[i]; rate_cnt[i] = 0u; }
+        rate_start_ms = now;
+    }
+    for (uint8_t i = 0; i < US_NUM; ++i) {
+        if (!(mask & US_BIT(i))) continue;
+        rate_cnt[i]++;
+        last_shot_ms[i] = now;
+    }
+}
+
+void US_Update(void)
+{
     uint32_t now = HAL_GetTick();
 
+    if (sched_req != sched) apply_schedule(sched_req);
+    apply_median_win();
+
     // 1) 캡처 완료건 처리 → distance_cm[] 갱신
     processUltrasonic_All();
 
-    // 2) 순차 트리거 (L-C-R-C)
-    static const us_idx_t order[] = { US_LEFT, US_CENTER, US_RIGHT, US_CENTER };
-    static uint8_t oidx = 0;
-
-    if ((uint32_t)(now - last_ms) >= TRIG_GAP_MS) {
-        HCSR04_Trigger(order[oidx]);
-        oidx = (uint8_t)((oidx + 1u) % (sizeof(order)/sizeof(order[0])));
-        last_ms = now;
+    // 2) 슬롯 트리거 (SEQ: L-C-R-C / PAIR: L+R, C) — 자율 모드면 TIM1 이 쏨
+    if (!trig_auto && (uint32_t)(now - last_trig_ms) >= slot_gap_ms()) {
+        if (frame_start_ms != 0u) { gap_sum_ms += now - last_trig_ms; gap_n++; }
+        const uint8_t mask = fire_slot(next_slot(now));
+        last_trig_ms = now;
+        count_shots(now, mask);
 
         // 프레임 시작 타임스탬프 초기화(첫 트리거 시)
         if (frame_start_ms == 0u) frame_start_ms = now;
@@ -259,16 +869,148 @@ void US_Update(void)
     bool frame_timeout  = (frame_start_ms != 0u) && ((uint32_t)(now - frame_start_ms) >= FRAME_TIMEOUT_MS);
 
     if (frame_complete || frame_timeout) {
-        filter_once();          // (2) 타임아웃이어도 사용 가능한 샘플로 필터 수행
+        filter_once();          // (2) 타임아웃이면 샘플 없는 센서는 이전값으로
         frame_mask = 0u;        // 다음 프레임 준비
         frame_start_ms = now;   // 새 프레임 시작
     }
 }
 
+// 자율 트리거 (마감 ISR 없음): TIM1 CNT = 이번 주기 샷 뒤 지난 us, TRIG DMA 남은 수 → 방금 쏜 슬롯
+//  그 슬롯 센서의 직전 에코가 끝날 즈음 / 마감 시각 / 주기 끝 중 아직 안 지난 가장 이른 때까지
+static uint32_t auto_poll_ms(void)
+{
+    const uint32_t t_us = __HAL_TIM_GET_COUNTER(&htim1);
+    uint8_t k = (uint8_t)((2u * slots_n - __HAL_DMA_GET_COUNTER(htim1.hdma[TIM_DMA_ID_CC1]) - 1u) % slots_n);
+    if (t_us < htim1.Instance->CCR1) k = (uint8_t)((k + 1u) % slots_n);   // 주기 막 시작 — 이번 슬롯은 CC1 에서 나감
+    uint32_t next = TRIG_GAP_MS * 1000u;
+    if (t_us < ECHO_DEADLINE_US) next = ECHO_DEADLINE_US;
+    for (uint8_t i = 0; i < US_NUM; ++i) {
+        if (!(slots[k] & US_BIT(i)) || echoTime[i] == 0u) continue;
+        const uint32_t due = ECHO_DELAY_US + echoTime[i] + echoTime[i] / 16u + 100u;   // 조금 멀어져도 한 번에
+        if (due > t_us && due < next) next = due;
+    }
+    return (next - t_us + 999u) / 1000u;
+}
+
+// 다음 트리거 / 에코 확인 / 프레임 타임아웃까지 남은 ms — sonic 태스크는 마감 알림이 없으면 이만큼 잠
+uint32_t US_IdleMs(void)
+{
+    const uint32_t now = HAL_GetTick();
+    const uint32_t since_trig = now - last_trig_ms;
+    const uint32_t gap = slot_gap_ms();
+    uint32_t wait = (since_trig >= gap) ? 0u : gap - since_trig;
+    if (trig_auto) wait = FRAME_TIMEOUT_MS;   // 트리거는 TIM1 몫
+
+    // 에코 대기 — 단발: 하강 에지(캡처 DMA 하프/완료) / 마감 ISR 이 깨움, 자율: TIM1 위상으로 직접 봄
+    if (trig_auto) {
+        const uint32_t poll = auto_poll_ms();
+        if (poll < wait) wait = poll;
+    }
+
+    if (frame_start_ms != 0u) {
+        const uint32_t since_frame = now - frame_start_ms;
+        const uint32_t to = (since_frame >= FRAME_TIMEOUT_MS) ? 0u : FRAME_TIMEOUT_MS - since_frame;
+        if (to < wait) wait = to;
+    }
+    return (wait != 0u) ? wait : 1u;
+}
+
 // === distance 반환 API ===
 uint16_t US_Left_cm(void)   { return filter_distance_cm[US_LEFT]; }
 uint16_t US_Right_cm(void)  { return filter_distance_cm[US_RIGHT]; }
 uint16_t US_Center_cm(void) { return filter_distance_cm[US_CENTER]; }
 
+// 같은 값 + 그 값(중앙값 샘플)의 하강 엣지 이후 지난 시간 [us]
+static uint16_t cm_age(us_idx_t i, uint32_t *age_us)
+{
+    uint16_t cm;
+    uint32_t ts;
+    do {   // 읽는 사이 sonic 태스크가 갱신하면 다시 (값과 나이가 다른 샘플 것이 되지 않게)
+        ts = filter_ts_us[i];
+        cm = filter_distance_cm[i];
+    } while (ts != filter_ts_us[i]);
+    if (age_us != NULL) *age_us = US_Now_us() - ts;
+    return cm;
+}
+
+uint16_t US_Left_cm_age(uint32_t *age_us)   { return cm_age(US_LEFT, age_us); }
+uint16_t US_Right_cm_age(uint32_t *age_us)  { return cm_age(US_RIGHT, age_us); }
+uint16_t US_Center_cm_age(uint32_t *age_us) { return cm_age(US_CENTER, age_us); }
+
+void US_GetStamp_us(uint32_t out[3])
+{
+    for (uint8_t i = 0; i < US_NUM; ++i) out[i] = filter_ts_us[i];
+}
+
+// 기록기(recorder.c)용 — us_idx_t 순서 [L,R,C]
+void US_GetEcho_us(uint16_t out[3])
+{
+    for (uint8_t i = 0; i < US_NUM; ++i) out[i] = echoTime[i];
+}
+
+void US_GetFiltered_cm(uint16_t out[3])
+{
+    for (uint8_t i = 0; i < US_NUM; ++i) out[i] = filter_distance_cm[i];
+}
+
+// "temp=23.5" (콘솔 출력용, 정적 버퍼)
+static const char *temp_str(void)
+{
+    static char buf[16];
+    const int16_t t = US_RangeGetTemp();
+    const unsigned a = (unsigned)(t < 0 ? -t : t);
+    snprintf(buf, sizeof buf, "temp=%s%u.%u", t < 0 ? "-" : "", a / 10u, a % 10u);
+    return buf;
+}
+
+// 콘솔 "us [seq|pair|risk|adapt|fixed|med=L/R/C|temp=C]" (param.c)
+void US_Command(const char *arg)
+{
+    if (arg[0] == '\0') {
+        printf("us sched %s %s %s med %u/%u/%u  trk v %d/%d/%d cm/s conf %u/%u/%u  rate L=%u R=%u C=%u /s  xt_reject L=%lu R=%lu C=%lu  noecho L=%lu R=%lu C=%lu  ts_alias L=%lu R=%lu C=%lu  slot avg %lu.%lu ms\r\n",
+               policy->name, gap_adapt ? "adapt" : "fixed", temp_str(),
+               med_win_req[US_LEFT], med_win_req[US_RIGHT], med_win_req[US_CENTER],
+               trk_rate(US_LEFT), trk_rate(US_RIGHT), trk_rate(US_CENTER),
+               trk[US_LEFT].conf, trk[US_RIGHT].conf, trk[US_CENTER].conf,
+               rate_hz[US_LEFT], rate_hz[US_RIGHT], rate_hz[US_CENTER],
+               (unsigned long)xt_reject[US_LEFT], (unsigned long)xt_reject[US_RIGHT],
+               (unsigned long)xt_reject[US_CENTER],
+               (unsigned long)noecho_cnt[US_LEFT], (unsigned long)noecho_cnt[US_RIGHT], (unsigned long)noecho_cnt[US_CENTER],
+               (unsigned long)ts_alias[US_LEFT], (unsigned long)ts_alias[US_RIGHT], (unsigned long)ts_alias[US_CENTER],
+               (unsigned long)(gap_n ? gap_sum_ms / gap_n : 0u),
+               (unsigned long)(gap_n ? (gap_sum_ms * 10u / gap_n) % 10u : 0u));
+    }
+    else if (!strcmp(arg, "adapt")) { US_SetAdaptiveGap(true);  printf("OK us adapt\r\n"); }
+    else if (!strcmp(arg, "fixed")) { US_SetAdaptiveGap(false); printf("OK us fixed\r\n"); }
+    else if (US_PolicyFind(arg) >= 0) { US_SetSchedule((us_sched_t)US_PolicyFind(arg)); printf("OK us %s\r\n", arg); }
+    else if (!strncmp(arg, "med=", 4)) {
+        uint8_t w[3] = {0};
+        const char *p = arg + 4;
+        char *end;
+        bool ok = true;
+        for (uint8_t i = 0; i < US_NUM && ok; ++i) {
+            const unsigned long v = strtoul(p, &end, 10);
+            ok = (end != p) && (v <= US_MED_WIN_MAX) && (*end == ((i + 1u < US_NUM) ? '/' : '\0'));
+            w[i] = (uint8_t)v;
+            p = end + 1;
+        }
+        if (ok && US_SetMedianWin(w)) printf("OK us med=%u/%u/%u\r\n", w[0], w[1], w[2]);
+        else                          printf("ERR us med=L/R/C (1..%u)\r\n", US_MED_WIN_MAX);
+    }
+    else if (!strncmp(arg, "temp=", 5)) {
+        // 기온 [°C], 소수 한 자리까지 (23 / 23.5 / -5.0)
+        const char *p = arg + 5;
+        char *end;
+        const bool neg = (*p == '-');
+        long dc = strtol(p, &end, 10) * 10;
+        bool ok = (end != p);
+        if (ok && *end == '.' && end[1] >= '0' && end[1] <= '9') { dc += neg ? -(end[1] - '0') : (end[1] - '0'); end += 2; }
+        ok = ok && (*end == '\0') && dc >= US_TEMP_DC_MIN && dc <= US_TEMP_DC_MAX && US_RangeSetTemp((int16_t)dc);
+        if (ok) printf("OK us %s\r\n", temp_str());
+        else    printf("ERR us temp=C (%d..%d)\r\n", US_TEMP_DC_MIN / 10, US_TEMP_DC_MAX / 10);
+    }
+    else                            printf("ERR us [seq|pair|risk|adapt|fixed|med=L/R/C|temp=C]\r\n");
+}
+
 // (옵션) Center 신선도 — automode에서 급결정 시 사용 가능
 bool US_Center_isFresh(void) { return c_valid_streak >= 2; }
@@ -0,0 +1,76 @@
+/*
+ * us_median.c — 초음파 슬라이딩 미디언
+ */
+
+#include "us_median.h"
+#include <stddef.h>
+
+// cm 보다 큰 첫 위치 (같은 거리 뒤에 넣어서 도착 순서 유지)
+static uint8_t upper_bound(const us_med_sample_t *a, uint8_t n, uint16_t cm)
+{
+  uint8_t lo = 0u, hi = n;
+  while (lo < hi) {
+    const uint8_t mid = (uint8_t)((lo + hi) / 2u);
+    if (a[mid].cm <= cm) lo = (uint8_t)(mid + 1u); else hi = mid;
+  }
+  return lo;
+}
+
+// old 와 같은 샘플의 위치 — 같은 거리 구간을 이진 탐색으로 찾고 그 안에서 타임스탬프로
+static uint8_t find_sample(const us_med_sample_t *a, uint8_t n, us_med_sample_t old)
+{
+  uint8_t lo = 0u, hi = n;
+  while (lo < hi) {
+    const uint8_t mid = (uint8_t)((lo + hi) / 2u);
+    if (a[mid].cm < old.cm) lo = (uint8_t)(mid + 1u); else hi = mid;
+  }
+  for (uint8_t k = lo; k < n && a[k].cm == old.cm; ++k) {
+    if (a[k].ts_us == old.ts_us) return k;
+  }
+  return lo;   // 같은 (거리, 시각) 이 여럿이면 어느 것을 빼도 같음
+}
+
+void US_MedInit(us_median_t *m, uint8_t win, uint16_t cm, uint32_t ts_us)
+{
+  if (win < 1u) win = 1u;
+  if (win > US_MED_WIN_MAX) win = US_MED_WIN_MAX;
+  m->win  = win;
+  m->wpos = 0u;
+  for (uint8_t k = 0; k < win; ++k) {
+    m->ring[k]   = (us_med_sample_t){ cm, ts_us };
+    m->sorted[k] = m->ring[k];
+  }
+}
+
+uint16_t US_MedPush(us_median_t *m, uint16_t cm, uint32_t ts_us, uint32_t *ts_out)
+{
+  us_med_sample_t *a = m->sorted;
+  const uint8_t n = m->win;
+  const us_med_sample_t in = { cm, ts_us };
+
+  // 가장 오래된 샘플 자리 r 에서 새 샘플 자리 p 까지만 한 칸씩 밀기
+  const uint8_t r = find_sample(a, n, m->ring[m->wpos]);
+  const uint8_t p = upper_bound(a, n, cm);
+  uint8_t k = r;
+  if (p > r) {
+    for (; k + 1u < p; ++k) a[k] = a[k + 1u];
+  } else {
+    for (; k > p; --k) a[k] = a[k - 1u];
+  }
+  a[k] = in;
+  m->ring[m->wpos] = in;
+  m->wpos = (uint8_t)((m->wpos + 1u) % n);
+
+  // 중앙값과 같은 거리가 여럿이면 가장 최근 샘플 시각 (값이 그대로인 동안 나이가 창 길이만큼 늙지 않게)
+  const uint8_t mid = (uint8_t)(n / 2u);
+  const uint16_t med = a[mid].cm;
+  uint32_t t = a[mid].ts_us;
+  for (uint8_t j = mid; j > 0u && a[j - 1u].cm == med; --j) {
+    if ((int32_t)(a[j - 1u].ts_us - t) > 0) t = a[j - 1u].ts_us;
+  }
+  for (uint8_t j = (uint8_t)(mid + 1u); j < n && a[j].cm == med; ++j) {
+    if ((int32_t)(a[j].ts_us - t) > 0) t = a[j].ts_us;
+  }
+  if (ts_out != NULL) *ts_out = t;
+  return med;
+}
@@ -0,0 +1,21 @@
+/*
+ * us_range.c — 에코 → 거리 변환 계수 (기온 보정)
+ */
+
+#include "us_range.h"
+
+// 음속 [0.1mm/s] = 3313000 + 606 x T[0.1°C]  →  mm/us x 65536 = 음속 x 65536 / (2 x 10^7)
+#define MM_Q16(t)  ((uint32_t)(((3313000LL + 606LL * (t)) * 65536LL + 10000000LL) / 20000000LL))
+
+volatile uint32_t us_mm_q16 = MM_Q16(US_TEMP_DC);   // 20°C 11253
+static int16_t    temp_dc = US_TEMP_DC;
+
+bool US_RangeSetTemp(int16_t t)
+{
+  if (t < US_TEMP_DC_MIN || t > US_TEMP_DC_MAX) return false;
+  temp_dc = t;
+  us_mm_q16 = MM_Q16(t);
+  return true;
+}
+
+int16_t US_RangeGetTemp(void) { return temp_dc; }
@@ -0,0 +1,108 @@
+/*
+ * us_sched.c — 초음파 트리거 슬롯 정책
+ */
+
+#include "us_sched.h"
+#include "param.h"
+#include <string.h>
+
+// ===== seq: L-C-R-C 한 개씩 (기존 순서) =====
+static const uint8_t SLOTS_SEQ[] = { US_SLOT_L, US_SLOT_C, US_SLOT_R, US_SLOT_C };
+
+static const us_policy_t POLICY_SEQ = {
+  .name = "seq", .slots = SLOTS_SEQ, .n = sizeof(SLOTS_SEQ),
+};
+
+// ===== pair: L/R 은 서로 반대쪽을 보므로 같이 쏘고, C 는 그 사이에 혼자 =====
+static const uint8_t SLOTS_PAIR[] = { US_SLOT_L | US_SLOT_R, US_SLOT_C };
+
+static const us_policy_t POLICY_PAIR = {
+  .name = "pair", .slots = SLOTS_PAIR, .n = sizeof(SLOTS_PAIR),
+  .close_ms = 12u, .crosstalk = true,
+};
+
+// ===== risk: 속도/C 접근 속도/주행 상태로 센서별 가중치 → 가중 라운드로빈 =====
+//  매 슬롯 credit[i] += w[i], 가장 많이 쌓인 센서를 쏘고 Σw 만큼 뺌 → 장기 비율 = w 비율
+//  w 기본 L1 R1 C2 (seq 와 같은 비율)
+//   - 직진 속도: 좌우 CCR 평균이 SPEED_MIN → SPEED_MAX 로 갈수록 C +0..4
+//   - 앞벽 접근 (C 추적 속도 ≤ RISK_VC_CLOSE [cm/s]): C +2
+//   - ARC 회전: 출구 판단이 바깥쪽 옆벽 + C 라서 바깥쪽 +3, 안쪽 +1
+//   - PIVOT: 끝나고 방향 투표(R>L)에 좌우 둘 다 필요 → 좌우 +2
+//   - 옆벽이 RISK_NEAR_CM 안쪽이면 그쪽 +1
+//  RISK_STALE_MS 넘게 못 쏜 센서는 가중치와 상관없이 먼저 — seq 의 좌우 간격(4슬롯 = 160ms)보다 묵지 않게
+#define RISK_STALE_MS   160u
+#define RISK_VC_CLOSE  -110
+#define RISK_NEAR_CM     30u
+#define RISK_SPEED_W      4u
+
+static int16_t s_credit[3];
+
+static void risk_reset(void)
+{
+  memset(s_credit, 0, sizeof s_credit);
+}
+
+static uint8_t risk_weights(const us_view_t *v, uint8_t w[3])
+{
+  enum { L = 0, R = 1, C = 2 };
+  w[L] = 1u; w[R] = 1u; w[C] = 2u;
+
+  if (v->drive == US_DRV_STRAIGHT) {
+    const int32_t lo = PARAM(SPEED_MIN), hi = PARAM(SPEED_MAX);
+    const int32_t ccr = ((int32_t)v->ccr_l + v->ccr_r) / 2;
+    if (hi > lo && ccr > lo) {
+      const int32_t k = (ccr >= hi) ? (int32_t)RISK_SPEED_W : (ccr - lo) * (int32_t)RISK_SPEED_W / (hi - lo);
+      w[C] = (uint8_t)(w[C] + k);
+    }
+    if (v->vC <= RISK_VC_CLOSE) w[C] += 2u;
+  }
+  else if (v->drive == US_DRV_ARC) {
+    const uint8_t outer = (v->dir > 0) ? L : R;   // 우회전이면 바깥 = 왼쪽
+    w[outer]     += 3u;
+    w[outer ^ 1] += 1u;
+  }
+  else {
+    w[L] += 2u; w[R] += 2u;
+  }
+
+  if (v->cm[L] < RISK_NEAR_CM) w[L]++;
+  if (v->cm[R] < RISK_NEAR_CM) w[R]++;
+  return (uint8_t)(w[L] + w[R] + w[C]);
+}
+
+static uint8_t risk_next(const us_view_t *v)
+{
+  uint8_t best = 0u;
+  uint32_t oldest = 0u;
+  for (uint8_t i = 0; i < 3u; ++i) {
+    if (v->age_ms[i] >= RISK_STALE_MS && v->age_ms[i] > oldest) { oldest = v->age_ms[i]; best = i; }
+  }
+
+  uint8_t w[3];
+  const uint8_t sum = risk_weights(v, w);
+  for (uint8_t i = 0; i < 3u; ++i) s_credit[i] = (int16_t)(s_credit[i] + w[i]);
+
+  if (oldest == 0u) {
+    for (uint8_t i = 1; i < 3u; ++i) if (s_credit[i] > s_credit[best]) best = i;
+  }
+  s_credit[best] = (int16_t)(s_credit[best] - sum);
+  // 묵은 센서를 먼저 쏘느라 빚이 너무 쌓이지 않게
+  if (s_credit[best] < -(int16_t)(2u * sum)) s_credit[best] = -(int16_t)(2u * sum);
+  return (uint8_t)(1u << best);
+}
+
+static const us_policy_t POLICY_RISK = {
+  .name = "risk", .reset = risk_reset, .next = risk_next,
+};
+
+const us_policy_t *const US_POLICY[US_SCHED_NUM] = {
+  [US_SCHED_SEQ]  = &POLICY_SEQ,
+  [US_SCHED_PAIR] = &POLICY_PAIR,
+  [US_SCHED_RISK] = &POLICY_RISK,
+};
+
+int US_PolicyFind(const char *name)
+{
+  for (int i = 0; i < (int)US_SCHED_NUM; ++i) if (!strcmp(US_POLICY[i]->name, name)) return i;
+  return -1;
+}
@@ -0,0 +1,72 @@
+/*
+ * us_track.c — 초음파 거리/속도 알파-베타 추적
+ */
+
+#include "us_track.h"
+
+#define TRK_ALPHA         0.5f
+#define TRK_BETA          0.167f    // α²/(2-α) — 임계 감쇠 (계단 입력에 넘치지 않음)
+#define TRK_GATE_CM       8.0f      // 게이트 기본 반폭
+#define TRK_GATE_CMS    150.0f      // 예측 밖 속도 변화 여유 → 게이트 += 이것 x dt
+#define TRK_DT_MIN_US    1000u
+#define TRK_STALE_US   500000u      // 이보다 오래 샘플이 없었으면 새로 시작
+#define TRK_CONF_START   25u
+#define TRK_WOBBLE_CM     1.0f
+#define TRK_V_MAX       300.0f      // 두 점 속도 상한 (차 최고 속도의 1.5배쯤)
+
+static inline float absf(float a) { return (a < 0.0f) ? -a : a; }
+
+void US_TrkReset(us_track_t *t)
+{
+  *t = (us_track_t){ 0 };
+}
+
+// 새로 시작 — 연속 이상치 끝이면 첫 이상치와 두 점으로 속도
+static void restart(us_track_t *t, float cm, uint32_t ts_us)
+{
+  const uint32_t dt = ts_us - t->held_ts;
+  t->v = (t->miss >= US_TRK_MAX_MISS && dt >= TRK_DT_MIN_US && dt < TRK_STALE_US)
+       ? (cm - t->held_cm) * 1e6f / (float)dt : 0.0f;
+  if (t->v >  TRK_V_MAX) t->v =  TRK_V_MAX;
+  if (t->v < -TRK_V_MAX) t->v = -TRK_V_MAX;
+  t->x      = cm;
+  t->ts_us  = ts_us;
+  t->r_prev = 0.0f;
+  t->conf   = TRK_CONF_START;
+  t->miss   = 0u;
+  t->init   = true;
+  t->wobble = false;
+}
+
+bool US_TrkUpdate(us_track_t *t, float cm, uint32_t ts_us)
+{
+  const uint32_t dt_us = ts_us - t->ts_us;
+  if (!t->init || dt_us >= TRK_STALE_US) {
+    t->miss = 0u;
+    restart(t, cm, ts_us);
+    return true;
+  }
+  if (dt_us < TRK_DT_MIN_US) return true;   // 같은 샘플을 두 번 받음
+
+  const float dt   = (float)dt_us * 1e-6f;
+  const float r    = cm - (t->x + t->v * dt);
+  const float gate = TRK_GATE_CM + TRK_GATE_CMS * dt;
+
+  if (absf(r) > gate) {
+    t->conf = (uint8_t)(t->conf / 2u);
+    if (t->miss == 0u) { t->held_cm = cm; t->held_ts = ts_us; }
+    if (++t->miss >= US_TRK_MAX_MISS) restart(t, cm, ts_us);
+    return false;
+  }
+
+  t->x += t->v * dt + TRK_ALPHA * r;
+  t->v += (TRK_BETA / dt) * r;
+  t->ts_us  = ts_us;
+  t->miss   = 0u;
+  t->wobble = (r * t->r_prev < 0.0f) && absf(r) >= TRK_WOBBLE_CM && absf(t->r_prev) >= TRK_WOBBLE_CM;
+  t->r_prev = r;
+
+  const float good = 100.0f * (1.0f - absf(r) / gate);
+  t->conf = (uint8_t)((float)t->conf + (good - (float)t->conf) * 0.25f);
+  return true;
+}
@@ -0,0 +1,22 @@
+/*
+ * cmsis_os2.h — Host(Linux)용 CMSIS-RTOS2 대역 (펌웨어가 쓰는 스레드 플래그만)
+ *
+ *  - osThreadId_t 는 sim_task.c 의 SimTask_t
+ *  - osThreadFlagsSet (ISR 에서) → 플래그 세우고 SimHal_Wake → 스케줄러가 그 시각에 태스크 실행
+ *  - 대기(osThreadFlagsWait)는 태스크 루프 쪽이라 SimTask_t.wait_ms 로 재현
+ */
+
+#ifndef CMSIS_OS2_H_
+#define CMSIS_OS2_H_
+
+#include <stdint.h>
+
+typedef void *osThreadId_t;
+
+#define osWaitForever    0xFFFFFFFFU
+#define osFlagsWaitAny   0x00000000U
+
+osThreadId_t osThreadGetId(void);
+uint32_t     osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags);
+
+#endif /* CMSIS_OS2_H_ */
@@ -0,0 +1,35 @@
+/*
+ * rec_log.h — 주행 기록(recorder.h 형식) 파일 읽기
+ *
+ *  - USART2 로 받은 바이트 그대로 (printf 텍스트가 섞여 있어도 됨)
+ *  - sync + version + CRC 가 맞는 레코드만 인정 (v3 36B, v1/v2 32B), 아니면 1바이트씩 밀어서 재동기
+ *  - 예전 버전은 rec_t 로 풀어서 돌려줌 — 없는 필드는 0, 해당 READY 플래그 꺼짐 (replay 에서 "신뢰도 없음")
+ */
+
+#ifndef INC_REC_LOG_H_
+#define INC_REC_LOG_H_
+
+#include "recorder.h"
+#include <stdio.h>
+
+typedef struct {
+  FILE    *f;
+  uint8_t  buf[64 * 1024];
+  uint32_t len, pos;
+
+  // 통계
+  uint32_t records;
+  uint32_t skipped;        // 재동기로 버린 바이트
+  uint32_t seq_gaps;       // seq 가 건너뛴 횟수 (드롭)
+  uint32_t seq_lost;       // 건너뛴 레코드 수
+  bool     have_seq;
+  uint16_t last_seq;
+  uint8_t  version;        // 마지막 레코드의 형식 버전 / 크기 [B]
+  uint8_t  size;
+} RecReader_t;
+
+bool RecReader_Open(RecReader_t *rd, const char *path);
+bool RecReader_Next(RecReader_t *rd, rec_t *out);     // 끝이면 false
+void RecReader_Close(RecReader_t *rd);
+
+#endif /* INC_REC_LOG_H_ */
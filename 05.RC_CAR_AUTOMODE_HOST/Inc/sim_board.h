@@ -0,0 +1,82 @@
+/*
+ * sim_board.h — 보드 배선 + freertos.c 태스크 구성 (호스트용)
+ *
+ *  - 초음파: TRIG(PC8/PC5/PC6) → TIM4 CH2/CH1/CH3 (ultrasonic.h / ultrasonic.c 와 동일)
+ *  - 모터: IN1/IN2(우), IN3/IN4(좌) (move.h), PWM TIM3 CCR1(우)/CCR2(좌) (speed.c)
+ *  - 태스크: sonic(US_Update, 10ms) → autocontrol(AutoMode_Update, 5ms)
+ *    변형(05.RC_CAR_AUTOMODE_TEST/AUTOMODEnn)은 초기화/주기가 달라서 sim_variant.h 로 맞춤
+ */
+
+#ifndef INC_SIM_BOARD_H_
+#define INC_SIM_BOARD_H_
+
+#include "sim_hal.h"
+#include "sim_sonar.h"
+#include "sim_task.h"
+
+#include <stdio.h>
+
+// ultrasonic.c 의 us_idx_t 와 같은 순서
+enum { SIM_US_LEFT = 0, SIM_US_RIGHT = 1, SIM_US_CENTER = 2, SIM_US_NUM = 3 };
+
+// 모터 출력으로 본 주행 상태 (변형마다 내부 상태 변수가 달라서 출력 기준으로 분류)
+typedef enum {
+  SIM_DRIVE_STRAIGHT = 0,   // 양쪽 전진, 듀티 차 < SIM_DRIVE_ARC_DIFF
+  SIM_DRIVE_ARC,            // 양쪽 전진, 듀티 차 있음
+  SIM_DRIVE_PIVOT,          // 한쪽 후진/정지 + 다른쪽 구동
+  SIM_DRIVE_REVERSE,
+  SIM_DRIVE_STOP,
+  SIM_DRIVE_NUM
+} SimDrive_t;
+
+#define SIM_DRIVE_ARC_DIFF  30u
+#define SIM_PARAM_MAX       32u   // SimBoard_SetParams 한 번에 넘길 수 있는 개수
+#define SIM_FSM_MAX          8u   // fsm.h FSM_STATE_MAX
+
+typedef struct {
+  uint32_t updates;            // AutoMode_Update 호출 수
+  uint64_t cycles;             // 누적 호스트 사이클 (x86 TSC, 그 외 ns)
+  uint64_t cycles_max;
+  uint32_t sonic_runs;         // sonic 태스크 본문 실행 수 (깨어난 횟수)
+} SimBoardStats_t;
+
+void    SimBoard_Init(SimRangeFn range_fn, void *ctx);
+void    SimBoard_Run(uint32_t until_ms, SimTickFn tick_fn, void *ctx);
+
+// 바퀴 방향: +1 전진, -1 후진, 0 정지(양쪽 Low/High)
+int8_t  SimBoard_RightDir(void);
+int8_t  SimBoard_LeftDir(void);
+SimDrive_t  SimBoard_Drive(void);
+const char *SimBoard_DriveName(SimDrive_t d);
+
+// 펌웨어 필터 출력 (변형별 getter 차이는 sim_variant.h 가 흡수)
+void    SimBoard_ReadCm(uint16_t cm[SIM_US_NUM]);
+
+const SimBoardStats_t *SimBoard_Stats(void);
+
+// 튜닝 파라미터 덮어쓰기 ("NAME=VAL" n개, SimBoard_Init 이후)
+//  - 상호조건(SPEED_MIN ≤ BASE ≤ MAX 등) 때문에 순서가 안 맞으면 통과할 때까지 반복 적용
+//  - param.c 가 없는 변형이거나 이름/범위가 틀리면 stderr 에 출력하고 false
+bool    SimBoard_SetParams(const char *const *kv, int n);
+
+// 주행 기록(recorder.c) 실시간 송출을 f 로 받음 (rec on 과 같음, SimBoard_Init 이후)
+//  - USART2 가 보내는 바이트를 그대로 씀 → rec_decode 로 CSV
+//  - NULL 이면 끔, recorder.c 가 없는 변형이면 false
+bool    SimBoard_Record(FILE *f);
+
+// 초음파 트리거 슬롯 순서 ("seq" / "pair", SimBoard_Init 이후 — sonic 태스크 시작 시 반영)
+//  - 슬롯 선택이 없는 변형이거나 이름이 틀리면 stderr 에 출력하고 false
+bool    SimBoard_Schedule(const char *name);
+void    SimBoard_SonarStatus(void);   // 콘솔 "us" 출력 (없는 변형은 아무것도 안 함)
+
+// 필터 출력 [L,R,C] 이 된 샘플의 나이 [us] (타임스탬프가 없는 변형은 false)
+bool    SimBoard_ReadAge(uint32_t age_us[SIM_US_NUM]);
+
+// 마지막으로 받아들인 원시 거리 [mm] (기온 보정 변환이 없는 변형은 false)
+bool    SimBoard_ReadMm(uint16_t mm[SIM_US_NUM]);
+
+// automode 상태기계(fsm.c) 상태별 누적 시간 [ms] + 상태 이름, *trans = 전이 수
+//  반환 = 상태 수, 상태기계가 없는 변형은 0
+uint8_t SimBoard_FsmDwell(uint32_t ms[SIM_FSM_MAX], const char *name[SIM_FSM_MAX], uint32_t *trans);
+
+#endif /* INC_SIM_BOARD_H_ */
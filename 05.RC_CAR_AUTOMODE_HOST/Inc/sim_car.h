@@ -0,0 +1,59 @@
+/*
+ * sim_car.h — 차동구동 섀시 + HC-SR04 빔 모델 + 주행 통계
+ *
+ *  - 입력: TIM3 CCR1(우)/CCR2(좌) 듀티, IN1~IN4 방향 (move.c 가 쓰는 그대로)
+ *  - 센서: 장착 위치/각도에서 콘(±cone_half) 안으로 광선 여러 개,
+ *          입사각이 max_incidence 이내인 반사 중 최단 거리 = 에코
+ *  - 충돌: 차체를 반지름 radius 원으로 보고 벽 관통 시 벽면을 따라 미끄러짐 + 접촉 카운트
+ */
+
+#ifndef INC_SIM_CAR_H_
+#define INC_SIM_CAR_H_
+
+#include "sim_track.h"
+#include "sim_board.h"
+
+#define SIM_CAR_MAX_LAPS    16u
+#define SIM_CAR_CONE_RAYS    7u
+
+typedef struct {
+  float vmax_cms;            // 듀티 100% 바퀴 속도
+  float dead_duty;           // 이 듀티 이하는 정지 (기동 토크 부족)
+  float tau_s;               // 모터 1차 지연
+  float track_cm;            // 유효 트레드 (스키드 손실 포함)
+  float radius_cm;           // 충돌 원
+  float cone_half_deg;       // 빔 반각
+  float max_incidence_deg;   // 이보다 비스듬한 면은 반사가 안 돌아옴
+  float max_range_cm;
+} SimCarParams_t;
+
+typedef struct {
+  const SimTrack_t *trk;
+  SimCarParams_t    p;
+  SimMount_t        mount[SIM_US_NUM];
+
+  SimVec_t pos;
+  float    heading;          // rad, +x 기준 반시계
+  float    v_left, v_right;  // cm/s
+  uint32_t last_ms;
+
+  // 통계
+  float    min_clear_cm;     // 차체 외곽 ~ 벽 최소 거리
+  uint32_t contacts;         // 벽 접촉 횟수 (연속 접촉은 1회)
+  uint32_t contact_ms;
+  bool     in_contact;
+  float    dist_cm;
+  uint8_t  gate_next;
+  uint8_t  laps;
+  uint32_t lap_start_ms;
+  uint32_t lap_ms[SIM_CAR_MAX_LAPS];
+} SimCar_t;
+
+void  SimCar_DefaultParams(SimCarParams_t *p);
+void  SimCar_Init(SimCar_t *car, const SimTrack_t *trk, const SimCarParams_t *p);
+void  SimCar_Step(SimCar_t *car, uint32_t now_ms);
+
+// SimRangeFn 호환 (ctx = SimCar_t*)
+float SimCar_Range(uint8_t idx, uint64_t t_us, void *ctx);
+
+#endif /* INC_SIM_CAR_H_ */
@@ -0,0 +1,63 @@
+/*
+ * sim_hal.h — HAL 대역의 하네스 쪽 API (가상 클럭 / 이벤트 / 핀 감시)
+ *
+ *  - 가상 클럭은 µs 단위 64bit, 실제 시간과 무관하게 필요한 만큼만 전진
+ *  - 예약된 이벤트(에코 엣지 등)는 AdvanceTo 에서 시간순으로 디스패치
+ *  - 펌웨어의 busy-wait(delay_us)는 카운터를 읽을 때마다 1µs 씩 진행
+ */
+
+#ifndef INC_SIM_HAL_H_
+#define INC_SIM_HAL_H_
+
+#include "stm32f4xx_hal.h"
+#include <stdbool.h>
+
+#define SIM_MAX_EVENTS     32u
+#define SIM_MAX_WATCHES     8u
+
+typedef void (*SimEventFn)(uint64_t t_us, void *ctx);
+typedef void (*SimUartSinkFn)(const uint8_t *data, uint16_t len, void *ctx);
+typedef void (*SimPinFn)(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state, uint64_t t_us, void *ctx);
+
+extern TIM_HandleTypeDef htim1;
+extern TIM_HandleTypeDef htim3;
+extern TIM_HandleTypeDef htim4;
+extern TIM_HandleTypeDef htim11;
+extern UART_HandleTypeDef huart1;
+extern UART_HandleTypeDef huart2;
+
+// 전체 초기화 (main.c 의 MX_*_Init + *_Start 이후 상태를 재현)
+void     SimHal_Reset(void);
+
+// 가상 클럭
+uint64_t SimHal_Micros(void);
+void     SimHal_AdvanceTo(uint64_t t_us);
+void     SimHal_Spend(uint32_t us);          // 코드 실행 시간 소모(이벤트 디스패치 포함)
+void     SimHal_SpendCycles(uint32_t cyc);   // HCLK 사이클 단위 (1µs 미만은 누적)
+// AdvanceTo 와 같지만 이벤트 안에서 SimHal_Wake 가 불리면 그 시각에 멈추고 false (태스크 알림)
+bool     SimHal_AdvanceToWake(uint64_t t_us);
+void     SimHal_Wake(void);
+
+// 이벤트 예약 (가득 차면 false)
+bool     SimHal_Schedule(uint64_t t_us, SimEventFn fn, void *ctx);
+
+// GPIO 출력 감시 (TRIG 핀, IN1~IN4 등)
+bool     SimHal_WatchPin(GPIO_TypeDef *port, uint16_t pin, SimPinFn fn, void *ctx);
+
+// 입력캡처 핀 레벨 구동 (TIM4 CHx 에 연결된 ECHO 라인)
+void     SimHal_SetCaptureInput(TIM_HandleTypeDef *htim, uint32_t channel, GPIO_PinState level);
+
+// 모터 출력 관측
+uint32_t SimHal_PwmRight(void);   // TIM3 CCR1
+uint32_t SimHal_PwmLeft(void);    // TIM3 CCR2
+uint32_t SimHal_PwmPeriod(void);  // TIM3 ARR
+uint32_t SimHal_Tim4Irq(void);    // TIM4 인터럽트 진입 수 (캡처/업데이트/CC4)
+uint32_t SimHal_DmaIrq(void);     // 캡처 DMA 인터럽트 진입 수 (하프/완료)
+
+// UART 출력 끄기/켜기 (배치 실행 시 소음 제거)
+void     SimHal_SetUartEcho(bool on);
+
+// UART 송신 바이트 받기 (HAL_UART_Transmit + DMA 완료분, SimHal_Reset 이 해제)
+void     SimHal_SetUartSink(UART_HandleTypeDef *huart, SimUartSinkFn fn, void *ctx);
+
+#endif /* INC_SIM_HAL_H_ */
@@ -0,0 +1,37 @@
+/*
+ * sim_sonar.h — HC-SR04 타이밍 모델 (TRIG 감시 → ECHO 엣지를 TIM 입력캡처로)
+ */
+
+#ifndef INC_SIM_SONAR_H_
+#define INC_SIM_SONAR_H_
+
+#include "sim_hal.h"
+
+#define SIM_SONAR_MAX          8u
+#define SIM_SONAR_TRIG_MIN_US 10u      // 이보다 짧은 TRIG 펄스는 무시
+#define SIM_SONAR_BURST_US   460u      // TRIG 하강 → ECHO 상승 (40kHz x8 버스트 + 내부 지연)
+#define SIM_SONAR_NOECHO_US 38000u     // 미검출 시 ECHO High 유지 시간
+#define SIM_SONAR_DEAD_CM   (-2.0f)    // 거리 공급자가 이하를 주면 모듈 무응답 (ECHO 가 아예 안 올라감)
+
+// 거리 공급자: 센서 idx 의 현재 거리[cm], 음수 = 에코 없음, SIM_SONAR_DEAD_CM 이하 = 무응답
+typedef float (*SimRangeFn)(uint8_t idx, uint64_t t_us, void *ctx);
+
+typedef struct {
+  GPIO_TypeDef      *trig_port;
+  uint16_t           trig_pin;
+  TIM_HandleTypeDef *htim;
+  uint32_t           channel;
+} SimSonarWiring_t;
+
+void     SimSonar_Init(SimRangeFn fn, void *ctx);
+bool     SimSonar_Attach(uint8_t idx, const SimSonarWiring_t *w);
+void     SimSonar_SetSoundSpeed(float m_per_s);
+// 동시 발사 crosstalk: 같이 쏜 센서의 더 짧은 에코가 확률 prob 로 대신 들어옴 (0 = 끔, 결정적 난수)
+void     SimSonar_SetCrosstalk(float prob, uint32_t seed);
+
+uint32_t SimSonar_Shots(uint8_t idx);      // 유효 트리거 수
+uint32_t SimSonar_Ignored(uint8_t idx);    // 짧은 펄스/측정 중 재트리거로 무시된 수
+uint32_t SimSonar_Crosstalk(uint8_t idx);  // 옆 센서 에코로 바뀐 샷 수
+bool     SimSonar_TrigWidth(uint8_t idx, uint32_t *min_us, uint32_t *max_us);   // TRIG High 폭 최소/최대 (펄스 없으면 false)
+
+#endif /* INC_SIM_SONAR_H_ */
@@ -0,0 +1,29 @@
+/*
+ * sim_task.h — freertos.c 태스크 구성을 1ms 틱 단위로 재현하는 협조형 스케줄러
+ */
+
+#ifndef INC_SIM_TASK_H_
+#define INC_SIM_TASK_H_
+
+#include "sim_hal.h"
+
+typedef struct {
+  const char *name;
+  void      (*init)(void);     // for(;;) 진입 전 1회 (NULL 허용)
+  void      (*step)(void);     // 루프 본문
+  uint32_t    delay_ms;        // 본문 뒤 osDelay(n)
+  uint32_t    next_ms;         // 내부용
+  uint32_t  (*wait_ms)(void);  // 있으면 osDelay 대신 osThreadFlagsWait(…, wait_ms()) — 플래그 오면 바로 깨어남
+  uint32_t    flags;           // osThreadFlagsSet 로 세운 플래그 (내부용)
+  uint32_t    runs;            // 본문 실행 수 (내부용, 깨어난 횟수)
+} SimTask_t;
+
+// 매 1ms 틱마다 태스크보다 먼저 불림 (물리/센서 모델 갱신용, NULL 허용)
+typedef void (*SimTickFn)(uint32_t now_ms, void *ctx);
+
+void SimTask_Start(SimTask_t *tasks, uint8_t num);
+// until_ms 까지 진행 (SimTask_Stop 으로 조기 종료)
+void SimTask_RunUntil(SimTask_t *tasks, uint8_t num, uint32_t until_ms, SimTickFn tick_fn, void *ctx);
+void SimTask_Stop(void);
+
+#endif /* INC_SIM_TASK_H_ */
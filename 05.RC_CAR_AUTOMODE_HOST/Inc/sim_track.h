@@ -0,0 +1,50 @@
+/*
+ * sim_track.h — 2D 트랙(폴리라인 벽) + 초음파 빔 레이캐스트
+ *
+ *  트랙 파일 (단위 cm / deg, '#' 주석)
+ *    wall   x0 y0 x1 y1 ... xn yn      폴리라인 벽 (닫으려면 첫 점 반복)
+ *    start  x y heading               출발 위치/방향 (heading: +x 기준 반시계)
+ *    gate   x0 y0 x1 y1               랩 게이트 (파일 순서대로 통과, 마지막 = 랩 라인)
+ *    sensor idx x y angle             센서 장착 변경 (차체 기준, 기본값은 sim_car.c)
+ */
+
+#ifndef INC_SIM_TRACK_H_
+#define INC_SIM_TRACK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SIM_TRACK_MAX_SEGS    512u
+#define SIM_TRACK_MAX_GATES    16u
+#define SIM_TRACK_MAX_SENSORS   8u
+
+typedef struct { float x, y; } SimVec_t;
+typedef struct { SimVec_t a, b; } SimSeg_t;
+
+typedef struct { bool set; float x, y, angle_deg; } SimMount_t;
+
+typedef struct {
+  char       name[64];
+  SimSeg_t   wall[SIM_TRACK_MAX_SEGS];
+  uint16_t   wall_num;
+  SimSeg_t   gate[SIM_TRACK_MAX_GATES];
+  uint8_t    gate_num;
+  SimVec_t   start;
+  float      start_heading_deg;
+  SimMount_t mount[SIM_TRACK_MAX_SENSORS];
+} SimTrack_t;
+
+bool  SimTrack_Load(SimTrack_t *trk, const char *path);
+
+// 원점 o, 단위벡터 d 방향 광선의 최근접 벽까지 거리 (없으면 <0)
+// cos_inc: 벽 법선과 광선이 이루는 각의 cos (|·|, 1 = 수직 입사)
+float SimTrack_Ray(const SimTrack_t *trk, SimVec_t o, SimVec_t d, float max_cm, float *cos_inc);
+
+// 점 p 에서 가장 가까운 벽까지 거리
+// away: (NULL 가능) 그 벽에서 p 쪽으로 향하는 단위벡터
+float SimTrack_Clearance(const SimTrack_t *trk, SimVec_t p, SimVec_t *away);
+
+// p0→p1 이동이 게이트 g 를 가로질렀는가
+bool  SimTrack_Crossed(const SimTrack_t *trk, uint8_t g, SimVec_t p0, SimVec_t p1);
+
+#endif /* INC_SIM_TRACK_H_ */
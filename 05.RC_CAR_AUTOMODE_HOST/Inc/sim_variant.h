@@ -0,0 +1,115 @@
+/*
+ * sim_variant.h — 펌웨어 트리별 태스크 진입점/주기 (각 트리의 freertos.c 그대로)
+ *
+ *  make VARIANT=n  →  -DSIM_VARIANT=n  (05.RC_CAR_AUTOMODE_TEST/AUTOMODE0n)
+ *  미지정            →  05.RC_CAR_AUTOMODE (AUTOMODE10~13 과 같은 형태)
+ *
+ *  SIM_US_INIT()      ultrasonic 태스크 진입 시 1회
+ *  SIM_AUTO_INIT()    automode 태스크 진입 시 1회
+ *  SIM_US_MS / SIM_AUTO_MS   osDelay 주기
+ *  SIM_US_WAIT        있으면 sonic 태스크가 osDelay 대신 플래그 대기 (대기 상한 ms 를 돌려주는 함수)
+ *  SIM_READ_CM(l,c,r) 필터 출력 읽기
+ *  SIM_HAS_PARAM      param.c 런타임 파라미터 테이블 있음 (-p NAME=VAL)
+ *  SIM_HAS_REC        recorder.c 주행 기록기 있음 (-r rec.bin)
+ *  SIM_HAS_SCHED      ultrasonic.c 트리거 슬롯 순서 선택 있음 (-u seq|pair|risk,adapt|fixed)
+ *  SIM_HAS_TS         ultrasonic.c 샘플 타임스탬프 있음 (TIM4 업데이트 → US_TimOverflow, 필터 출력 나이)
+ *  SIM_CAPTURE_DMA    TIM4 CH1~3 가 양쪽 에지 캡처를 DMA 로 링에 받음 (tim.c/main.c 처럼 CC 인터럽트 끔)
+ *  SIM_HAS_RANGE      us_range.c 기온 보정 mm 변환 있음 (-u ...,temp=C, 프레임 mm)
+ *  SIM_HAS_FSM        automode.c 가 fsm.c 표 구동 상태기계 (상태별 누적 시간 → track_sim 랩별 분해)
+ */
+
+#ifndef INC_SIM_VARIANT_H_
+#define INC_SIM_VARIANT_H_
+
+#ifndef SIM_VARIANT
+#define SIM_VARIANT 0
+#endif
+
+#if SIM_VARIANT == 1
+// US_Init(각도, 통로폭, SMA, STALE) + vTaskDelayUntil 10ms 두 태스크
+#define SIM_US_INIT()      US_Init(30.0f, 50.0f, 5, 300)
+#define SIM_AUTO_INIT()    AutoMode_Init()
+#define SIM_US_MS          10u
+#define SIM_AUTO_MS        10u
+// US_ReadLatest_cm/US_TryGet* 는 선언만 있고 정의가 없어서 프레임으로 읽음
+#define SIM_READ_CM(l, c, r)  \
+  do { us_frame_t f_; if (US_GetFrame(&f_)) { (l) = f_.cmL; (c) = f_.cmF; (r) = f_.cmR; } } while (0)
+
+#elif SIM_VARIANT == 2 || SIM_VARIANT == 3 || SIM_VARIANT == 5
+#define SIM_US_INIT()      US_Init()
+#define SIM_AUTO_INIT()    AutoMode_Init()
+#define SIM_US_MS          10u
+#define SIM_AUTO_MS        60u
+
+#elif SIM_VARIANT == 4
+#define SIM_US_INIT()      US_Init()
+#define SIM_AUTO_INIT()    AutoMode_Init()
+#define SIM_US_MS          10u
+#define SIM_AUTO_MS        10u
+
+#elif SIM_VARIANT >= 6 && SIM_VARIANT <= 9
+#define SIM_US_INIT()      US_Init()
+#define SIM_AUTO_INIT()    AutoMode_Init()
+#define SIM_US_MS          10u
+#define SIM_AUTO_MS         5u
+
+#elif SIM_VARIANT >= 10 && SIM_VARIANT <= 13
+#define SIM_US_INIT()      do { US_Init(); US_FilterInit(); } while (0)
+#define SIM_AUTO_INIT()    AutoMode_Start()
+#define SIM_US_MS          10u
+#define SIM_AUTO_MS         5u
+
+#elif SIM_VARIANT == 0
+// sonic 태스크는 osDelay 대신 에코 완료 알림(US_FLAG_ECHO) / US_IdleMs 타임아웃으로 깨어남
+#define SIM_US_INIT()      do { US_Init(); US_FilterInit(); US_SetNotify(osThreadGetId()); } while (0)
+#define SIM_US_WAIT        US_IdleMs
+#define SIM_AUTO_INIT()    AutoMode_Start()
+#define SIM_US_MS          10u
+#define SIM_AUTO_MS         5u
+#define SIM_HAS_PARAM      1
+#define SIM_HAS_REC        1
+#define SIM_HAS_SCHED      1
+#define SIM_HAS_TS         1
+#define SIM_CAPTURE_DMA    1
+#define SIM_HAS_RANGE      1
+#define SIM_HAS_FSM        1
+// automode.c 와 같이 한 프레임에서
+#define SIM_READ_CM(l, c, r)  \
+  do { us_frame_t f_; US_GetFrame(&f_); (l) = f_.cm[US_L]; (c) = f_.cm[US_C]; (r) = f_.cm[US_R]; } while (0)
+
+#else
+#error "unknown SIM_VARIANT"
+#endif
+
+#ifndef SIM_READ_CM
+#define SIM_READ_CM(l, c, r)  do { (l) = US_Left_cm(); (c) = US_Center_cm(); (r) = US_Right_cm(); } while (0)
+#endif
+
+#ifndef SIM_US_WAIT
+#define SIM_US_WAIT        NULL
+#endif
+
+#ifndef SIM_HAS_PARAM
+#define SIM_HAS_PARAM      0
+#endif
+
+#ifndef SIM_HAS_REC
+#define SIM_HAS_REC        0
+#endif
+
+#ifndef SIM_HAS_SCHED
+#define SIM_HAS_SCHED      0
+#endif
+
+#ifndef SIM_HAS_TS
+#define SIM_HAS_TS         0
+#endif
+
+#ifndef SIM_CAPTURE_DMA
+#define SIM_CAPTURE_DMA    0
+#endif
+#ifndef SIM_HAS_RANGE
+#define SIM_HAS_RANGE      0
+#endif
+
+#endif /* INC_SIM_VARIANT_H_ */
@@ -0,0 +1,282 @@
+/*
+ * stm32f4xx_hal.h — Host(Linux)용 HAL 대역(stand-in)
+ *
+ *  - 펌웨어(05.RC_CAR_AUTOMODE)의 automode/ultrasonic/speed/move 가 실제로 쓰는
+ *    HAL 심볼만 최소한으로 흉내낸다.
+ *  - 모든 시간은 sim_hal.c 의 가상 클럭(µs)에서 나온다 → 결정적(deterministic)
+ *  - 레지스터 비트값은 RM0383(STM32F411) 기준과 동일하게 맞춤
+ */
+
+#ifndef __STM32F4xx_HAL_H
+#define __STM32F4xx_HAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define __IO    volatile
+#define __weak  __attribute__((weak))
+
+// newlib(arm-none-eabi) math.h 는 기본으로 주지만 glibc -std=c11 은 안 줌
+// volatile 카운터 루프 1회(ldr/add/str/cmp/b + nop) ≈ 8 사이클 — NOP 지연 루프가 가상 시간을 쓰도록
+#define __NOP()        SimHal_SpendCycles(8u)
+// 단일 스레드 가상 시간이라 인터럽트가 끼어들 일이 없음
+#define __disable_irq()  ((void)0)
+#define __enable_irq()   ((void)0)
+#define __DMB()          __sync_synchronize()
+
+#ifndef M_PI
+#define M_PI    3.14159265358979323846
+#endif
+
+// ===== 코어 (DWT 사이클 카운터, prof.c) =====
+// CYCCNT = 가상 클럭 × 100MHz (읽을 때마다 SimHal_Dwt 가 갱신) → 가상 시간을 쓰는 코드(delay_us 등)만 값이 잡힘
+typedef struct {
+  __IO uint32_t CTRL;
+  __IO uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct {
+  __IO uint32_t DEMCR;
+} CoreDebug_Type;
+
+DWT_Type *SimHal_Dwt(void);
+extern CoreDebug_Type SimHal_CoreDebug;
+extern uint32_t       SystemCoreClock;
+#define DWT        (SimHal_Dwt())
+#define CoreDebug  (&SimHal_CoreDebug)
+#define DWT_CTRL_CYCCNTENA_Msk       0x00000001U
+#define CoreDebug_DEMCR_TRCENA_Msk   0x01000000U
+
+typedef enum { HAL_OK = 0x00U, HAL_ERROR = 0x01U, HAL_BUSY = 0x02U, HAL_TIMEOUT = 0x03U } HAL_StatusTypeDef;
+
+// ===== GPIO =====
+typedef struct {
+  __IO uint32_t IDR;
+  __IO uint32_t ODR;
+  __IO uint32_t BSRR;    // DMA 목적지 주소로만 씀 (쓰기 효과는 sim_hal.c 가 반영)
+} GPIO_TypeDef;
+
+typedef enum { GPIO_PIN_RESET = 0, GPIO_PIN_SET } GPIO_PinState;
+
+#define GPIO_PIN_0    ((uint16_t)0x0001)
+#define GPIO_PIN_1    ((uint16_t)0x0002)
+#define GPIO_PIN_2    ((uint16_t)0x0004)
+#define GPIO_PIN_3    ((uint16_t)0x0008)
+#define GPIO_PIN_4    ((uint16_t)0x0010)
+#define GPIO_PIN_5    ((uint16_t)0x0020)
+#define GPIO_PIN_6    ((uint16_t)0x0040)
+#define GPIO_PIN_7    ((uint16_t)0x0080)
+#define GPIO_PIN_8    ((uint16_t)0x0100)
+#define GPIO_PIN_9    ((uint16_t)0x0200)
+#define GPIO_PIN_10   ((uint16_t)0x0400)
+#define GPIO_PIN_11   ((uint16_t)0x0800)
+#define GPIO_PIN_12   ((uint16_t)0x1000)
+#define GPIO_PIN_13   ((uint16_t)0x2000)
+#define GPIO_PIN_14   ((uint16_t)0x4000)
+#define GPIO_PIN_15   ((uint16_t)0x8000)
+
+extern GPIO_TypeDef SimHal_GPIOA, SimHal_GPIOB, SimHal_GPIOC;
+#define GPIOA   (&SimHal_GPIOA)
+#define GPIOB   (&SimHal_GPIOB)
+#define GPIOC   (&SimHal_GPIOC)
+
+void          HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void          HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+
+// ===== DMA (순환만: TIM1 CC DMA 메모리→GPIO BSRR 워드, TIM4 CC DMA CCRx→메모리 하프워드) =====
+// 주소는 uintptr_t (64bit 호스트), 펌웨어도 (uintptr_t) 로 캐스팅해서 넘김
+typedef struct __DMA_HandleTypeDef {
+  uintptr_t src;
+  uintptr_t dst;
+  uint32_t  len;
+  uint32_t  pos;
+  uint8_t   busy;
+  uint8_t   p2m;   // 1: 주변장치 레지스터 → 메모리 하프워드 링 (tim.c MspInit 의 Direction/정렬 대신, SimHal_Reset 이 정함)
+  uint8_t   it;    // HAL_DMA_Start_IT: 하프(len/2)/완료(0) 에서 콜백 = DMA IRQ
+  void    (*XferCpltCallback)(struct __DMA_HandleTypeDef *hdma);
+  void    (*XferHalfCpltCallback)(struct __DMA_HandleTypeDef *hdma);
+} DMA_HandleTypeDef;
+
+// NDTR: 이번 바퀴에 남은 전송 수 (순환이면 0 이 되는 순간 len 으로 다시)
+#define __HAL_DMA_GET_COUNTER(__HANDLE__)  ((__HANDLE__)->len - (__HANDLE__)->pos)
+
+HAL_StatusTypeDef HAL_DMA_Start(DMA_HandleTypeDef *hdma, uintptr_t SrcAddress, uintptr_t DstAddress, uint32_t DataLength);
+HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef *hdma, uintptr_t SrcAddress, uintptr_t DstAddress, uint32_t DataLength);
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef *hdma);
+
+// ===== TIM =====
+typedef struct {
+  __IO uint32_t CR1;
+  __IO uint32_t DIER;
+  __IO uint32_t SR;
+  __IO uint32_t CCER;
+  __IO uint32_t CNT;
+  __IO uint32_t PSC;
+  __IO uint32_t ARR;
+  __IO uint32_t CCR1;
+  __IO uint32_t CCR2;
+  __IO uint32_t CCR3;
+  __IO uint32_t CCR4;
+} TIM_TypeDef;
+
+typedef struct {
+  uint32_t Prescaler;
+  uint32_t CounterMode;
+  uint32_t Period;
+  uint32_t ClockDivision;
+  uint32_t AutoReloadPreload;
+} TIM_Base_InitTypeDef;
+
+typedef enum {
+  HAL_TIM_ACTIVE_CHANNEL_1       = 0x01U,
+  HAL_TIM_ACTIVE_CHANNEL_2       = 0x02U,
+  HAL_TIM_ACTIVE_CHANNEL_3       = 0x04U,
+  HAL_TIM_ACTIVE_CHANNEL_4       = 0x08U,
+  HAL_TIM_ACTIVE_CHANNEL_CLEARED = 0x00U
+} HAL_TIM_ActiveChannel;
+
+typedef struct {
+  TIM_TypeDef           *Instance;
+  TIM_Base_InitTypeDef   Init;
+  HAL_TIM_ActiveChannel  Channel;
+  DMA_HandleTypeDef     *hdma[7];
+} TIM_HandleTypeDef;
+
+extern TIM_TypeDef SimHal_TIM1, SimHal_TIM3, SimHal_TIM4, SimHal_TIM11;
+#define TIM1    (&SimHal_TIM1)
+#define TIM3    (&SimHal_TIM3)
+#define TIM4    (&SimHal_TIM4)
+#define TIM11   (&SimHal_TIM11)
+
+#define TIM_CHANNEL_1   0x00000000U
+#define TIM_CHANNEL_2   0x00000004U
+#define TIM_CHANNEL_3   0x00000008U
+#define TIM_CHANNEL_4   0x0000000CU
+
+#define TIM_IT_UPDATE   0x00000001U
+#define TIM_IT_CC1      0x00000002U
+#define TIM_IT_CC2      0x00000004U
+#define TIM_IT_CC3      0x00000008U
+#define TIM_IT_CC4      0x00000010U
+
+#define TIM_FLAG_UPDATE 0x00000001U
+#define TIM_FLAG_CC1    0x00000002U
+#define TIM_FLAG_CC2    0x00000004U
+#define TIM_FLAG_CC3    0x00000008U
+#define TIM_FLAG_CC4    0x00000010U
+#define TIM_FLAG_CC1OF  0x00000200U
+#define TIM_FLAG_CC2OF  0x00000400U
+#define TIM_FLAG_CC3OF  0x00000800U
+#define TIM_FLAG_CC4OF  0x00001000U
+
+#define TIM_DMA_ID_CC1  0x0001U
+#define TIM_DMA_ID_CC2  0x0002U
+#define TIM_DMA_ID_CC3  0x0003U
+#define TIM_DMA_CC1     0x00000200U
+#define TIM_DMA_CC2     0x00000400U
+#define TIM_DMA_CC3     0x00000800U
+
+#define TIM_CR1_CEN     0x00000001U
+#define TIM_CR1_OPM     0x00000008U
+
+#define TIM_INPUTCHANNELPOLARITY_RISING    0x00000000U
+#define TIM_INPUTCHANNELPOLARITY_FALLING   0x00000002U
+#define TIM_INPUTCHANNELPOLARITY_BOTHEDGE  0x0000000AU
+
+#define __HAL_TIM_ENABLE_IT(__HANDLE__, __IT__)     ((__HANDLE__)->Instance->DIER |= (__IT__))
+#define __HAL_TIM_DISABLE_IT(__HANDLE__, __IT__)    ((__HANDLE__)->Instance->DIER &= ~(uint32_t)(__IT__))
+#define __HAL_TIM_CLEAR_FLAG(__HANDLE__, __FLAG__)  ((__HANDLE__)->Instance->SR &= ~(uint32_t)(__FLAG__))
+#define __HAL_TIM_GET_FLAG(__HANDLE__, __FLAG__)    (((__HANDLE__)->Instance->SR & (__FLAG__)) == (__FLAG__))
+#define __HAL_TIM_ENABLE_DMA(__HANDLE__, __DMA__)   ((__HANDLE__)->Instance->DIER |= (__DMA__))
+#define __HAL_TIM_DISABLE_DMA(__HANDLE__, __DMA__)  ((__HANDLE__)->Instance->DIER &= ~(uint32_t)(__DMA__))
+// CEN 은 카운터 이벤트(CC 매치/업데이트) 예약을 시작/취소해야 해서 함수로
+#define __HAL_TIM_ENABLE(__HANDLE__)                SimHal_TIM_Enable(__HANDLE__)
+#define __HAL_TIM_DISABLE(__HANDLE__)               SimHal_TIM_Disable(__HANDLE__)
+
+#define __HAL_TIM_SET_CAPTUREPOLARITY(__HANDLE__, __CHANNEL__, __POLARITY__) \
+  ((__HANDLE__)->Instance->CCER = ((__HANDLE__)->Instance->CCER & ~(0x0000000AU << (__CHANNEL__))) \
+                                  | ((uint32_t)(__POLARITY__) << (__CHANNEL__)))
+
+// CNT 는 가상 클럭에서 계산되므로 함수로 우회
+#define __HAL_TIM_SET_COMPARE(__HANDLE__, __CHANNEL__, __COMPARE__) \
+  SimHal_TIM_SetCompare((__HANDLE__), (__CHANNEL__), (uint32_t)(__COMPARE__))
+#define __HAL_TIM_GET_COMPARE(__HANDLE__, __CHANNEL__)  SimHal_TIM_GetCompare((__HANDLE__), (__CHANNEL__))
+#define __HAL_TIM_SET_COUNTER(__HANDLE__, __COUNTER__)  SimHal_TIM_SetCounter((__HANDLE__), (uint32_t)(__COUNTER__))
+#define __HAL_TIM_GET_COUNTER(__HANDLE__)               SimHal_TIM_GetCounter(__HANDLE__)
+#define __HAL_TIM_GET_AUTORELOAD(__HANDLE__)            ((__HANDLE__)->Instance->ARR)
+#define __HAL_TIM_SET_AUTORELOAD(__HANDLE__, __AUTORELOAD__) \
+  do { (__HANDLE__)->Instance->ARR = (__AUTORELOAD__); (__HANDLE__)->Init.Period = (__AUTORELOAD__); } while (0)
+
+void     SimHal_TIM_SetCompare(TIM_HandleTypeDef *htim, uint32_t Channel, uint32_t Compare);
+uint32_t SimHal_TIM_GetCompare(TIM_HandleTypeDef *htim, uint32_t Channel);
+void     SimHal_TIM_SetCounter(TIM_HandleTypeDef *htim, uint32_t Counter);
+uint32_t SimHal_TIM_GetCounter(TIM_HandleTypeDef *htim);
+void     SimHal_TIM_Enable(TIM_HandleTypeDef *htim);
+void     SimHal_TIM_Disable(TIM_HandleTypeDef *htim);
+void     SimHal_SpendCycles(uint32_t cyc);
+
+uint32_t HAL_TIM_ReadCapturedValue(TIM_HandleTypeDef *htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_IC_Start(TIM_HandleTypeDef *htim, uint32_t Channel);   // 정의는 sonar_bench.c 만
+void     HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef *htim);
+void     HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim);
+void     HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim);
+
+// ===== UART (전송 + DMA 전송, 수신 없음) =====
+typedef struct { uint32_t dummy; } USART_TypeDef;
+typedef struct { USART_TypeDef *Instance; } UART_HandleTypeDef;
+
+extern USART_TypeDef SimHal_USART1, SimHal_USART2;
+#define USART1  (&SimHal_USART1)
+#define USART2  (&SimHal_USART2)
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);   // 수신 없음
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size);
+void              HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart);
+
+// ===== FLASH (param.c 저장 블록) =====
+// 섹터 하나를 RAM 배열로 흉내: 지우면 0xFF, 쓰기는 1→0 비트만 (실제 NOR 플래시와 같게)
+#define SIM_FLASH_SECTOR_SIZE   (128u * 1024u)
+extern uint8_t SimHal_Flash[SIM_FLASH_SECTOR_SIZE];
+#define PARAM_FLASH_ADDR        ((uintptr_t)SimHal_Flash)
+
+typedef struct {
+  uint32_t TypeErase;
+  uint32_t Banks;
+  uint32_t Sector;
+  uint32_t NbSectors;
+  uint32_t VoltageRange;
+} FLASH_EraseInitTypeDef;
+
+#define FLASH_TYPEERASE_SECTORS   0x00000000U
+#define FLASH_SECTOR_7            7U
+#define FLASH_VOLTAGE_RANGE_3     0x00000002U
+#define FLASH_TYPEPROGRAM_WORD    0x00000002U
+
+#define FLASH_FLAG_EOP            0x00000001U
+#define FLASH_FLAG_OPERR          0x00000002U
+#define FLASH_FLAG_WRPERR         0x00000010U
+#define FLASH_FLAG_PGAERR         0x00000020U
+#define FLASH_FLAG_PGPERR         0x00000040U
+#define FLASH_FLAG_PGSERR         0x00000080U
+#define __HAL_FLASH_CLEAR_FLAG(__FLAG__)  ((void)(__FLAG__))
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError);
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uintptr_t Address, uint64_t Data);
+
+// ===== 시스템 =====
+uint32_t HAL_GetTick(void);
+void     HAL_Delay(uint32_t Delay);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __STM32F4xx_HAL_H */
@@ -0,0 +1,170 @@
+/*
+ * auto_bench.c — AutoMode_Step 단독 벤치 + 인스턴스 격리 확인 (주행 기록 입력)
+ *
+ *  사용법: auto_bench rec.bin [-k 인스턴스] [-n 반복] [-p NAME=VAL ...]
+ *   -k  나란히 돌릴 AutoState_t 수 (기본 8, 최대 64)
+ *   -n  기록 전체를 몇 번 돌려 시간을 잴지 (기본 20)
+ *   -p  튜닝 파라미터 (replay 와 같음 — 인스턴스는 PARAM 을 공유)
+ *
+ *  기록의 tick + 필터 거리 + 추적 속도/플래그를 AutoInput_t 로 만들어 (replay 의 US_GetFrame 과 같은 매핑)
+ *   pwm 은 직전 레코드의 CCR1/CCR2 평균 (기록은 명령 뒤 값 — 첫 레코드는 SPEED_BASE)
+ *   1) 인스턴스 1개: 주기마다 state/mode/dir 를 기록과 비교 (모터/시계/센서 없이 판단만으로 재현되는지)
+ *   2) 인스턴스 k 개를 주기마다 번갈아: 출력(방향/속도 명령)과 상태가 1) 과 같은지 (파일 static 섞임 없음)
+ *   3) Step 만 시간 잼: 인스턴스 1개 / k 개 번갈아, 주기당 ns
+ *  seq 드롭은 채우지 않음 (replay 와 달리 빠진 주기는 그냥 건너뜀 — 비교는 드롭 전까지만 의미 있음).
+ *  호스트 x86 수치 — 보드 실측은 prof auto_update (Param_Sync + 기록 포함).
+ *
+ *  종료 코드: 0 = 전부 일치, 4 = 불일치, 1/2 = 파일/인자 오류
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "sim_hal.h"
+#include "sim_board.h"
+#include "rec_log.h"
+#include "ultrasonic.h"
+#include "automode.h"
+#include "param.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define INST_MAX  64
+
+// automode.o 의 AutoMode_Update / param.c 콘솔이 참조 (여기선 Step 만 부름)
+void US_GetFrame(us_frame_t *f)  { *f = (us_frame_t){0}; }
+void US_Command(const char *arg) { (void)arg; }
+void US_SetDriveHint(int16_t vC, us_drive_t drive, int8_t dir) { (void)vC; (void)drive; (void)dir; }
+
+typedef struct { uint8_t state, mode; int8_t dir; } snap_t;
+
+static double now_s(void)
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+static void to_input(const rec_t *r, uint16_t pwm, AutoInput_t *in)
+{
+  *in = (AutoInput_t){ .now_ms = r->tick, .pwm = pwm };
+  memcpy(in->us.cm, r->dist_cm, sizeof in->us.cm);
+  memcpy(in->us.echo_us, r->echo_us, sizeof in->us.echo_us);
+  in->us.rate_cms[US_L] = r->vL;
+  in->us.rate_cms[US_R] = r->vR;
+  in->us.rate_cms[US_C] = r->vC;
+  in->us.conf[US_L]     = (r->flags & REC_F_VL_READY) ? 100u : 0u;
+  in->us.conf[US_R]     = (r->flags & REC_F_VR_READY) ? 100u : 0u;
+  in->us.conf[US_C]     = (r->flags & REC_F_VC_READY) ? 100u : 0u;
+  in->us.wobble         = (r->flags & REC_F_WOBBLE) ? (uint8_t)(1u << US_C) : 0u;
+}
+
+static snap_t snap(const AutoState_t *st)
+{
+  return (snap_t){ (uint8_t)st->state, (uint8_t)st->mode, (int8_t)st->dir };
+}
+
+int main(int argc, char **argv)
+{
+  const char *log = NULL;
+  uint32_t    k = 8, reps = 20;
+  const char *params[SIM_PARAM_MAX];
+  int         np = 0;
+
+  for (int i = 1; i < argc; ++i) {
+    if      (!strcmp(argv[i], "-k") && i + 1 < argc) k = (uint32_t)strtoul(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-n") && i + 1 < argc) reps = (uint32_t)strtoul(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-p") && i + 1 < argc && np < (int)SIM_PARAM_MAX) params[np++] = argv[++i];
+    else if (argv[i][0] != '-' && log == NULL) log = argv[i];
+    else { log = NULL; break; }
+  }
+  if (log == NULL || k == 0u || k > INST_MAX || reps == 0u) {
+    fprintf(stderr, "usage: %s rec.bin [-k instances(1..%d)] [-n reps] [-p NAME=VAL ...]\n", argv[0], INST_MAX);
+    return 2;
+  }
+
+  SimHal_Reset();
+  Param_Init();
+  if (!SimBoard_SetParams(params, np)) return 2;
+  Param_Sync();
+
+  // 기록 → 입력 배열
+  static RecReader_t rd;
+  if (!RecReader_Open(&rd, log)) return 1;
+  uint32_t n = 0, cap = 0;
+  AutoInput_t *in = NULL;
+  snap_t      *car = NULL;
+  rec_t r;
+  uint16_t pwm = (uint16_t)PARAM(SPEED_BASE);
+  while (RecReader_Next(&rd, &r)) {
+    if (n == cap) {
+      cap = cap ? cap * 2u : 4096u;
+      in  = realloc(in,  cap * sizeof *in);
+      car = realloc(car, cap * sizeof *car);
+      if (in == NULL || car == NULL) return 1;
+    }
+    to_input(&r, pwm, &in[n]);
+    pwm = (uint16_t)((r.ccr1 + r.ccr2) / 2u);
+    car[n] = (snap_t){ r.state, r.mode, r.dir };
+    n++;
+  }
+  RecReader_Close(&rd);
+  if (n == 0u) { fprintf(stderr, "auto_bench: no valid records in %s\n", log); return 1; }
+
+  // 1) 인스턴스 1개 vs 기록
+  AutoOutput_t *ref = malloc(n * sizeof *ref);
+  snap_t       *ref_st = malloc(n * sizeof *ref_st);
+  if (ref == NULL || ref_st == NULL) return 1;
+  AutoState_t one;
+  AutoMode_Init(&one, in[0].now_ms);
+  uint32_t vs_car = 0, first_bad = 0;
+  for (uint32_t i = 0; i < n; ++i) {
+    ref[i]    = AutoMode_Step(&one, &in[i]);
+    ref_st[i] = snap(&one);
+    if (memcmp(&ref_st[i], &car[i], sizeof car[i]) != 0 && vs_car++ == 0u) first_bad = i;
+  }
+
+  // 2) k 개 번갈아, 같은 입력열 → 출력/상태가 1) 과 같아야 함
+  static AutoState_t st[INST_MAX];
+  for (uint32_t j = 0; j < k; ++j) AutoMode_Init(&st[j], in[0].now_ms);
+  uint32_t vs_one = 0;
+  for (uint32_t i = 0; i < n; ++i) {
+    for (uint32_t j = 0; j < k; ++j) {
+      const AutoOutput_t o = AutoMode_Step(&st[j], &in[i]);
+      const snap_t s = snap(&st[j]);
+      if (o.action != ref[i].action || o.speed != ref[i].speed || memcmp(&s, &ref_st[i], sizeof s) != 0) vs_one++;
+    }
+  }
+
+  // 3) 시간: Step 만
+  volatile uint32_t sink = 0;
+  double t1 = 1e9, tk = 1e9;
+  for (uint32_t rep = 0; rep < reps; ++rep) {
+    AutoMode_Init(&one, in[0].now_ms);
+    double t0 = now_s();
+    for (uint32_t i = 0; i < n; ++i) { const AutoOutput_t o = AutoMode_Step(&one, &in[i]); sink += o.action + o.speed; }
+    double dt = now_s() - t0;
+    if (dt < t1) t1 = dt;
+
+    for (uint32_t j = 0; j < k; ++j) AutoMode_Init(&st[j], in[0].now_ms);
+    t0 = now_s();
+    for (uint32_t i = 0; i < n; ++i)
+      for (uint32_t j = 0; j < k; ++j) { const AutoOutput_t o = AutoMode_Step(&st[j], &in[i]); sink += o.action + o.speed; }
+    dt = now_s() - t0;
+    if (dt < tk) tk = dt;
+  }
+  (void)sink;
+
+  printf("records  %u (skipped %u B, %u seq gaps / %u lost)  state %zu B\n",
+         rd.records, rd.skipped, rd.seq_gaps, rd.seq_lost, sizeof(AutoState_t));
+  printf("vs log   state/mode/dir mismatch %u", vs_car);
+  if (vs_car) printf(" (first at seq-index %u tick %u)", first_bad, in[first_bad].now_ms);
+  printf("\n");
+  printf("isolate  %u instances interleaved, mismatch vs single %u\n", k, vs_one);
+  printf("step     1 instance %.1f ns/step   %u interleaved %.1f ns/step  (best of %u)\n",
+         t1 * 1e9 / n, k, tk * 1e9 / ((double)n * k), reps);
+  free(in); free(car); free(ref); free(ref_st);
+  return (vs_car || vs_one) ? 4 : 0;
+}
@@ -0,0 +1,221 @@
+/*
+ * main.c — automode 호스트 실행기 (HAL 대역 + 가상 클럭)
+ *
+ *  사용법: automode_host [-t 초] [-d L,C,R] [-s script.txt] [-o trace.csv] [-p NAME=VAL ...] [-r rec.bin]
+ *                       [-u seq|pair|risk[,adapt|fixed][,med=L/R/C][,temp=C]] [-x prob] [-a C] [-q]
+ *   -t  가상 주행 시간(초, 기본 10)
+ *   -d  고정 거리[cm] (기본 50,150,50)
+ *   -s  거리 스크립트: 줄마다 "t_ms L C R" (구간 상수, '#' 주석, -1=미검출 38ms 펄스, -2=모듈 무응답)
+ *   -o  5ms 마다 센서/PWM/방향핀 CSV 기록
+ *   -p  튜닝 파라미터 덮어쓰기 (param.h 이름, 여러 번 가능)
+ *   -r  주행 기록(recorder.c) USART2 송출을 파일로 (rec_decode 로 CSV)
+ *   -u  초음파 트리거 슬롯 순서 / 길이 (ultrasonic.c US_SetSchedule, US_SetAdaptiveGap)
+ *   -x  동시 발사 crosstalk 확률 (sim_sonar.c, 0~1)
+ *   -a  모델 공기 기온 [°C] (음속 331.3 + 0.606 T, 기본 20 — 펌웨어가 쓰는 기온은 -u temp=)
+ *   -q  요약만 출력
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "sim_hal.h"
+#include "sim_sonar.h"
+#include "sim_task.h"
+#include "sim_board.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SCRIPT_MAX  1024u
+
+typedef struct { uint32_t t_ms; float cm[3]; } script_row_t;
+
+static script_row_t s_rows[SCRIPT_MAX];
+static uint32_t     s_row_num = 0;
+static float        s_fixed[3] = { [SIM_US_LEFT] = 50.0f, [SIM_US_RIGHT] = 50.0f, [SIM_US_CENTER] = 150.0f };
+
+static FILE *s_trace = NULL;
+
+// automode 주기(5ms)마다 본 필터 출력의 나이 [us] (펌웨어 타임스탬프가 있는 트리만)
+static uint64_t s_age_sum[SIM_US_NUM];
+static uint32_t s_age_max[SIM_US_NUM];
+static uint32_t s_age_n = 0;
+
+// ==== 거리 공급자 ====
+static float range_script(uint8_t idx, uint64_t t_us, void *ctx)
+{
+  (void)ctx;
+  if (idx >= 3) return -1.0f;
+  if (s_row_num == 0) return s_fixed[idx];
+
+  const uint32_t ms = (uint32_t)(t_us / 1000u);
+  uint32_t k = 0;
+  while (k + 1 < s_row_num && s_rows[k + 1].t_ms <= ms) k++;
+  return s_rows[k].cm[idx];
+}
+
+static bool load_script(const char *path)
+{
+  FILE *f = fopen(path, "r");
+  if (f == NULL) { perror(path); return false; }
+
+  char line[128];
+  while (fgets(line, sizeof line, f) && s_row_num < SCRIPT_MAX) {
+    if (line[0] == '#' || line[0] == '\n') continue;
+    script_row_t r;
+    // 스크립트 순서는 L C R, 센서 인덱스는 ultrasonic.c 의 us_idx_t(L,R,C)
+    float l, c, rr;
+    if (sscanf(line, "%u %f %f %f", &r.t_ms, &l, &c, &rr) != 4) continue;
+    r.cm[SIM_US_LEFT] = l; r.cm[SIM_US_CENTER] = c; r.cm[SIM_US_RIGHT] = rr;
+    s_rows[s_row_num++] = r;
+  }
+  fclose(f);
+  return s_row_num > 0;
+}
+
+// ==== 트레이스 ====
+static void trace_tick(uint32_t now_ms, void *ctx)
+{
+  (void)ctx;
+  if ((now_ms % 5u) != 0u) return;
+
+  uint32_t age[SIM_US_NUM];
+  if (SimBoard_ReadAge(age)) {
+    for (uint8_t i = 0; i < SIM_US_NUM; ++i) {
+      s_age_sum[i] += age[i];
+      if (age[i] > s_age_max[i]) s_age_max[i] = age[i];
+    }
+    s_age_n++;
+  }
+
+  if (s_trace == NULL) return;
+  uint16_t cm[SIM_US_NUM];
+  SimBoard_ReadCm(cm);
+  fprintf(s_trace, "%u,%u,%u,%u,%lu,%lu,%d,%d\n",
+          now_ms, cm[SIM_US_LEFT], cm[SIM_US_CENTER], cm[SIM_US_RIGHT],
+          (unsigned long)SimHal_PwmRight(), (unsigned long)SimHal_PwmLeft(),
+          SimBoard_RightDir(), SimBoard_LeftDir());
+}
+
+static double wall_seconds(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv)
+{
+  double      sec = 10.0;
+  const char *script = NULL, *trace = NULL;
+  bool        quiet = false;
+  const char *params[SIM_PARAM_MAX];
+  int         np = 0;
+  const char *rec = NULL;
+  const char *sched = NULL;
+  float       xt = 0.0f;
+  float       air_c = 20.0f;
+
+  for (int i = 1; i < argc; ++i) {
+    if      (!strcmp(argv[i], "-t") && i + 1 < argc) sec = atof(argv[++i]);
+    else if (!strcmp(argv[i], "-s") && i + 1 < argc) script = argv[++i];
+    else if (!strcmp(argv[i], "-o") && i + 1 < argc) trace = argv[++i];
+    else if (!strcmp(argv[i], "-r") && i + 1 < argc) rec = argv[++i];
+    else if (!strcmp(argv[i], "-u") && i + 1 < argc) sched = argv[++i];
+    else if (!strcmp(argv[i], "-x") && i + 1 < argc) xt = (float)atof(argv[++i]);
+    else if (!strcmp(argv[i], "-a") && i + 1 < argc) air_c = (float)atof(argv[++i]);
+    else if (!strcmp(argv[i], "-q")) quiet = true;
+    else if (!strcmp(argv[i], "-p") && i + 1 < argc && np < (int)SIM_PARAM_MAX) params[np++] = argv[++i];
+    else if (!strcmp(argv[i], "-d") && i + 1 < argc) {
+      float l, c, r;
+      if (sscanf(argv[++i], "%f,%f,%f", &l, &c, &r) == 3) {
+        s_fixed[SIM_US_LEFT] = l; s_fixed[SIM_US_CENTER] = c; s_fixed[SIM_US_RIGHT] = r;
+      }
+    }
+    else {
+      fprintf(stderr, "usage: %s [-t sec] [-d L,C,R] [-s script] [-o trace.csv] [-p NAME=VAL ...] [-r rec.bin]"
+                      " [-u seq|pair|risk[,adapt|fixed][,med=L/R/C][,temp=C]] [-x prob] [-a C] [-q]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (script && !load_script(script)) return 1;
+
+  if (trace) {
+    s_trace = fopen(trace, "w");
+    if (s_trace == NULL) { perror(trace); return 1; }
+    fprintf(s_trace, "t_ms,L,C,R,ccr1_right,ccr2_left,dir_right,dir_left\n");
+  }
+
+  SimBoard_Init(range_script, NULL);
+  if (!SimBoard_SetParams(params, np)) return 2;
+  if (sched && !SimBoard_Schedule(sched)) return 2;
+  SimSonar_SetCrosstalk(xt, 1u);
+  SimSonar_SetSoundSpeed(331.3f + 0.606f * air_c);
+  FILE *recf = NULL;
+  if (rec) {
+    recf = fopen(rec, "wb");
+    if (recf == NULL) { perror(rec); return 1; }
+    if (!SimBoard_Record(recf)) return 2;
+  }
+
+  const double w0 = wall_seconds();
+  SimBoard_Run((uint32_t)(sec * 1000.0), trace_tick, NULL);
+  const double w1 = wall_seconds();
+
+  if (s_trace) fclose(s_trace);
+  if (recf) { SimBoard_Record(NULL); fclose(recf); }
+
+  const double vsec = (double)HAL_GetTick() / 1000.0;
+  if (!quiet) {
+    uint16_t cm[SIM_US_NUM];
+    SimBoard_ReadCm(cm);
+    printf("final  L=%u C=%u R=%u  CCR1(R)=%lu CCR2(L)=%lu  dirR=%d dirL=%d\n",
+           cm[SIM_US_LEFT], cm[SIM_US_CENTER], cm[SIM_US_RIGHT],
+           (unsigned long)SimHal_PwmRight(), (unsigned long)SimHal_PwmLeft(),
+           SimBoard_RightDir(), SimBoard_LeftDir());
+    printf("shots  L=%u R=%u C=%u  ignored L=%u R=%u C=%u\n",
+           SimSonar_Shots(SIM_US_LEFT), SimSonar_Shots(SIM_US_RIGHT), SimSonar_Shots(SIM_US_CENTER),
+           SimSonar_Ignored(SIM_US_LEFT), SimSonar_Ignored(SIM_US_RIGHT), SimSonar_Ignored(SIM_US_CENTER));
+    if (xt > 0.0f) {
+      printf("xtalk  L=%u R=%u C=%u\n",
+             SimSonar_Crosstalk(SIM_US_LEFT), SimSonar_Crosstalk(SIM_US_RIGHT), SimSonar_Crosstalk(SIM_US_CENTER));
+    }
+    const double per_s = (vsec > 0.0) ? 1.0 / vsec : 0.0;
+    printf("irq    TIM4 %u (%.0f/s)  DMA %u (%.0f/s)  sonic wake %u (%.0f/s)\n", SimHal_Tim4Irq(), SimHal_Tim4Irq() * per_s,
+           SimHal_DmaIrq(), SimHal_DmaIrq() * per_s, SimBoard_Stats()->sonic_runs, SimBoard_Stats()->sonic_runs * per_s);
+    SimBoard_SonarStatus();
+    uint16_t mm[SIM_US_NUM];
+    if (SimBoard_ReadMm(mm)) {
+      // 스크립트 없이 고정 거리면 참값과 비교
+      printf("range  air %.1fC  mm L=%u C=%u R=%u", air_c, mm[SIM_US_LEFT], mm[SIM_US_CENTER], mm[SIM_US_RIGHT]);
+      if (s_row_num == 0) {
+        printf("  (true %.0f/%.0f/%.0f)", s_fixed[SIM_US_LEFT] * 10.0f, s_fixed[SIM_US_CENTER] * 10.0f,
+               s_fixed[SIM_US_RIGHT] * 10.0f);
+      }
+      printf("\n");
+    }
+    if (s_age_n > 0u) {
+      static const struct { uint8_t idx; char name; } age[] = {
+        { SIM_US_LEFT, 'L' }, { SIM_US_RIGHT, 'R' }, { SIM_US_CENTER, 'C' } };
+      printf("age   ");
+      for (uint8_t k = 0; k < 3; ++k) {
+        const uint8_t i = age[k].idx;
+        printf(" %c=%.1f/%.1fms", age[k].name, (double)s_age_sum[i] / s_age_n / 1000.0, s_age_max[i] / 1000.0);
+      }
+      printf("  (mean/max)\n");
+    }
+    static const struct { uint8_t idx; char name; } trig[] = {
+      { SIM_US_LEFT, 'L' }, { SIM_US_RIGHT, 'R' }, { SIM_US_CENTER, 'C' } };
+    printf("trig  ");
+    for (uint8_t k = 0; k < 3; ++k) {
+      uint32_t lo, hi;
+      if (SimSonar_TrigWidth(trig[k].idx, &lo, &hi)) printf(" %c=%u..%uus", trig[k].name, lo, hi);
+      else                                           printf(" %c=-", trig[k].name);
+    }
+    printf("\n");
+  }
+  printf("virtual %.3f s  wall %.4f s  x%.0f real time\n",
+         vsec, w1 - w0, (w1 > w0) ? vsec / (w1 - w0) : 0.0);
+  return 0;
+}
@@ -0,0 +1,141 @@
+/*
+ * med_bench.c — 초음파 미디언 마이크로벤치 (us_median.c vs 예전 복사 + 삽입정렬)
+ *
+ *  사용법: med_bench [-n 샘플수] [-s 시드]
+ *   -n  창 크기마다 넣을 샘플 수 (기본 2000000)
+ *   -s  샘플 생성 시드 (기본 1)
+ *
+ *  창 3~15 각각: 같은 샘플열(벽 거리 랜덤워크 + 튀는 값 + 같은 값 반복)을 두 구현에 넣고
+ *  샘플당 ns 와 출력(거리, 타임스탬프) 일치 여부를 찍는다.
+ *  호스트 x86 수치라 절대값은 보드와 다름 — 창 크기에 따른 증가 추세 비교용 (보드 실측은 prof us_filter).
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "us_median.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ==== 예전 ultrasonic.c: 창 복사 후 삽입정렬 (타임스탬프 같이) ====
+typedef struct {
+  uint16_t buf[US_MED_WIN_MAX];
+  uint32_t ts[US_MED_WIN_MAX];
+  uint8_t  win, wpos;
+} ref_median_t;
+
+static void ref_init(ref_median_t *m, uint8_t win, uint16_t cm, uint32_t ts)
+{
+  m->win = win; m->wpos = 0;
+  for (uint8_t k = 0; k < win; ++k) { m->buf[k] = cm; m->ts[k] = ts; }
+}
+
+static uint16_t ref_push(ref_median_t *m, uint16_t cm, uint32_t ts, uint32_t *ts_out)
+{
+  m->buf[m->wpos] = cm;
+  m->ts[m->wpos]  = ts;
+  m->wpos = (uint8_t)((m->wpos + 1u) % m->win);
+
+  uint16_t arr[US_MED_WIN_MAX];
+  uint32_t tss[US_MED_WIN_MAX];
+  const uint8_t n = m->win;
+  if (n == 0u) return 0u;
+  for (uint8_t i = 0; i < n; ++i) { arr[i] = m->buf[i]; tss[i] = m->ts[i]; }
+  for (uint8_t i = 1; i < n; ++i) {
+    uint16_t key = arr[i];
+    uint32_t kts = tss[i];
+    int8_t j = (int8_t)i - 1;
+    while (j >= 0 && arr[j] > key) { arr[j + 1] = arr[j]; tss[j + 1] = tss[j]; --j; }
+    arr[j + 1] = key; tss[j + 1] = kts;
+  }
+  const uint16_t med = arr[n / 2];
+  uint32_t t = tss[n / 2];
+  for (uint8_t k = 0; k < n; ++k) if (arr[k] == med && (int32_t)(tss[k] - t) > 0) t = tss[k];
+  *ts_out = t;
+  return med;
+}
+
+// ==== 샘플열 ====
+typedef struct { uint16_t cm; uint32_t ts; } sample_t;
+
+static uint32_t s_rng;
+static uint32_t rng(void) { s_rng ^= s_rng << 13; s_rng ^= s_rng >> 17; s_rng ^= s_rng << 5; return s_rng; }
+
+static void make_samples(sample_t *s, uint32_t n)
+{
+  int32_t d = 150;
+  uint32_t ts = 0, last_ts = 0;
+  for (uint32_t i = 0; i < n; ++i) {
+    ts += 20000u + rng() % 20000u;
+    const uint32_t r = rng() % 100u;
+    if      (r < 5u)  s[i] = (sample_t){ (uint16_t)(2u + rng() % 399u), ts };   // 튀는 값
+    else if (r < 15u) s[i] = (sample_t){ s[i ? i - 1u : 0u].cm, last_ts };      // 프레임 타임아웃 재사용
+    else {
+      d += (int32_t)(rng() % 7u) - 3;
+      if (d < 2) d = 2;
+      if (d > 400) d = 400;
+      s[i] = (sample_t){ (uint16_t)d, ts };
+      last_ts = ts;
+    }
+  }
+}
+
+static double now_s(void)
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t n = 2000000u;
+  s_rng = 1u;
+  for (int i = 1; i < argc; ++i) {
+    if      (!strcmp(argv[i], "-n") && i + 1 < argc) n = (uint32_t)strtoul(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-s") && i + 1 < argc) s_rng = (uint32_t)strtoul(argv[++i], NULL, 0) | 1u;
+    else { fprintf(stderr, "usage: %s [-n samples] [-s seed]\n", argv[0]); return 2; }
+  }
+
+  sample_t *s = malloc((size_t)n * sizeof *s);
+  if (s == NULL || n == 0u) return 1;
+  make_samples(s, n);
+
+  printf("win   ref ns   slide ns   ratio  match\n");
+  bool all = true;
+  for (uint8_t win = 3u; win <= US_MED_WIN_MAX; ++win) {
+    ref_median_t ref;
+    us_median_t  med;
+    uint32_t sum_ref = 0, sum_med = 0, t_ref, t_med;
+    bool same = true;
+
+    // 일치 검사 (시간 재는 루프와 따로)
+    ref_init(&ref, win, 400u, 0u);
+    US_MedInit(&med, win, 400u, 0u);
+    for (uint32_t i = 0; i < n; ++i) {
+      const uint16_t a = ref_push(&ref, s[i].cm, s[i].ts, &t_ref);
+      const uint16_t b = US_MedPush(&med, s[i].cm, s[i].ts, &t_med);
+      if (a != b || t_ref != t_med) { same = false; break; }
+    }
+
+    ref_init(&ref, win, 400u, 0u);
+    double t0 = now_s();
+    for (uint32_t i = 0; i < n; ++i) sum_ref += ref_push(&ref, s[i].cm, s[i].ts, &t_ref) + t_ref;
+    const double dt_ref = now_s() - t0;
+
+    US_MedInit(&med, win, 400u, 0u);
+    t0 = now_s();
+    for (uint32_t i = 0; i < n; ++i) sum_med += US_MedPush(&med, s[i].cm, s[i].ts, &t_med) + t_med;
+    const double dt_med = now_s() - t0;
+
+    same = same && (sum_ref == sum_med);
+    all = all && same;
+    printf("%3u  %7.1f  %9.1f  %6.2f  %s\n", win, dt_ref * 1e9 / n, dt_med * 1e9 / n,
+           dt_med > 0.0 ? dt_ref / dt_med : 0.0, same ? "yes" : "NO");
+  }
+  free(s);
+  return all ? 0 : 4;
+}
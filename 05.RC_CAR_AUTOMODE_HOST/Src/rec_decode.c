@@ -0,0 +1,46 @@
+/*
+ * rec_decode.c — 주행 기록(바이너리) → CSV
+ *
+ *  사용법: rec_decode rec.bin [-o out.csv]
+ *   기본 출력은 stdout, 요약(레코드 수 / 재동기 바이트 / seq 드롭)은 stderr
+ */
+
+#include "rec_log.h"
+
+#include <stdio.h>
+#include <string.h>
+
+int main(int argc, char **argv)
+{
+  const char *in = NULL, *out = NULL;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "-o") && i + 1 < argc) out = argv[++i];
+    else if (argv[i][0] != '-' && in == NULL) in = argv[i];
+    else { in = NULL; break; }
+  }
+  if (in == NULL) {
+    fprintf(stderr, "usage: %s rec.bin [-o out.csv]\n", argv[0]);
+    return 2;
+  }
+
+  static RecReader_t rd;
+  if (!RecReader_Open(&rd, in)) return 1;
+  FILE *f = out ? fopen(out, "w") : stdout;
+  if (f == NULL) { perror(out); return 1; }
+
+  // 센서 열은 L,C,R 순서로 (레코드 안은 us_idx_t L,R,C)
+  fprintf(f, "seq,tick,echoL,echoC,echoR,L,C,R,state,mode,dir,flags,vL,vC,vR,ccr1_right,ccr2_left\n");
+  rec_t r;
+  while (RecReader_Next(&rd, &r)) {
+    fprintf(f, "%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%d,%u,%d,%d,%d,%u,%u\n",
+            r.seq, r.tick, r.echo_us[0], r.echo_us[2], r.echo_us[1],
+            r.dist_cm[0], r.dist_cm[2], r.dist_cm[1],
+            r.state, r.mode, r.dir, r.flags, r.vL, r.vC, r.vR, r.ccr1, r.ccr2);
+  }
+  if (out) fclose(f);
+
+  fprintf(stderr, "records %u  skipped %u B  seq gaps %u (%u lost)  format v%u %u B\n",
+          rd.records, rd.skipped, rd.seq_gaps, rd.seq_lost, rd.version, rd.size);
+  RecReader_Close(&rd);
+  return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * rec_log.c — 주행 기록 파일 읽기 (재동기 + CRC 검사)
+ */
+
+#include "rec_log.h"
+#include <stddef.h>
+#include <string.h>
+
+bool RecReader_Open(RecReader_t *rd, const char *path)
+{
+  memset(rd, 0, sizeof *rd);
+  rd->f = fopen(path, "rb");
+  if (rd->f == NULL) { perror(path); return false; }
+  return true;
+}
+
+void RecReader_Close(RecReader_t *rd)
+{
+  if (rd->f) fclose(rd->f);
+  rd->f = NULL;
+}
+
+// 버퍼에 최소 need 바이트 확보 (남은 건 앞으로 당김)
+static bool fill(RecReader_t *rd, uint32_t need)
+{
+  if (rd->len - rd->pos >= need) return true;
+  memmove(rd->buf, rd->buf + rd->pos, rd->len - rd->pos);
+  rd->len -= rd->pos; rd->pos = 0;
+  rd->len += (uint32_t)fread(rd->buf + rd->len, 1, sizeof rd->buf - rd->len, rd->f);
+  return rd->len >= need;
+}
+
+// v1/v2 (32B): vL/vR 없음, vC 뒤에 바로 ccr1/ccr2/crc
+typedef struct {
+  uint8_t  sync;
+  uint8_t  version;
+  uint16_t seq;
+  uint32_t tick;
+  uint16_t echo_us[3];
+  uint16_t dist_cm[3];
+  uint8_t  state;
+  uint8_t  mode;
+  int8_t   dir;
+  uint8_t  flags;
+  int16_t  vC;
+  uint16_t ccr1;
+  uint16_t ccr2;
+  uint16_t crc;
+} rec_v2_t;
+
+_Static_assert(sizeof(rec_v2_t) == 32, "v1/v2 record layout");
+
+static uint32_t rec_size(uint8_t version)
+{
+  switch (version) {
+    case 1: case 2:    return sizeof(rec_v2_t);
+    case REC_VERSION:  return sizeof(rec_t);
+    default:           return 0;
+  }
+}
+
+// 버전별 → rec_t (없는 필드는 "신뢰도 없음": vL/vR = 0, READY 플래그 꺼짐)
+static bool decode(const uint8_t *p, rec_t *out)
+{
+  if (p[1] == REC_VERSION) {
+    memcpy(out, p, sizeof *out);
+    return out->crc == Rec_Crc16(out, offsetof(rec_t, crc));
+  }
+  rec_v2_t o;
+  memcpy(&o, p, sizeof o);
+  if (o.crc != Rec_Crc16(&o, offsetof(rec_v2_t, crc))) return false;
+
+  *out = (rec_t){
+    .sync = o.sync, .version = o.version, .seq = o.seq, .tick = o.tick,
+    .state = o.state, .mode = o.mode, .dir = o.dir,
+    .flags = (uint8_t)(o.flags & (o.version == 1u ? (REC_F_BUMP | REC_F_STARTUP)   // v1 vC 는 ΔC [cm/주기]
+                                                  : (REC_F_BUMP | REC_F_STARTUP | REC_F_VC_READY | REC_F_WOBBLE))),
+    .vC = o.vC, .ccr1 = o.ccr1, .ccr2 = o.ccr2,
+  };
+  memcpy(out->echo_us, o.echo_us, sizeof out->echo_us);
+  memcpy(out->dist_cm, o.dist_cm, sizeof out->dist_cm);
+  out->crc = Rec_Crc16(out, offsetof(rec_t, crc));
+  return true;
+}
+
+bool RecReader_Next(RecReader_t *rd, rec_t *out)
+{
+  while (fill(rd, 2u)) {
+    const uint8_t  *p    = rd->buf + rd->pos;
+    const uint32_t  size = (p[0] == REC_SYNC) ? rec_size(p[1]) : 0u;
+    if (size != 0u && fill(rd, size)) {
+      p = rd->buf + rd->pos;   // fill 이 당겼을 수 있음
+      if (decode(p, out)) {
+        rd->pos += size;
+        rd->records++;
+        rd->version = out->version;
+        rd->size    = (uint8_t)size;
+        if (rd->have_seq && out->seq != (uint16_t)(rd->last_seq + 1u)) {
+          rd->seq_gaps++;
+          rd->seq_lost += (uint16_t)(out->seq - rd->last_seq - 1u);
+        }
+        rd->have_seq = true;
+        rd->last_seq = out->seq;
+        return true;
+      }
+    }
+    rd->pos++;
+    rd->skipped++;
+  }
+  rd->skipped += rd->len - rd->pos;
+  rd->pos = rd->len;
+  return false;
+}
@@ -0,0 +1,221 @@
+/*
+ * replay_main.c — 주행 기록 재생 (automode.c 회귀 검사)
+ *
+ *  사용법: replay rec.bin [-s ms] [-o diff.csv] [-p NAME=VAL ...] [-q]
+ *   -s  처음 ms 동안은 비교 안 함 (중간부터 받은 기록 / rec dump — 그 전 상태를 모름)
+ *   -o  주기마다 입력 + 기록/재생 출력 CSV
+ *   -p  튜닝 파라미터 (차에서 쓰던 값, 기본은 param.c 기본값)
+ *   -q  한 줄 요약만
+ *
+ *  기록의 필터 거리(dist_cm)를 US_*_cm 으로, 추적 속도(vL/vR/vC)와 신뢰/흔들림 플래그를 프레임으로 그대로 넣고, HAL_GetTick 은 기록의 tick 으로 맞춰서
+ *  AutoMode_Start / AutoMode_Update 를 다시 돌린 뒤 CCR1/CCR2, state/mode/dir 를 기록과 비교한다.
+ *  ultrasonic.c / 센서 모델 / 태스크 없이 제어 주기만 돌리므로 1시간 기록도 1초 안쪽.
+ *
+ *  seq 가 끊긴 곳(송출 드롭)은 직전 입력을 유지한 채 빠진 주기 수만큼 tick 을 나눠 채운다
+ *  → 그 뒤 불일치는 "after gap" 으로 표시 (입력을 몰라서 생긴 것일 수 있음)
+ *
+ *  종료 코드: 0 = 전 구간 일치, 4 = 불일치, 1/2 = 파일/인자 오류
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "sim_hal.h"
+#include "sim_board.h"
+#include "rec_log.h"
+#include "ultrasonic.h"
+#include "automode.h"
+#include "move.h"
+#include "param.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ==== ultrasonic.c 대역: 기록에서 읽은 값을 그대로 돌려줌 ====
+static uint16_t s_cm[3];     // us_idx_t 순서 [L,R,C]
+static uint16_t s_echo[3];
+static int16_t  s_v[3];      // 추적 속도 [cm/s] [L,R,C]
+static uint8_t  s_flags;     // REC_F_VC_READY / REC_F_WOBBLE / REC_F_VL_READY / REC_F_VR_READY
+
+uint16_t US_Left_cm(void)   { return s_cm[0]; }
+uint16_t US_Right_cm(void)  { return s_cm[1]; }
+uint16_t US_Center_cm(void) { return s_cm[2]; }
+void US_GetEcho_us(uint16_t out[3])     { memcpy(out, s_echo, sizeof s_echo); }
+void US_GetFiltered_cm(uint16_t out[3]) { memcpy(out, s_cm, sizeof s_cm); }
+void US_GetFrame(us_frame_t *f)
+{
+  static uint32_t seq = 0;
+  *f = (us_frame_t){ .seq = ++seq };
+  memcpy(f->cm, s_cm, sizeof s_cm);
+  memcpy(f->echo_us, s_echo, sizeof s_echo);
+  // automode 는 신뢰도를 VC_CONF_MIN 과만 비교 → 넘었으면 100, 아니면 0
+  memcpy(f->rate_cms, s_v, sizeof s_v);
+  f->conf[US_L]     = (s_flags & REC_F_VL_READY) ? 100u : 0u;
+  f->conf[US_R]     = (s_flags & REC_F_VR_READY) ? 100u : 0u;
+  f->conf[US_C]     = (s_flags & REC_F_VC_READY) ? 100u : 0u;
+  f->wobble         = (s_flags & REC_F_WOBBLE) ? (uint8_t)(1u << US_C) : 0u;
+}
+void US_Command(const char *arg)       { (void)arg; }
+void US_SetDriveHint(int16_t vC, us_drive_t drive, int8_t dir) { (void)vC; (void)drive; (void)dir; }
+
+// ==== 재생 출력 (AutoMode_Update 끝에서 Rec_Frame 이 남긴 레코드) ====
+static rec_t s_out;
+
+typedef struct {
+  uint32_t compared;
+  uint32_t filled;           // seq 드롭으로 채운 주기
+  uint32_t mismatches;
+  bool     diverged;
+  bool     after_gap;
+  rec_t    first, prev;
+} replay_t;
+
+static double wall_seconds(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static bool same_output(const rec_t *a, const rec_t *b)
+{
+  return a->ccr1 == b->ccr1 && a->ccr2 == b->ccr2 &&
+         a->state == b->state && a->mode == b->mode && a->dir == b->dir;
+}
+
+// 한 주기: t_ms 로 시계를 맞추고 입력 넣고 Update
+static void step(uint64_t t_ms, const rec_t *in)
+{
+  SimHal_AdvanceTo(t_ms * 1000u);
+  memcpy(s_cm, in->dist_cm, sizeof s_cm);
+  memcpy(s_echo, in->echo_us, sizeof s_echo);
+  s_v[US_L] = in->vL;
+  s_v[US_R] = in->vR;
+  s_v[US_C] = in->vC;
+  s_flags = in->flags;
+  AutoMode_Update();
+  Rec_Last(&s_out);
+}
+
+static void print_rec(const char *tag, const rec_t *in, const rec_t *o)
+{
+  printf("  %-4s tick %-8u L=%-3u C=%-3u R=%-3u  state %u mode %u dir %+d  CCR1(R)=%-4u CCR2(L)=%-4u vC %d\n",
+         tag, in->tick, in->dist_cm[0], in->dist_cm[2], in->dist_cm[1],
+         o->state, o->mode, o->dir, o->ccr1, o->ccr2, o->vC);
+}
+
+int main(int argc, char **argv)
+{
+  const char *log = NULL, *csv = NULL;
+  uint32_t    skip_ms = 0;
+  bool        quiet = false;
+  const char *params[SIM_PARAM_MAX];
+  int         np = 0;
+
+  for (int i = 1; i < argc; ++i) {
+    if      (!strcmp(argv[i], "-s") && i + 1 < argc) skip_ms = (uint32_t)strtoul(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-o") && i + 1 < argc) csv = argv[++i];
+    else if (!strcmp(argv[i], "-q")) quiet = true;
+    else if (!strcmp(argv[i], "-p") && i + 1 < argc && np < (int)SIM_PARAM_MAX) params[np++] = argv[++i];
+    else if (argv[i][0] != '-' && log == NULL) log = argv[i];
+    else { log = NULL; break; }
+  }
+  if (log == NULL) {
+    fprintf(stderr, "usage: %s rec.bin [-s ms] [-o diff.csv] [-p NAME=VAL ...] [-q]\n", argv[0]);
+    return 2;
+  }
+
+  static RecReader_t rd;
+  if (!RecReader_Open(&rd, log)) return 1;
+  FILE *f = NULL;
+  if (csv) {
+    f = fopen(csv, "w");
+    if (f == NULL) { perror(csv); return 1; }
+    fprintf(f, "seq,tick,L,C,R,state,mode,dir,ccr1_right,ccr2_left,r_state,r_mode,r_dir,r_ccr1,r_ccr2,match\n");
+  }
+
+  // main.c 순서: MX_*_Init → Param_Init → motor_init → (태스크) AutoMode_Start
+  SimHal_Reset();
+  SimHal_SetUartEcho(false);
+  Param_Init();
+  motor_init();
+  if (!SimBoard_SetParams(params, np)) return 2;
+
+  replay_t rp = {0};
+  rec_t    r;
+  uint64_t t_ms = 0, t0_ms = 0;   // tick 을 64bit 로 펼침 (49일 wrap)
+  bool     started = false;
+
+  const double w0 = wall_seconds();
+  while (RecReader_Next(&rd, &r)) {
+    if (!started) {
+      t_ms = t0_ms = r.tick;
+      if (r.seq != 0 && !quiet)
+        fprintf(stderr, "replay: log starts at seq %u (state before it is unknown, consider -s)\n", r.seq);
+      SimHal_AdvanceTo(t_ms * 1000u);
+      memcpy(s_cm, r.dist_cm, sizeof s_cm);
+      AutoMode_Start();
+      started = true;
+    } else {
+      const uint64_t next_ms = t_ms + (uint32_t)(r.tick - (uint32_t)t_ms);
+      const uint16_t lost = (uint16_t)(r.seq - rp.prev.seq - 1u);
+      for (uint16_t k = 1; k <= lost; ++k) {      // 빠진 주기: 직전 입력 유지, tick 은 균등 분배
+        step(t_ms + (next_ms - t_ms) * k / (lost + 1u), &rp.prev);
+        rp.filled++;
+      }
+      if (lost) rp.after_gap = true;
+      t_ms = next_ms;
+      if ((r.flags & REC_F_STARTUP) && !(rp.prev.flags & REC_F_STARTUP)) {   // 콘솔 stop → go: 보드도 새로 시작
+        SimHal_AdvanceTo(t_ms * 1000u);
+        AutoMode_Start();
+      }
+    }
+
+    step(t_ms, &r);
+
+    const bool cmp = (t_ms - t0_ms) >= skip_ms;
+    const bool ok  = same_output(&r, &s_out);
+    if (cmp) {
+      rp.compared++;
+      if (!ok) {
+        rp.mismatches++;
+        if (!rp.diverged) {
+          rp.diverged = true;
+          rp.first = r;
+          if (!quiet) {
+            printf("first divergence at seq %u tick %u (%.3f s into log)%s\n", r.seq, r.tick,
+                   (double)(t_ms - t0_ms) / 1000.0, rp.after_gap ? " after gap" : "");
+            if (rp.compared > 1) print_rec("prev", &rp.prev, &rp.prev);
+            print_rec("car", &r, &r);
+            print_rec("sim", &r, &s_out);
+          }
+        }
+      }
+    }
+    if (f) {
+      fprintf(f, "%u,%u,%u,%u,%u,%u,%u,%d,%u,%u,%u,%u,%d,%u,%u,%d\n",
+              r.seq, r.tick, r.dist_cm[0], r.dist_cm[2], r.dist_cm[1],
+              r.state, r.mode, r.dir, r.ccr1, r.ccr2,
+              s_out.state, s_out.mode, s_out.dir, s_out.ccr1, s_out.ccr2, cmp ? ok : -1);
+    }
+    rp.prev = r;
+  }
+  const double w1 = wall_seconds();
+  if (f) fclose(f);
+  RecReader_Close(&rd);
+
+  if (!started) { fprintf(stderr, "replay: no valid records in %s\n", log); return 1; }
+
+  const double vsec = (double)(t_ms - t0_ms) / 1000.0;
+  if (!quiet) {
+    printf("records  %u (skipped %u B, %u seq gaps / %u lost, %u cycles filled)\n",
+           rd.records, rd.skipped, rd.seq_gaps, rd.seq_lost, rp.filled);
+    printf("compare  %u cycles, %u mismatched\n", rp.compared, rp.mismatches);
+  }
+  printf("%s %s records=%u gaps=%u compared=%u mismatch=%u",
+         log, rp.diverged ? "DIVERGED" : "match", rd.records, rd.seq_gaps, rp.compared, rp.mismatches);
+  if (rp.diverged) printf(" first_seq=%u first_tick=%u", rp.first.seq, rp.first.tick);
+  printf(" log=%.1fs wall=%.4f x%.0f\n", vsec, w1 - w0, (w1 > w0) ? vsec / (w1 - w0) : 0.0);
+  return rp.diverged ? 4 : 0;
+}
@@ -0,0 +1,268 @@
+/*
+ * sim_board.c — 보드 배선 + 태스크 구성
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "sim_board.h"
+#include "sim_variant.h"
+#include "cmsis_os2.h"
+#include "ultrasonic.h"
+#include "automode.h"
+#include "move.h"
+#if SIM_HAS_PARAM
+#include "param.h"
+#endif
+#if SIM_HAS_REC
+#include "recorder.h"
+#endif
+#if SIM_HAS_RANGE
+#include "us_range.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static inline uint64_t host_cycles(void) { return __rdtsc(); }
+#else
+#include <time.h>
+static inline uint64_t host_cycles(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+static const SimSonarWiring_t WIRING[SIM_US_NUM] = {
+  [SIM_US_LEFT]   = { TRIG_PORT_LEFT,   TRIG_PIN_LEFT,   &htim4, TIM_CHANNEL_2 },
+  [SIM_US_RIGHT]  = { TRIG_PORT_RIGHT,  TRIG_PIN_RIGHT,  &htim4, TIM_CHANNEL_1 },
+  [SIM_US_CENTER] = { TRIG_PORT_CENTER, TRIG_PIN_CENTER, &htim4, TIM_CHANNEL_3 },
+};
+
+static SimBoardStats_t s_stats;
+
+// freertos.c 의 ultrasonic()/automode() 본문
+static void sonic_init(void) { SIM_US_INIT(); }
+static void sonic_step(void) { US_Update(); }
+static void auto_init(void)  { SIM_AUTO_INIT(); }
+
+static void auto_step(void)
+{
+  const uint64_t c0 = host_cycles();
+  AutoMode_Update();
+  const uint64_t dc = host_cycles() - c0;
+  s_stats.updates++;
+  s_stats.cycles += dc;
+  if (dc > s_stats.cycles_max) s_stats.cycles_max = dc;
+}
+
+static SimTask_t s_tasks[] = {
+  { .name = "sonic",       .init = sonic_init, .step = sonic_step, .delay_ms = SIM_US_MS,   .wait_ms = SIM_US_WAIT },
+  { .name = "autocontrol", .init = auto_init,  .step = auto_step,  .delay_ms = SIM_AUTO_MS },
+};
+
+void SimBoard_Init(SimRangeFn range_fn, void *ctx)
+{
+  SimHal_Reset();
+#if SIM_CAPTURE_DMA
+  // tim.c: CH1~3 양쪽 에지 / main.c: HAL_TIM_IC_Start (CC 인터럽트 없음, DMA 요청은 펌웨어가 켬)
+  TIM4->DIER &= ~(uint32_t)(TIM_IT_CC1 | TIM_IT_CC2 | TIM_IT_CC3);
+  __HAL_TIM_SET_CAPTUREPOLARITY(&htim4, TIM_CHANNEL_1, TIM_INPUTCHANNELPOLARITY_BOTHEDGE);
+  __HAL_TIM_SET_CAPTUREPOLARITY(&htim4, TIM_CHANNEL_2, TIM_INPUTCHANNELPOLARITY_BOTHEDGE);
+  __HAL_TIM_SET_CAPTUREPOLARITY(&htim4, TIM_CHANNEL_3, TIM_INPUTCHANNELPOLARITY_BOTHEDGE);
+#endif
+  SimSonar_Init(range_fn, ctx);
+  for (uint8_t i = 0; i < SIM_US_NUM; ++i) SimSonar_Attach(i, &WIRING[i]);
+
+  s_stats = (SimBoardStats_t){0};
+#if SIM_HAS_PARAM
+  Param_Init();       // main.c 와 같이 스케줄러 시작 전 (플래시 → 기본값)
+#endif
+#if SIM_HAS_REC
+  Rec_Init(&huart2);  // main.c: Param_UartStart 다음
+#endif
+  motor_init();
+  SimTask_Start(s_tasks, (uint8_t)(sizeof(s_tasks) / sizeof(s_tasks[0])));
+}
+
+void SimBoard_Run(uint32_t until_ms, SimTickFn tick_fn, void *ctx)
+{
+  SimTask_RunUntil(s_tasks, (uint8_t)(sizeof(s_tasks) / sizeof(s_tasks[0])), until_ms, tick_fn, ctx);
+}
+
+static int8_t dir_of(GPIO_TypeDef *fp, uint16_t fpin, GPIO_TypeDef *bp, uint16_t bpin)
+{
+  const bool f = HAL_GPIO_ReadPin(fp, fpin) == GPIO_PIN_SET;
+  const bool b = HAL_GPIO_ReadPin(bp, bpin) == GPIO_PIN_SET;
+  return (f == b) ? 0 : (f ? +1 : -1);
+}
+
+int8_t SimBoard_RightDir(void) { return dir_of(IN1_GPIO_PORT, IN1_PIN, IN2_GPIO_PORT, IN2_PIN); }
+int8_t SimBoard_LeftDir(void)  { return dir_of(IN3_GPIO_PORT, IN3_PIN, IN4_GPIO_PORT, IN4_PIN); }
+
+SimDrive_t SimBoard_Drive(void)
+{
+  const int8_t r = SimBoard_RightDir(), l = SimBoard_LeftDir();
+  if (r == 0 && l == 0)  return SIM_DRIVE_STOP;
+  if (r < 0 && l < 0)    return SIM_DRIVE_REVERSE;
+  if (r <= 0 || l <= 0)  return SIM_DRIVE_PIVOT;
+
+  const uint32_t cr = SimHal_PwmRight(), cl = SimHal_PwmLeft();
+  const uint32_t diff = (cr > cl) ? cr - cl : cl - cr;
+  return (diff < SIM_DRIVE_ARC_DIFF) ? SIM_DRIVE_STRAIGHT : SIM_DRIVE_ARC;
+}
+
+const char *SimBoard_DriveName(SimDrive_t d)
+{
+  static const char *const NAME[SIM_DRIVE_NUM] = { "straight", "arc", "pivot", "reverse", "stop" };
+  return (d < SIM_DRIVE_NUM) ? NAME[d] : "?";
+}
+
+void SimBoard_ReadCm(uint16_t cm[SIM_US_NUM])
+{
+  uint16_t l = 0, c = 0, r = 0;
+  SIM_READ_CM(l, c, r);
+  cm[SIM_US_LEFT] = l; cm[SIM_US_CENTER] = c; cm[SIM_US_RIGHT] = r;
+}
+
+const SimBoardStats_t *SimBoard_Stats(void)
+{
+  s_stats.sonic_runs = s_tasks[0].runs;
+  return &s_stats;
+}
+
+#if SIM_HAS_REC
+// bluetooth.c 의 HAL_UART_TxCpltCallback (bluetooth.c 는 호스트 빌드에 없음)
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+  if (huart->Instance == USART2) Rec_UartTxCplt(huart);
+}
+
+static void rec_sink(const uint8_t *p, uint16_t n, void *ctx)
+{
+  fwrite(p, 1, n, (FILE *)ctx);
+}
+
+bool SimBoard_Record(FILE *f)
+{
+  SimHal_SetUartSink(&huart2, f ? rec_sink : NULL, f);
+  Rec_SetMode(f ? REC_STREAM : REC_RING);
+  return true;
+}
+#else
+bool SimBoard_Record(FILE *f)
+{
+  if (f) fprintf(stderr, "rec: this firmware tree has no recorder\n");
+  return f == NULL;
+}
+#endif
+
+#if SIM_HAS_SCHED
+// "seq", "pair,adapt" 처럼 쉼표로 여러 개
+bool SimBoard_Schedule(const char *name)
+{
+  char buf[32];
+  snprintf(buf, sizeof buf, "%s", name);
+  for (char *tok = strtok(buf, ","); tok; tok = strtok(NULL, ",")) {
+    if      (US_PolicyFind(tok) >= 0) US_SetSchedule((us_sched_t)US_PolicyFind(tok));
+    else if (!strcmp(tok, "adapt"))   US_SetAdaptiveGap(true);
+    else if (!strcmp(tok, "fixed"))   US_SetAdaptiveGap(false);
+    else if (!strncmp(tok, "med=", 4)) {
+      unsigned l, r, c;
+      if (sscanf(tok + 4, "%u/%u/%u", &l, &r, &c) != 3 || l > 255u || r > 255u || c > 255u ||
+          !US_SetMedianWin((const uint8_t[3]){ (uint8_t)l, (uint8_t)r, (uint8_t)c })) {
+        fprintf(stderr, "schedule: bad %s (med=L/R/C, 1..%u)\n", tok, US_MED_WIN_MAX);
+        return false;
+      }
+    }
+#if SIM_HAS_RANGE
+    else if (!strncmp(tok, "temp=", 5)) {
+      char *end;
+      const double t = strtod(tok + 5, &end);
+      if (end == tok + 5 || *end != '\0' || t * 10.0 < US_TEMP_DC_MIN || t * 10.0 > US_TEMP_DC_MAX ||
+          !US_RangeSetTemp((int16_t)(t * 10.0 + (t < 0.0 ? -0.5 : 0.5)))) {
+        fprintf(stderr, "schedule: bad %s (temp=C, %d..%d)\n", tok, US_TEMP_DC_MIN / 10, US_TEMP_DC_MAX / 10);
+        return false;
+      }
+    }
+#endif
+    else { fprintf(stderr, "schedule: unknown %s (seq|pair|risk|adapt|fixed|med=L/R/C|temp=C)\n", tok); return false; }
+  }
+  return true;
+}
+
+void SimBoard_SonarStatus(void) { US_Command(""); }
+#else
+bool SimBoard_Schedule(const char *name)
+{
+  fprintf(stderr, "schedule: this firmware tree has no trigger slots (%s)\n", name);
+  return false;
+}
+
+void SimBoard_SonarStatus(void) { }
+#endif
+
+#if SIM_HAS_RANGE
+bool SimBoard_ReadMm(uint16_t mm[SIM_US_NUM])
+{
+  us_frame_t f;
+  US_GetFrame(&f);
+  mm[SIM_US_LEFT] = f.mm[US_L]; mm[SIM_US_CENTER] = f.mm[US_C]; mm[SIM_US_RIGHT] = f.mm[US_R];
+  return true;
+}
+#else
+bool SimBoard_ReadMm(uint16_t mm[SIM_US_NUM])
+{
+  (void)mm;
+  return false;
+}
+#endif
+
+#if SIM_HAS_TS
+// main.c 의 HAL_TIM_PeriodElapsedCallback 중 TIM4 부분 (TIM10 HAL_IncTick 은 가상 클럭이 대신)
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+  if (htim->Instance == TIM4) US_TimOverflow();
+}
+
+// TIM4 는 가상 시각 0 에서 0 부터 세므로 펌웨어 타임스탬프 = 가상 µs 하위 32비트
+// (US_Now_us 는 CNT 폴링이 1µs 를 쓰므로 관찰용으로는 부르지 않음)
+bool SimBoard_ReadAge(uint32_t age_us[SIM_US_NUM])
+{
+  uint32_t ts[3];
+  US_GetStamp_us(ts);
+  const uint32_t now = (uint32_t)SimHal_Micros();
+  for (uint8_t i = 0; i < SIM_US_NUM; ++i) age_us[i] = now - ts[i];
+  return true;
+}
+#else
+bool SimBoard_ReadAge(uint32_t age_us[SIM_US_NUM])
+{
+  (void)age_us;
+  return false;
+}
+#endif
+
+#if SIM_HAS_FSM
+_Static_assert(SIM_FSM_MAX == FSM_STATE_MAX, "SIM_FSM_MAX 를 fsm.h 와 맞출 것");
+
+uint8_t SimBoard_FsmDwell(uint32_t ms[SIM_FSM_MAX], const char *name[SIM_FSM_MAX], uint32_t *trans)
+{
+  const Fsm_t *f = AutoMode_Fsm();
+  Fsm_Dwell(f, HAL_GetTick(), ms);
+  for (uint8_t i = 0; i < f->def->state_num; ++i) name[i] = f->def->state[i].name;
+  *trans = f->transitions;
+  return f->def->state_num;
+}
+#else
+uint8_t SimBoard_FsmDwell(uint32_t ms[SIM_FSM_MAX], const char *name[SIM_FSM_MAX], uint32_t *trans)
+{
+  (void)ms; (void)name;
+  *trans = 0;
+  return 0;
+}
+#endif
@@ -0,0 +1,132 @@
+/*
+ * sim_car.c — 차동구동 섀시 + HC-SR04 빔 모델
+ */
+
+#include "sim_car.h"
+#include <math.h>
+
+#define DEG2RAD(d)  ((d) * 0.01745329252f)
+
+// 기본 장착 (차체 원점 = 바퀴축 중앙, +x 전방, +y 좌측)
+static const SimMount_t DEFAULT_MOUNT[SIM_US_NUM] = {
+  [SIM_US_LEFT]   = { true,  8.0f,  6.0f,  45.0f },
+  [SIM_US_RIGHT]  = { true,  8.0f, -6.0f, -45.0f },
+  [SIM_US_CENTER] = { true, 10.0f,  0.0f,   0.0f },
+};
+
+void SimCar_DefaultParams(SimCarParams_t *p)
+{
+  p->vmax_cms          = 200.0f;
+  p->dead_duty         = 0.20f;
+  p->tau_s             = 0.10f;
+  p->track_cm          = 40.0f;   // 4륜 스키드 조향: 피벗 시 미끄럼 → 실측 바퀴 간격(15cm)보다 크게
+  p->radius_cm         = 10.0f;
+  p->cone_half_deg     = 15.0f;
+  p->max_incidence_deg = 45.0f;
+  p->max_range_cm      = 400.0f;
+}
+
+void SimCar_Init(SimCar_t *car, const SimTrack_t *trk, const SimCarParams_t *p)
+{
+  *car = (SimCar_t){0};
+  car->trk = trk;
+  car->p   = *p;
+  for (uint8_t i = 0; i < SIM_US_NUM; ++i) {
+    car->mount[i] = trk->mount[i].set ? trk->mount[i] : DEFAULT_MOUNT[i];
+  }
+  car->pos     = trk->start;
+  car->heading = DEG2RAD(trk->start_heading_deg);
+  car->min_clear_cm = SimTrack_Clearance(trk, car->pos, NULL) - p->radius_cm;
+  car->last_ms = HAL_GetTick();
+  car->lap_start_ms = car->last_ms;
+}
+
+static float wheel_target(const SimCarParams_t *p, int8_t dir, uint32_t ccr)
+{
+  float duty = (float)ccr / (float)(SimHal_PwmPeriod() + 1u);
+  float k = (duty - p->dead_duty) / (1.0f - p->dead_duty);
+  if (k < 0.0f) k = 0.0f; else if (k > 1.0f) k = 1.0f;
+  return (float)dir * p->vmax_cms * k;
+}
+
+static void step_1ms(SimCar_t *car, uint32_t now_ms)
+{
+  const SimCarParams_t *p = &car->p;
+  const float dt = 0.001f;
+  const float a  = 1.0f - expf(-dt / p->tau_s);
+
+  car->v_right += (wheel_target(p, SimBoard_RightDir(), SimHal_PwmRight()) - car->v_right) * a;
+  car->v_left  += (wheel_target(p, SimBoard_LeftDir(),  SimHal_PwmLeft())  - car->v_left)  * a;
+
+  const float v = 0.5f * (car->v_left + car->v_right);
+  const float w = (car->v_right - car->v_left) / p->track_cm;
+
+  car->heading += w * dt;
+  SimVec_t next = { car->pos.x + v * cosf(car->heading) * dt,
+                    car->pos.y + v * sinf(car->heading) * dt };
+
+  SimVec_t away;
+  float clear = SimTrack_Clearance(car->trk, next, &away) - p->radius_cm;
+  if (clear < car->min_clear_cm) car->min_clear_cm = clear;
+
+  if (clear < 0.0f) {
+    // 벽 관통 → 법선 방향으로 밀어내 벽을 긁으며 미끄러지게 (정면 충돌이면 사실상 정지)
+    next.x -= away.x * clear;
+    next.y -= away.y * clear;
+    if (SimTrack_Clearance(car->trk, next, NULL) < p->radius_cm - 0.01f) next = car->pos;  // 코너 끼임
+    if (!car->in_contact) car->contacts++;
+    car->in_contact = true;
+    car->contact_ms++;
+  } else {
+    car->in_contact = false;
+  }
+
+  if (SimTrack_Crossed(car->trk, car->gate_next, car->pos, next)) {
+    if (++car->gate_next >= car->trk->gate_num) {
+      if (car->laps < SIM_CAR_MAX_LAPS) car->lap_ms[car->laps] = now_ms - car->lap_start_ms;
+      car->laps++;
+      car->lap_start_ms = now_ms;
+      car->gate_next = 0;
+    }
+  }
+
+  car->dist_cm += fabsf(v) * dt;
+  car->pos = next;
+}
+
+void SimCar_Step(SimCar_t *car, uint32_t now_ms)
+{
+  while ((int32_t)(now_ms - car->last_ms) > 0) {
+    car->last_ms++;
+    step_1ms(car, car->last_ms);
+  }
+}
+
+float SimCar_Range(uint8_t idx, uint64_t t_us, void *ctx)
+{
+  SimCar_t *car = (SimCar_t *)ctx;
+  if (idx >= SIM_US_NUM) return -1.0f;
+
+  // 트리거 시점까지 차체 위치 갱신
+  SimCar_Step(car, (uint32_t)(t_us / 1000u));
+
+  const SimMount_t *m = &car->mount[idx];
+  const float c = cosf(car->heading), s = sinf(car->heading);
+  const SimVec_t o = { car->pos.x + m->x * c - m->y * s,
+                       car->pos.y + m->x * s + m->y * c };
+
+  const float min_cos = cosf(DEG2RAD(car->p.max_incidence_deg));
+  const float base = car->heading + DEG2RAD(m->angle_deg);
+  const float half = DEG2RAD(car->p.cone_half_deg);
+  float best = -1.0f;
+
+  for (uint8_t k = 0; k < SIM_CAR_CONE_RAYS; ++k) {
+    float ang = base - half + (2.0f * half) * (float)k / (float)(SIM_CAR_CONE_RAYS - 1u);
+    SimVec_t d = { cosf(ang), sinf(ang) };
+    float cos_inc;
+    float r = SimTrack_Ray(car->trk, o, d, car->p.max_range_cm, &cos_inc);
+    if (r < 0.0f || cos_inc < min_cos) continue;
+    if (best < 0.0f || r < best) best = r;
+  }
+  return best;
+}
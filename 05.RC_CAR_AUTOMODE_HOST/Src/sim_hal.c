@@ -0,0 +1,654 @@
+/*
+ * sim_hal.c — HAL 대역 구현 (가상 클럭 + TIM/GPIO 레지스터 모델)
+ *
+ *  - TIM4: 1MHz(PSC=99), ARR=65535, CH1~3 입력캡처 → 엣지 시 CCRx 래치 + (CCxDE 면) DMA 하프워드 + (CCxIE 면) 콜백
+ *          CH4 출력 비교 (핀 없음) → CNT == CCR4 마다 CC4 플래그 + (CC4IE 면) OC 콜백
+ *  - TIM11: 1MHz 프리런 (delay_us busy-wait 용)
+ *  - TIM3: PWM, CCR1=Right / CCR2=Left 만 관측
+ *  - TIM1: 1MHz, CC1/CC2 매치 → DMA 1워드 → GPIO BSRR (TRIG 펄스), OPM 이면 업데이트에서 CEN 해제
+ *  - FLASH: Sector 7 하나만 RAM 배열로 (param.c 저장 블록)
+ *  - UART DMA 송신: 8N1 바이트당 10비트 시간 뒤 TxCplt (USART1 9600 / USART2 115200)
+ *  - 실제 FreeRTOS/NVIC 는 없음: 캡처 콜백은 엣지 시점에 즉시(선점) 실행
+ */
+
+#include "sim_hal.h"
+#include "main.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_TIMCLK_HZ   100000000ull   // APB1 타이머 클럭 (SystemClock_Config 기준)
+#define SIM_HCLK_MHZ    100u           // 코어 클럭
+
+GPIO_TypeDef  SimHal_GPIOA, SimHal_GPIOB, SimHal_GPIOC;
+TIM_TypeDef   SimHal_TIM1, SimHal_TIM3, SimHal_TIM4, SimHal_TIM11;
+USART_TypeDef SimHal_USART1, SimHal_USART2;
+
+TIM_HandleTypeDef  htim1;
+TIM_HandleTypeDef  htim3;
+TIM_HandleTypeDef  htim4;
+TIM_HandleTypeDef  htim11;
+UART_HandleTypeDef huart1;
+UART_HandleTypeDef huart2;
+DMA_HandleTypeDef  hdma_tim1_ch1;
+DMA_HandleTypeDef  hdma_tim1_ch2;
+DMA_HandleTypeDef  hdma_tim4_ch1;
+DMA_HandleTypeDef  hdma_tim4_ch2;
+DMA_HandleTypeDef  hdma_tim4_ch3;
+
+// ==== 가상 클럭/이벤트 ====
+typedef struct {
+  uint64_t   t_us;
+  uint32_t   seq;      // 동시각 이벤트는 예약 순서대로
+  SimEventFn fn;
+  void      *ctx;
+} sim_event_t;
+
+static uint64_t    s_now_us = 0;
+static bool        s_wake = false;      // ISR 가 태스크를 깨움 (SimHal_AdvanceToWake 중단)
+static sim_event_t s_ev[SIM_MAX_EVENTS];
+static uint8_t     s_ev_num = 0;
+static uint32_t    s_ev_seq = 0;
+static bool        s_dispatching = false;
+static uint32_t    s_tim4_irq = 0;      // TIM4 인터럽트 진입 수 (CC/업데이트 콜백 한 번 = 1)
+static uint32_t    s_dma_irq = 0;       // 캡처 DMA 인터럽트 진입 수 (하프/완료 한 번 = 1)
+
+// ==== 타이머 카운터 기준점 ====
+typedef struct {
+  TIM_HandleTypeDef *htim;
+  uint64_t           base_us;   // CNT=0 이 된 가상 시각
+  uint8_t            in_level;  // 캡처 입력 레벨 (bit0..3 = CH1..4)
+} sim_tim_t;
+
+static sim_tim_t s_tim[3];
+
+// TIM1 (TRIG 펄스): 카운터 시작 시각 + 세대 번호 (CEN 해제/재시작 시 예약된 매치 이벤트 무효화)
+static uint64_t s_tim1_base_us = 0;
+static uint32_t s_tim1_gen = 0;
+
+// TIM4 (에코 캡처): 카운터가 ARR 를 넘을 때마다 업데이트 (ultrasonic.c 타임스탬프 상위 비트)
+static void tim4_update(uint64_t t_us, void *ctx);
+// TIM4 CH4 비교 매치 (ultrasonic.c 에코 마감) — CCR4 를 쓸 때마다 다시 예약
+static void tim4_cc4(uint64_t t_us, void *ctx);
+
+// ==== GPIO 감시 ====
+typedef struct {
+  GPIO_TypeDef *port;
+  uint16_t      pin;
+  SimPinFn      fn;
+  void         *ctx;
+} sim_watch_t;
+
+static sim_watch_t s_watch[SIM_MAX_WATCHES];
+static uint8_t     s_watch_num = 0;
+
+static bool s_uart_echo = true;
+
+typedef struct {
+  uint32_t       baud;
+  bool           busy;           // DMA 송신 중 (gState BUSY_TX)
+  const uint8_t *p;
+  uint16_t       n;
+  SimUartSinkFn  sink;
+  void          *ctx;
+} sim_uart_t;
+
+static sim_uart_t s_uart[2];
+
+// ==== 유틸 ====
+static sim_tim_t *tim_of(TIM_HandleTypeDef *htim)
+{
+  for (uint8_t i = 0; i < 3; ++i) if (s_tim[i].htim == htim) return &s_tim[i];
+  return NULL;
+}
+
+static inline uint8_t ch_index(uint32_t channel) { return (uint8_t)(channel >> 2); }   // CH1..4 → 0..3
+
+static __IO uint32_t *ccr_of(TIM_TypeDef *tim, uint32_t channel)
+{
+  switch (channel) {
+    case TIM_CHANNEL_1: return &tim->CCR1;
+    case TIM_CHANNEL_2: return &tim->CCR2;
+    case TIM_CHANNEL_3: return &tim->CCR3;
+    default:            return &tim->CCR4;
+  }
+}
+
+static void tim_setup(TIM_HandleTypeDef *htim, TIM_TypeDef *inst, uint32_t psc, uint32_t arr)
+{
+  htim->Instance = inst;
+  htim->Init.Prescaler = psc;
+  htim->Init.Period    = arr;
+  htim->Channel        = HAL_TIM_ACTIVE_CHANNEL_CLEARED;
+  inst->PSC = psc;
+  inst->ARR = arr;
+}
+
+// ==== FLASH 저장소 ====
+// SimHal_Reset 은 최초 1회만 지움 → 같은 프로세스 안에서 save 후 재시작하면 load 됨
+_Alignas(8) uint8_t SimHal_Flash[SIM_FLASH_SECTOR_SIZE];   // param_block_t 로 캐스팅됨
+static bool s_flash_erased   = false;
+static bool s_flash_unlocked = false;
+
+static void flash_blank_once(void)
+{
+  if (s_flash_erased) return;
+  memset(SimHal_Flash, 0xFF, sizeof SimHal_Flash);
+  s_flash_erased = true;
+}
+
+// ==== 초기화 ====
+void SimHal_Reset(void)
+{
+  s_now_us = 0; s_ev_num = 0; s_ev_seq = 0; s_dispatching = false; s_wake = false;
+  s_watch_num = 0;
+
+  SimHal_GPIOA = (GPIO_TypeDef){0};
+  SimHal_GPIOB = (GPIO_TypeDef){0};
+  SimHal_GPIOC = (GPIO_TypeDef){0};
+  SimHal_TIM1  = (TIM_TypeDef){0};
+  SimHal_TIM3  = (TIM_TypeDef){0};
+  SimHal_TIM4  = (TIM_TypeDef){0};
+  SimHal_TIM11 = (TIM_TypeDef){0};
+
+  // tim.c MX_TIMx_Init 과 동일한 값
+  tim_setup(&htim1,  TIM1,  100 - 1, 12 - 1);
+  tim_setup(&htim3,  TIM3,  65,      1009);
+  tim_setup(&htim4,  TIM4,  100 - 1, 65535);
+  tim_setup(&htim11, TIM11, 100 - 1, 65535);
+  s_tim[0] = (sim_tim_t){ &htim3,  0, 0 };
+  s_tim[1] = (sim_tim_t){ &htim4,  0, 0 };
+  s_tim[2] = (sim_tim_t){ &htim11, 0, 0 };
+
+  // main.c: PWM Pulse=700 시작, TIM4 CH1~3 IC_Start_IT
+  TIM3->CCR1 = 700; TIM3->CCR2 = 700;
+  TIM4->DIER = TIM_IT_CC1 | TIM_IT_CC2 | TIM_IT_CC3;
+  SimHal_Schedule((uint64_t)htim4.Init.Period + 1u, tim4_update, NULL);   // PSC=99 → 1µs/tick
+
+  // TIM1: one-pulse, CC1=1 / CC2=11, CC DMA 는 tim.c MspInit 처럼 연결만 (시작은 펌웨어)
+  TIM1->CR1  = TIM_CR1_OPM;
+  TIM1->CCR1 = 1; TIM1->CCR2 = 11;
+  hdma_tim1_ch1 = (DMA_HandleTypeDef){0};
+  hdma_tim1_ch2 = (DMA_HandleTypeDef){0};
+  htim1.hdma[TIM_DMA_ID_CC1] = &hdma_tim1_ch1;
+  htim1.hdma[TIM_DMA_ID_CC2] = &hdma_tim1_ch2;
+  s_tim1_base_us = 0; s_tim1_gen++;
+
+  // TIM4 CC1~3 DMA (tim.c MspInit: DMA1 Stream0/3/7, 주변장치 → 메모리 하프워드 순환) — 시작은 펌웨어
+  hdma_tim4_ch1 = (DMA_HandleTypeDef){ .p2m = 1 };
+  hdma_tim4_ch2 = (DMA_HandleTypeDef){ .p2m = 1 };
+  hdma_tim4_ch3 = (DMA_HandleTypeDef){ .p2m = 1 };
+  htim4.hdma[TIM_DMA_ID_CC1] = &hdma_tim4_ch1;
+  htim4.hdma[TIM_DMA_ID_CC2] = &hdma_tim4_ch2;
+  htim4.hdma[TIM_DMA_ID_CC3] = &hdma_tim4_ch3;
+  s_tim4_irq = 0;
+  s_dma_irq = 0;
+
+  huart1.Instance = USART1;
+  huart2.Instance = USART2;
+  s_uart[0] = (sim_uart_t){ .baud = 9600u };
+  s_uart[1] = (sim_uart_t){ .baud = 115200u };
+  flash_blank_once();
+}
+
+// ==== 가상 클럭 ====
+uint64_t SimHal_Micros(void) { return s_now_us; }
+
+// stop_on_wake: 이벤트(ISR)가 SimHal_Wake 를 부르면 그 시각에 멈춤 → false
+static bool advance(uint64_t t_us, bool stop_on_wake)
+{
+  if (t_us < s_now_us) return true;
+
+  // ISR 안에서 다시 불린 경우: 시계만 진행 (중첩 디스패치 금지)
+  if (s_dispatching) { s_now_us = t_us; return true; }
+
+  s_dispatching = true;
+  for (;;) {
+    int8_t k = -1;
+    for (uint8_t i = 0; i < s_ev_num; ++i) {
+      if (s_ev[i].t_us > t_us) continue;
+      if (k < 0 || s_ev[i].t_us < s_ev[k].t_us ||
+          (s_ev[i].t_us == s_ev[k].t_us && s_ev[i].seq < s_ev[k].seq)) k = (int8_t)i;
+    }
+    if (k < 0) break;
+
+    sim_event_t ev = s_ev[k];
+    s_ev[k] = s_ev[--s_ev_num];
+    if (ev.t_us > s_now_us) s_now_us = ev.t_us;
+    ev.fn(ev.t_us, ev.ctx);
+    if (stop_on_wake && s_wake) { s_dispatching = false; return false; }
+  }
+  s_now_us = t_us;
+  s_dispatching = false;
+  return true;
+}
+
+void SimHal_AdvanceTo(uint64_t t_us) { (void)advance(t_us, false); }
+
+bool SimHal_AdvanceToWake(uint64_t t_us)
+{
+  s_wake = false;
+  return advance(t_us, true);
+}
+
+void SimHal_Wake(void) { s_wake = true; }
+
+static DWT_Type s_dwt;
+CoreDebug_Type  SimHal_CoreDebug;
+uint32_t        SystemCoreClock = SIM_HCLK_MHZ * 1000000u;
+
+DWT_Type *SimHal_Dwt(void)
+{
+  s_dwt.CYCCNT = (uint32_t)(s_now_us * SIM_HCLK_MHZ);
+  return &s_dwt;
+}
+
+void SimHal_Spend(uint32_t us) { SimHal_AdvanceTo(s_now_us + us); }
+
+void SimHal_SpendCycles(uint32_t cyc)
+{
+  static uint32_t s_frac = 0;   // 1µs 미만 잔여 사이클
+  s_frac += cyc;
+  if (s_frac >= SIM_HCLK_MHZ) {
+    const uint32_t us = s_frac / SIM_HCLK_MHZ;
+    s_frac -= us * SIM_HCLK_MHZ;
+    SimHal_Spend(us);
+  }
+}
+
+bool SimHal_Schedule(uint64_t t_us, SimEventFn fn, void *ctx)
+{
+  if (s_ev_num >= SIM_MAX_EVENTS || fn == NULL) return false;
+  s_ev[s_ev_num++] = (sim_event_t){ t_us, s_ev_seq++, fn, ctx };
+  return true;
+}
+
+// 예약된 fn 이벤트를 모두 지움 (비교 레지스터를 다시 쓸 때 — 매치 시각이 바뀜)
+static void unschedule(SimEventFn fn)
+{
+  for (uint8_t i = 0; i < s_ev_num; ) {
+    if (s_ev[i].fn == fn) s_ev[i] = s_ev[--s_ev_num];
+    else ++i;
+  }
+}
+
+// ==== GPIO ====
+bool SimHal_WatchPin(GPIO_TypeDef *port, uint16_t pin, SimPinFn fn, void *ctx)
+{
+  if (s_watch_num >= SIM_MAX_WATCHES) return false;
+  s_watch[s_watch_num++] = (sim_watch_t){ port, pin, fn, ctx };
+  return true;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+  uint32_t old = GPIOx->ODR;
+  if (PinState != GPIO_PIN_RESET) GPIOx->ODR = old | GPIO_Pin;
+  else                            GPIOx->ODR = old & ~(uint32_t)GPIO_Pin;
+  if (old == GPIOx->ODR) return;
+
+  for (uint8_t i = 0; i < s_watch_num; ++i) {
+    if (s_watch[i].port == GPIOx && (s_watch[i].pin & GPIO_Pin)) {
+      s_watch[i].fn(GPIOx, GPIO_Pin, PinState, s_now_us, s_watch[i].ctx);
+    }
+  }
+}
+
+// BSRR 쓰기: 하위 16bit set, 상위 16bit reset (둘 다면 set 우선)
+static void gpio_bsrr(GPIO_TypeDef *GPIOx, uint32_t w)
+{
+  const uint16_t set = (uint16_t)w;
+  const uint16_t rst = (uint16_t)((w >> 16) & ~(uint32_t)set);
+  if (set) HAL_GPIO_WritePin(GPIOx, set, GPIO_PIN_SET);
+  if (rst) HAL_GPIO_WritePin(GPIOx, rst, GPIO_PIN_RESET);
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+  return ((GPIOx->IDR | GPIOx->ODR) & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+  HAL_GPIO_WritePin(GPIOx, GPIO_Pin, (GPIOx->ODR & GPIO_Pin) ? GPIO_PIN_RESET : GPIO_PIN_SET);
+}
+
+// ==== TIM ====
+static uint32_t tim_count(const sim_tim_t *t)
+{
+  const TIM_HandleTypeDef *h = t->htim;
+  uint64_t ticks = (s_now_us - t->base_us) * (SIM_TIMCLK_HZ / (h->Init.Prescaler + 1u)) / 1000000ull;
+  return (uint32_t)(ticks % ((uint64_t)h->Init.Period + 1u));
+}
+
+// 다음 CNT == CCR4 시각에 tim4_cc4 예약 (지금이 같은 값이면 한 바퀴 뒤)
+static void tim4_cc4_arm(void)
+{
+  unschedule(tim4_cc4);
+  const uint32_t cnt = tim_count(&s_tim[1]);
+  uint64_t d = (uint64_t)((TIM4->CCR4 - cnt) & htim4.Init.Period);
+  if (d == 0u) d = (uint64_t)htim4.Init.Period + 1u;
+  SimHal_Schedule(s_now_us + d, tim4_cc4, NULL);
+}
+
+void SimHal_TIM_SetCompare(TIM_HandleTypeDef *htim, uint32_t Channel, uint32_t Compare)
+{
+  *ccr_of(htim->Instance, Channel) = Compare;
+  if (htim == &htim4 && Channel == TIM_CHANNEL_4) tim4_cc4_arm();
+}
+
+uint32_t SimHal_TIM_GetCompare(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+  return *ccr_of(htim->Instance, Channel);
+}
+
+void SimHal_TIM_SetCounter(TIM_HandleTypeDef *htim, uint32_t Counter)
+{
+  sim_tim_t *t = tim_of(htim);
+  if (t == NULL) return;
+  uint64_t back = (uint64_t)Counter * 1000000ull / (SIM_TIMCLK_HZ / (htim->Init.Prescaler + 1u));
+  t->base_us = s_now_us - back;
+  htim->Instance->CNT = Counter;
+}
+
+// HAL_TIM_IRQHandler 흉내: UIF → (DIER UIE 면) 클리어 + 콜백, 다음 오버플로 예약
+static void tim4_update(uint64_t t_us, void *ctx)
+{
+  (void)ctx;
+  TIM4->SR |= TIM_FLAG_UPDATE;
+  if (TIM4->DIER & TIM_IT_UPDATE) {
+    s_tim4_irq++;
+    TIM4->SR &= ~TIM_FLAG_UPDATE;
+    HAL_TIM_PeriodElapsedCallback(&htim4);
+  }
+  SimHal_Schedule(t_us + (uint64_t)htim4.Init.Period + 1u, tim4_update, NULL);
+}
+
+// HAL_TIM_IRQHandler 흉내: CC4IF → (DIER CC4IE 면) 클리어 + Channel 설정 + OC 콜백, 한 바퀴 뒤 다시 매치
+static void tim4_cc4(uint64_t t_us, void *ctx)
+{
+  (void)ctx;
+  TIM4->SR |= TIM_FLAG_CC4;
+  SimHal_Schedule(t_us + (uint64_t)htim4.Init.Period + 1u, tim4_cc4, NULL);
+  if (TIM4->DIER & TIM_IT_CC4) {
+    s_tim4_irq++;
+    TIM4->SR &= ~TIM_FLAG_CC4;
+    htim4.Channel = HAL_TIM_ACTIVE_CHANNEL_4;
+    HAL_TIM_OC_DelayElapsedCallback(&htim4);
+    htim4.Channel = HAL_TIM_ACTIVE_CHANNEL_CLEARED;
+  }
+}
+
+static uint64_t tim1_tick_us(void);
+
+uint32_t SimHal_TIM_GetCounter(TIM_HandleTypeDef *htim)
+{
+  if (htim == &htim1) {   // TIM1 주기 안 위치 (자율 트리거 위상)
+    if (TIM1->CR1 & TIM_CR1_CEN) TIM1->CNT = (uint32_t)((s_now_us - s_tim1_base_us) / tim1_tick_us());
+    return TIM1->CNT;
+  }
+  sim_tim_t *t = tim_of(htim);
+  if (t == NULL) return 0;
+  SimHal_Spend(1);   // 폴링 1회 = 1µs (busy-wait 이 가상 시간을 소모하도록)
+  htim->Instance->CNT = tim_count(t);
+  return htim->Instance->CNT;
+}
+
+// ==== DMA (요청 1회 = 전송 1개, 순환 — 메모리 → 주변장치 워드, p2m 이면 주변장치 → 메모리 하프워드) ====
+HAL_StatusTypeDef HAL_DMA_Start(DMA_HandleTypeDef *hdma, uintptr_t SrcAddress, uintptr_t DstAddress, uint32_t DataLength)
+{
+  if (hdma->busy) return HAL_BUSY;
+  if (DataLength == 0u) return HAL_ERROR;
+  hdma->src = SrcAddress; hdma->dst = DstAddress;
+  hdma->len = DataLength; hdma->pos = 0;
+  hdma->busy = 1;
+  hdma->it = 0;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef *hdma, uintptr_t SrcAddress, uintptr_t DstAddress, uint32_t DataLength)
+{
+  const HAL_StatusTypeDef st = HAL_DMA_Start(hdma, SrcAddress, DstAddress, DataLength);
+  if (st == HAL_OK) hdma->it = 1;
+  return st;
+}
+
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef *hdma)
+{
+  if (!hdma->busy) return HAL_ERROR;
+  hdma->busy = 0;
+  return HAL_OK;
+}
+
+static void dma_request(DMA_HandleTypeDef *hdma)
+{
+  if (hdma == NULL || !hdma->busy) return;
+
+  if (hdma->p2m) {
+    uint16_t h = (uint16_t)*(const __IO uint32_t *)hdma->src;
+    memcpy((void *)(hdma->dst + 2u * hdma->pos), &h, 2);
+    hdma->pos = (hdma->pos + 1u) % hdma->len;
+    // HAL_DMA_IRQHandler 흉내: HTIF / TCIF → 콜백 (HT 는 콜백이 있을 때만 켜짐)
+    if (hdma->it && hdma->pos == hdma->len / 2u && hdma->XferHalfCpltCallback != NULL) {
+      s_dma_irq++;
+      hdma->XferHalfCpltCallback(hdma);
+    } else if (hdma->it && hdma->pos == 0u) {
+      s_dma_irq++;
+      if (hdma->XferCpltCallback != NULL) hdma->XferCpltCallback(hdma);
+    }
+    return;
+  }
+
+  uint32_t w;
+  memcpy(&w, (const void *)(hdma->src + 4u * hdma->pos), 4);
+  hdma->pos = (hdma->pos + 1u) % hdma->len;
+
+  GPIO_TypeDef *const ports[] = { GPIOA, GPIOB, GPIOC };
+  for (uint8_t i = 0; i < 3; ++i) {
+    if (hdma->dst == (uintptr_t)&ports[i]->BSRR) { gpio_bsrr(ports[i], w); return; }
+  }
+  memcpy((void *)hdma->dst, &w, 4);
+}
+
+// ==== TIM1: 카운터 한 주기(0..ARR) 동안의 CC1/CC2 매치 + 업데이트 예약 ====
+static void tim1_schedule(void);
+
+static uint64_t tim1_tick_us(void) { return (TIM1->PSC + 1u) / SIM_HCLK_MHZ; }   // APB2 100MHz, PSC=99 → 1µs
+
+static void tim1_cc(uint64_t t_us, void *ctx, uint8_t ci)
+{
+  (void)t_us;
+  if ((uint32_t)(uintptr_t)ctx != s_tim1_gen || !(TIM1->CR1 & TIM_CR1_CEN)) return;
+  TIM1->SR |= TIM_FLAG_CC1 << ci;
+  if (TIM1->DIER & (TIM_DMA_CC1 << ci)) dma_request(htim1.hdma[TIM_DMA_ID_CC1 + ci]);
+}
+
+static void tim1_cc1(uint64_t t_us, void *ctx) { tim1_cc(t_us, ctx, 0); }
+static void tim1_cc2(uint64_t t_us, void *ctx) { tim1_cc(t_us, ctx, 1); }
+
+static void tim1_update(uint64_t t_us, void *ctx)
+{
+  if ((uint32_t)(uintptr_t)ctx != s_tim1_gen || !(TIM1->CR1 & TIM_CR1_CEN)) return;
+  TIM1->SR |= TIM_FLAG_UPDATE;
+  if (TIM1->CR1 & TIM_CR1_OPM) { TIM1->CR1 &= ~TIM_CR1_CEN; s_tim1_gen++; return; }
+  s_tim1_base_us = t_us;
+  tim1_schedule();
+}
+
+static void tim1_schedule(void)
+{
+  const uint64_t tick = tim1_tick_us();
+  void *gen = (void *)(uintptr_t)s_tim1_gen;
+  if (TIM1->CCR1 <= TIM1->ARR) SimHal_Schedule(s_tim1_base_us + TIM1->CCR1 * tick, tim1_cc1, gen);
+  if (TIM1->CCR2 <= TIM1->ARR) SimHal_Schedule(s_tim1_base_us + TIM1->CCR2 * tick, tim1_cc2, gen);
+  SimHal_Schedule(s_tim1_base_us + (TIM1->ARR + 1u) * tick, tim1_update, gen);
+}
+
+void SimHal_TIM_Enable(TIM_HandleTypeDef *htim)
+{
+  TIM_TypeDef *tim = htim->Instance;
+  if (tim->CR1 & TIM_CR1_CEN) return;
+  tim->CR1 |= TIM_CR1_CEN;
+  if (tim != TIM1) return;
+  s_tim1_gen++;
+  s_tim1_base_us = s_now_us;
+  tim1_schedule();
+}
+
+void SimHal_TIM_Disable(TIM_HandleTypeDef *htim)
+{
+  htim->Instance->CR1 &= ~TIM_CR1_CEN;
+  if (htim->Instance == TIM1) s_tim1_gen++;
+}
+
+uint32_t HAL_TIM_ReadCapturedValue(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+  return *ccr_of(htim->Instance, Channel);
+}
+
+void SimHal_SetCaptureInput(TIM_HandleTypeDef *htim, uint32_t channel, GPIO_PinState level)
+{
+  sim_tim_t *t = tim_of(htim);
+  if (t == NULL) return;
+
+  const uint8_t  ci  = ch_index(channel);
+  const uint8_t  bit = (uint8_t)(1u << ci);
+  const bool     was = (t->in_level & bit) != 0;
+  const bool     now = (level != GPIO_PIN_RESET);
+  if (was == now) return;
+  t->in_level = now ? (uint8_t)(t->in_level | bit) : (uint8_t)(t->in_level & ~bit);
+
+  // CCxP / CCxNP 로 감지 엣지 결정
+  TIM_TypeDef *tim = htim->Instance;
+  const uint32_t pol = (tim->CCER >> channel) & TIM_INPUTCHANNELPOLARITY_BOTHEDGE;
+  const bool hit = (pol == TIM_INPUTCHANNELPOLARITY_BOTHEDGE) ||
+                   (pol == TIM_INPUTCHANNELPOLARITY_RISING  &&  now) ||
+                   (pol == TIM_INPUTCHANNELPOLARITY_FALLING && !now);
+  if (!hit) return;
+
+  const uint32_t ccif = TIM_FLAG_CC1 << ci;
+  const uint32_t ccof = TIM_FLAG_CC1OF << ci;
+  tim->CNT = tim_count(t);
+  *ccr_of(tim, channel) = tim->CNT;
+  if (tim->SR & ccif) tim->SR |= ccof;
+  tim->SR |= ccif;
+
+  // CCxDE: DMA 가 CCRx 를 읽음 (CCxIF 도 같이 풀림)
+  if (tim->DIER & (TIM_DMA_CC1 << ci)) {
+    tim->SR &= ~(ccif | ccof);
+    dma_request(htim->hdma[TIM_DMA_ID_CC1 + ci]);
+  }
+
+  // HAL_TIM_IRQHandler 흉내: 플래그 클리어 → Channel 설정 → 콜백
+  if (tim->DIER & (TIM_IT_CC1 << ci)) {
+    if (htim == &htim4) s_tim4_irq++;
+    tim->SR &= ~ccif;
+    htim->Channel = (HAL_TIM_ActiveChannel)(HAL_TIM_ACTIVE_CHANNEL_1 << ci);
+    HAL_TIM_IC_CaptureCallback(htim);
+    htim->Channel = HAL_TIM_ACTIVE_CHANNEL_CLEARED;
+  }
+}
+
+uint32_t SimHal_Tim4Irq(void)   { return s_tim4_irq; }
+uint32_t SimHal_DmaIrq(void)    { return s_dma_irq; }
+
+uint32_t SimHal_PwmRight(void)  { return TIM3->CCR1; }
+uint32_t SimHal_PwmLeft(void)   { return TIM3->CCR2; }
+uint32_t SimHal_PwmPeriod(void) { return TIM3->ARR; }
+
+// ==== UART / 시스템 ====
+void SimHal_SetUartEcho(bool on) { s_uart_echo = on; }
+
+static sim_uart_t *uart_of(UART_HandleTypeDef *huart)
+{
+  return &s_uart[(huart->Instance == USART1) ? 0 : 1];
+}
+
+void SimHal_SetUartSink(UART_HandleTypeDef *huart, SimUartSinkFn fn, void *ctx)
+{
+  sim_uart_t *u = uart_of(huart);
+  u->sink = fn; u->ctx = ctx;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+  (void)Timeout;
+  sim_uart_t *u = uart_of(huart);
+  if (u->busy) return HAL_BUSY;
+  if (u->sink) u->sink(pData, Size, u->ctx);
+  if (s_uart_echo) fwrite(pData, 1, Size, stdout);
+  return HAL_OK;
+}
+
+// DMA 완료: 버퍼는 이 시점에 읽음 (송신 중 펌웨어가 덮어쓰면 그대로 드러나게)
+static void uart_dma_done(uint64_t t_us, void *ctx)
+{
+  (void)t_us;
+  UART_HandleTypeDef *huart = (UART_HandleTypeDef *)ctx;
+  sim_uart_t *u = uart_of(huart);
+  if (u->sink) u->sink(u->p, u->n, u->ctx);
+  u->busy = false;
+  HAL_UART_TxCpltCallback(huart);
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size)
+{
+  sim_uart_t *u = uart_of(huart);
+  if (u->busy) return HAL_BUSY;
+  if (Size == 0u) return HAL_ERROR;
+
+  const uint64_t dur_us = ((uint64_t)Size * 10u * 1000000u + u->baud - 1u) / u->baud;
+  if (!SimHal_Schedule(s_now_us + dur_us, uart_dma_done, huart)) return HAL_ERROR;
+  u->busy = true; u->p = pData; u->n = Size;
+  return HAL_OK;
+}
+
+__weak void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) { (void)huart; }
+
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+  (void)huart; (void)pData; (void)Size;
+  return HAL_OK;
+}
+
+// ==== FLASH ====
+HAL_StatusTypeDef HAL_FLASH_Unlock(void) { flash_blank_once(); s_flash_unlocked = true;  return HAL_OK; }
+HAL_StatusTypeDef HAL_FLASH_Lock(void)   { s_flash_unlocked = false; return HAL_OK; }
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError)
+{
+  if (!s_flash_unlocked || pEraseInit->Sector != FLASH_SECTOR_7 || pEraseInit->NbSectors != 1u) {
+    *SectorError = pEraseInit->Sector;
+    return HAL_ERROR;
+  }
+  memset(SimHal_Flash, 0xFF, sizeof SimHal_Flash);
+  *SectorError = 0xFFFFFFFFu;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uintptr_t Address, uint64_t Data)
+{
+  const uintptr_t base = (uintptr_t)SimHal_Flash;
+  if (!s_flash_unlocked || TypeProgram != FLASH_TYPEPROGRAM_WORD) return HAL_ERROR;
+  if (Address < base || Address + 4u > base + sizeof SimHal_Flash || (Address & 3u)) return HAL_ERROR;
+
+  uint32_t w;
+  memcpy(&w, (const void *)Address, 4);
+  w &= (uint32_t)Data;                  // 1→0 만 가능
+  memcpy((void *)Address, &w, 4);
+  return HAL_OK;
+}
+
+uint32_t HAL_GetTick(void) { return (uint32_t)(s_now_us / 1000u); }
+
+void HAL_Delay(uint32_t Delay) { SimHal_Spend(Delay * 1000u); }
+
+__weak void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef *htim) { (void)htim; }
+__weak void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim) { (void)htim; }
+__weak void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim) { (void)htim; }
+
+void Error_Handler(void)
+{
+  fprintf(stderr, "Error_Handler @ %llu us\n", (unsigned long long)s_now_us);
+  abort();
+}
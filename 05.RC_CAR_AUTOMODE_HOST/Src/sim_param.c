@@ -0,0 +1,62 @@
+/*
+ * sim_param.c — -p NAME=VAL 튜닝 파라미터 덮어쓰기 (SimBoard_SetParams)
+ *
+ *  보드/태스크 구성과 무관해서 따로 둠 (replay 는 sim_board.c 없이 이것만 링크)
+ */
+
+#include "sim_board.h"
+#include "sim_variant.h"
+#if SIM_HAS_PARAM
+#include "param.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if SIM_HAS_PARAM
+static bool set_one(const char *kv, bool report)
+{
+  char name[32];
+  const char *eq = strchr(kv, '=');
+  if (eq == NULL || (size_t)(eq - kv) >= sizeof name) {
+    if (report) fprintf(stderr, "param: expected NAME=VAL: %s\n", kv);
+    return false;
+  }
+  memcpy(name, kv, (size_t)(eq - kv));
+  name[eq - kv] = '\0';
+
+  const int id = Param_Find(name);
+  char *end;
+  const long v = strtol(eq + 1, &end, 0);
+  if (id < 0 || *end != '\0' || !Param_Set((param_id_t)id, v)) {
+    if (report) fprintf(stderr, "param: rejected %s\n", kv);
+    return false;
+  }
+  return true;
+}
+
+bool SimBoard_SetParams(const char *const *kv, int n)
+{
+  bool done[SIM_PARAM_MAX] = { false };
+  if (n > (int)SIM_PARAM_MAX) { fprintf(stderr, "param: too many (max %u)\n", SIM_PARAM_MAX); return false; }
+
+  int left = n;
+  for (bool progress = true; left > 0 && progress; ) {
+    progress = false;
+    for (int i = 0; i < n; ++i) {
+      if (!done[i] && set_one(kv[i], false)) { done[i] = true; left--; progress = true; }
+    }
+  }
+  for (int i = 0; i < n; ++i) if (!done[i]) set_one(kv[i], true);
+  Param_Sync();
+  return left == 0;
+}
+#else
+bool SimBoard_SetParams(const char *const *kv, int n)
+{
+  (void)kv;
+  if (n > 0) fprintf(stderr, "param: this firmware tree has no param table\n");
+  return n == 0;
+}
+#endif
@@ -0,0 +1,131 @@
+/*
+ * sim_sonar.c — HC-SR04 타이밍 모델
+ *
+ *  - TRIG High ≥ 10µs 후 하강 → BURST_US 뒤 ECHO 상승
+ *  - ECHO 폭 = 왕복 시간 (거리 x 2 / 음속), 미검출이면 NOECHO_US
+ *  - 거리 SIM_SONAR_DEAD_CM 이하: 모듈 무응답 (ECHO 엣지 없음 — 전원/배선 불량, 캡처가 rising 대기로 걸림)
+ *  - 측정 중(ECHO High) 들어온 트리거는 실제 모듈처럼 무시
+ *  - TRIG 펄스 폭은 센서별 최소/최대로 기록 (펌웨어 트리거 타이밍 검사)
+ *  - crosstalk (SimSonar_SetCrosstalk): 같은 순간 같이 쏜 센서의 더 짧은 에코가 확률 p 로 이 수신기에 먼저 들어옴
+ *    (같은 시각 하강 엣지는 감시 순서대로 처리 → 먼저 처리된 센서 → 나중 센서 방향만)
+ */
+
+#include "sim_sonar.h"
+
+typedef struct {
+  bool               used;
+  SimSonarWiring_t   w;
+  uint64_t           trig_rise_us;
+  uint64_t           busy_until_us;
+  uint32_t           echo_us;
+  uint32_t           shots;
+  uint32_t           ignored;
+  uint32_t           trig_min_us;
+  uint32_t           trig_max_us;
+  uint64_t           fall_us;       // 마지막 유효 트리거 하강 시각
+  uint32_t           crosstalk;
+} sim_sonar_t;
+
+static sim_sonar_t s_sonar[SIM_SONAR_MAX];
+static SimRangeFn  s_range_fn = NULL;
+static void       *s_range_ctx = NULL;
+static float       s_us_per_cm = 58.24f;   // 343.4 m/s @20°C (331.3 + 0.606 T)
+static float       s_xt_prob = 0.0f;
+static uint32_t    s_xt_rng = 1u;
+
+void SimSonar_SetCrosstalk(float prob, uint32_t seed)
+{
+  s_xt_prob = prob;
+  s_xt_rng  = seed ? seed : 1u;
+}
+
+// xorshift32 → [0,1)
+static float xt_rand(void)
+{
+  s_xt_rng ^= s_xt_rng << 13; s_xt_rng ^= s_xt_rng >> 17; s_xt_rng ^= s_xt_rng << 5;
+  return (float)(s_xt_rng >> 8) * (1.0f / 16777216.0f);
+}
+
+void SimSonar_SetSoundSpeed(float m_per_s)
+{
+  if (m_per_s > 1.0f) s_us_per_cm = 2.0f * 1e4f / m_per_s;
+}
+
+static void echo_fall(uint64_t t_us, void *ctx)
+{
+  (void)t_us;
+  sim_sonar_t *s = (sim_sonar_t *)ctx;
+  SimHal_SetCaptureInput(s->w.htim, s->w.channel, GPIO_PIN_RESET);
+}
+
+static void echo_rise(uint64_t t_us, void *ctx)
+{
+  sim_sonar_t *s = (sim_sonar_t *)ctx;
+  SimHal_SetCaptureInput(s->w.htim, s->w.channel, GPIO_PIN_SET);
+  SimHal_Schedule(t_us + s->echo_us, echo_fall, s);
+}
+
+static void on_trig(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state, uint64_t t_us, void *ctx)
+{
+  (void)port; (void)pin;
+  sim_sonar_t *s = (sim_sonar_t *)ctx;
+  const uint8_t idx = (uint8_t)(s - s_sonar);
+
+  if (state == GPIO_PIN_SET) { s->trig_rise_us = t_us; return; }
+
+  // 하강 엣지: 펄스 폭/측정 중 여부 확인
+  const uint32_t width = (uint32_t)(t_us - s->trig_rise_us);
+  if (width < s->trig_min_us) s->trig_min_us = width;
+  if (width > s->trig_max_us) s->trig_max_us = width;
+  if (width < SIM_SONAR_TRIG_MIN_US || t_us < s->busy_until_us) {
+    s->ignored++;
+    return;
+  }
+
+  float cm = (s_range_fn != NULL) ? s_range_fn(idx, t_us, s_range_ctx) : -1.0f;
+  if (cm <= SIM_SONAR_DEAD_CM) { s->shots++; return; }
+  s->echo_us = (cm > 0.0f) ? (uint32_t)(cm * s_us_per_cm + 0.5f) : SIM_SONAR_NOECHO_US;
+  if (s->echo_us > SIM_SONAR_NOECHO_US) s->echo_us = SIM_SONAR_NOECHO_US;
+
+  if (s_xt_prob > 0.0f) {
+    for (uint8_t k = 0; k < SIM_SONAR_MAX; ++k) {
+      const sim_sonar_t *o = &s_sonar[k];
+      if (o == s || !o->used || o->fall_us != t_us || o->echo_us >= s->echo_us) continue;
+      if (xt_rand() < s_xt_prob) { s->echo_us = o->echo_us; s->crosstalk++; }
+      break;
+    }
+  }
+  s->fall_us = t_us;
+
+  const uint64_t rise = t_us + SIM_SONAR_BURST_US;
+  s->busy_until_us = rise + s->echo_us;
+  s->shots++;
+  SimHal_Schedule(rise, echo_rise, s);
+}
+
+void SimSonar_Init(SimRangeFn fn, void *ctx)
+{
+  for (uint8_t i = 0; i < SIM_SONAR_MAX; ++i) s_sonar[i] = (sim_sonar_t){ .trig_min_us = UINT32_MAX };
+  s_range_fn  = fn;
+  s_range_ctx = ctx;
+}
+
+bool SimSonar_Attach(uint8_t idx, const SimSonarWiring_t *w)
+{
+  if (idx >= SIM_SONAR_MAX || s_sonar[idx].used) return false;
+  s_sonar[idx].used = true;
+  s_sonar[idx].w = *w;
+  return SimHal_WatchPin(w->trig_port, w->trig_pin, on_trig, &s_sonar[idx]);
+}
+
+uint32_t SimSonar_Shots(uint8_t idx)   { return (idx < SIM_SONAR_MAX) ? s_sonar[idx].shots   : 0u; }
+uint32_t SimSonar_Ignored(uint8_t idx) { return (idx < SIM_SONAR_MAX) ? s_sonar[idx].ignored : 0u; }
+uint32_t SimSonar_Crosstalk(uint8_t idx) { return (idx < SIM_SONAR_MAX) ? s_sonar[idx].crosstalk : 0u; }
+
+bool SimSonar_TrigWidth(uint8_t idx, uint32_t *min_us, uint32_t *max_us)
+{
+  if (idx >= SIM_SONAR_MAX || s_sonar[idx].trig_max_us == 0u) return false;
+  *min_us = s_sonar[idx].trig_min_us;
+  *max_us = s_sonar[idx].trig_max_us;
+  return true;
+}
@@ -0,0 +1,75 @@
+/*
+ * sim_task.c — 1ms 틱 협조형 스케줄러
+ *
+ *  - 같은 우선순위(osPriorityNormal) 태스크는 생성 순서대로 실행
+ *  - osDelay(n) 은 "본문이 끝난 틱 + n" 에 깨어남
+ *  - 본문 실행 중 소모된 가상 시간(delay_us 등)은 그대로 반영
+ *  - wait_ms 태스크는 ISR 의 osThreadFlagsSet 시각에 바로 실행 (틱 사이 µs 단위)
+ */
+
+#include "sim_task.h"
+#include "cmsis_os2.h"
+
+static volatile bool s_stop = false;
+static SimTask_t    *s_current = NULL;
+
+osThreadId_t osThreadGetId(void) { return s_current; }
+
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags)
+{
+  SimTask_t *t = (SimTask_t *)thread_id;
+  t->flags |= flags;
+  SimHal_Wake();
+  return t->flags;
+}
+
+static void run_task(SimTask_t *t)
+{
+  t->flags = 0;                 // osThreadFlagsWait 가 돌려주면서 지움
+  s_current = t;
+  t->runs++;
+  t->step();
+  s_current = NULL;
+  t->next_ms = HAL_GetTick() + (t->wait_ms ? t->wait_ms() : t->delay_ms);
+}
+
+static bool woken(const SimTask_t *t) { return t->wait_ms != NULL && t->flags != 0u; }
+
+void SimTask_Start(SimTask_t *tasks, uint8_t num)
+{
+  s_stop = false;
+  const uint32_t now = HAL_GetTick();
+  for (uint8_t i = 0; i < num; ++i) {
+    tasks[i].flags = 0;
+    tasks[i].runs = 0;
+    s_current = &tasks[i];
+    if (tasks[i].init) tasks[i].init();
+    s_current = NULL;
+    tasks[i].next_ms = now;
+  }
+}
+
+void SimTask_RunUntil(SimTask_t *tasks, uint8_t num, uint32_t until_ms, SimTickFn tick_fn, void *ctx)
+{
+  uint32_t ms = HAL_GetTick();
+
+  while (!s_stop && (int32_t)(ms - until_ms) < 0) {
+    // 틱 사이에 ISR 가 깨운 태스크는 그 시각에 실행
+    while (!SimHal_AdvanceToWake((uint64_t)ms * 1000u)) {
+      for (uint8_t i = 0; i < num && !s_stop; ++i) if (woken(&tasks[i])) run_task(&tasks[i]);
+    }
+    if (tick_fn) tick_fn(ms, ctx);
+
+    for (uint8_t i = 0; i < num && !s_stop; ++i) {
+      if ((int32_t)(ms - tasks[i].next_ms) < 0 && !woken(&tasks[i])) continue;
+      run_task(&tasks[i]);
+    }
+
+    // 본문이 틱 경계를 넘겼으면 그 다음 틱부터
+    uint32_t t = HAL_GetTick();
+    ms = (t > ms) ? t : ms + 1u;
+  }
+  if (!s_stop) SimHal_AdvanceTo((uint64_t)until_ms * 1000u);
+}
+
+void SimTask_Stop(void) { s_stop = true; }
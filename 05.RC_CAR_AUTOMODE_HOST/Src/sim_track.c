@@ -0,0 +1,129 @@
+/*
+ * sim_track.c — 트랙 로더 + 기하 연산
+ */
+
+#include "sim_track.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+static inline float cross2(SimVec_t a, SimVec_t b) { return a.x * b.y - a.y * b.x; }
+static inline SimVec_t sub2(SimVec_t a, SimVec_t b) { return (SimVec_t){ a.x - b.x, a.y - b.y }; }
+
+static bool add_wall(SimTrack_t *trk, SimVec_t a, SimVec_t b)
+{
+  if (trk->wall_num >= SIM_TRACK_MAX_SEGS) return false;
+  trk->wall[trk->wall_num++] = (SimSeg_t){ a, b };
+  return true;
+}
+
+bool SimTrack_Load(SimTrack_t *trk, const char *path)
+{
+  FILE *f = fopen(path, "r");
+  if (f == NULL) { perror(path); return false; }
+
+  memset(trk, 0, sizeof *trk);
+  const char *base = strrchr(path, '/');
+  snprintf(trk->name, sizeof trk->name, "%s", base ? base + 1 : path);
+
+  char line[1024];
+  unsigned lineno = 0;
+  bool ok = true;
+  while (ok && fgets(line, sizeof line, f)) {
+    lineno++;
+    char *p = line;
+    char  kw[16];
+    int   n = 0;
+    if (sscanf(p, "%15s%n", kw, &n) != 1 || kw[0] == '#') continue;
+    p += n;
+
+    if (!strcmp(kw, "wall")) {
+      SimVec_t prev = {0}, v;
+      int k = 0;
+      while (sscanf(p, "%f %f%n", &v.x, &v.y, &n) == 2) {
+        p += n;
+        if (k++ > 0 && !add_wall(trk, prev, v)) { ok = false; break; }
+        prev = v;
+      }
+      if (k < 2) ok = false;
+    }
+    else if (!strcmp(kw, "start")) {
+      ok = sscanf(p, "%f %f %f", &trk->start.x, &trk->start.y, &trk->start_heading_deg) == 3;
+    }
+    else if (!strcmp(kw, "gate")) {
+      SimSeg_t g;
+      ok = trk->gate_num < SIM_TRACK_MAX_GATES &&
+           sscanf(p, "%f %f %f %f", &g.a.x, &g.a.y, &g.b.x, &g.b.y) == 4;
+      if (ok) trk->gate[trk->gate_num++] = g;
+    }
+    else if (!strcmp(kw, "sensor")) {
+      unsigned idx; SimMount_t m = { true, 0, 0, 0 };
+      ok = sscanf(p, "%u %f %f %f", &idx, &m.x, &m.y, &m.angle_deg) == 4 && idx < SIM_TRACK_MAX_SENSORS;
+      if (ok) trk->mount[idx] = m;
+    }
+    else ok = false;
+  }
+  fclose(f);
+
+  if (!ok) fprintf(stderr, "%s:%u: parse error\n", path, lineno);
+  return ok && trk->wall_num > 0;
+}
+
+float SimTrack_Ray(const SimTrack_t *trk, SimVec_t o, SimVec_t d, float max_cm, float *cos_inc)
+{
+  float best = -1.0f, best_cos = 0.0f;
+
+  for (uint16_t i = 0; i < trk->wall_num; ++i) {
+    const SimSeg_t *s = &trk->wall[i];
+    SimVec_t e = sub2(s->b, s->a);
+    float den = cross2(d, e);
+    if (fabsf(den) < 1e-9f) continue;           // 평행
+    SimVec_t ao = sub2(s->a, o);
+    float t = cross2(ao, e) / den;              // 광선 파라미터
+    float u = cross2(ao, d) / den;              // 선분 파라미터
+    if (t <= 0.0f || u < 0.0f || u > 1.0f || t > max_cm) continue;
+    if (best < 0.0f || t < best) {
+      best = t;
+      float len = sqrtf(e.x * e.x + e.y * e.y);
+      best_cos = fabsf(cross2(d, e)) / len;     // |sin(광선,벽)| = |cos(광선,법선)|
+    }
+  }
+  if (cos_inc) *cos_inc = best_cos;
+  return best;
+}
+
+static float seg_dist(const SimSeg_t *s, SimVec_t p, SimVec_t *away)
+{
+  SimVec_t e = sub2(s->b, s->a), ap = sub2(p, s->a);
+  float ee = e.x * e.x + e.y * e.y;
+  float t = (ee > 0.0f) ? (ap.x * e.x + ap.y * e.y) / ee : 0.0f;
+  if (t < 0.0f) t = 0.0f; else if (t > 1.0f) t = 1.0f;
+  float dx = ap.x - t * e.x, dy = ap.y - t * e.y;
+  float d = sqrtf(dx * dx + dy * dy);
+  if (away && d > 0.0f) *away = (SimVec_t){ dx / d, dy / d };
+  return d;
+}
+
+float SimTrack_Clearance(const SimTrack_t *trk, SimVec_t p, SimVec_t *away)
+{
+  float best = INFINITY;
+  SimVec_t n = { 0.0f, 0.0f }, nb = n;
+  for (uint16_t i = 0; i < trk->wall_num; ++i) {
+    float dd = seg_dist(&trk->wall[i], p, &n);
+    if (dd < best) { best = dd; nb = n; }
+  }
+  if (away) *away = nb;
+  return best;
+}
+
+bool SimTrack_Crossed(const SimTrack_t *trk, uint8_t g, SimVec_t p0, SimVec_t p1)
+{
+  if (g >= trk->gate_num) return false;
+  const SimSeg_t *s = &trk->gate[g];
+  SimVec_t e = sub2(s->b, s->a), m = sub2(p1, p0);
+  float c0 = cross2(e, sub2(p0, s->a)), c1 = cross2(e, sub2(p1, s->a));
+  if ((c0 > 0.0f) == (c1 > 0.0f)) return false;
+  float d0 = cross2(m, sub2(s->a, p0)), d1 = cross2(m, sub2(s->b, p0));
+  return (d0 > 0.0f) != (d1 > 0.0f);
+}
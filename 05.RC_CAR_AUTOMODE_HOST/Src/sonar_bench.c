@@ -0,0 +1,296 @@
+/*
+ * sonar_bench.c — 소나 배열(05.RC_CAR_AUTOMODE_OBJECTCODE ultrasonic.c) 센서 수별 비용
+ *
+ *  사용법: sonar_bench [-n 에지수] [-s 시드]
+ *   -n  센서 수마다 넣을 캡처 에지 수 (기본 4000000)
+ *   -s  에코 폭 생성 시드 (기본 1)
+ *
+ *  센서 1~8 (0~3 = htim4 CH1~4, 4~7 = htim3 CH1~4 — 타이머 두 개) 를 Sonar_Init 으로 올리고
+ *  발사 → Rising → Falling 을 센서 순서대로 돌려
+ *   - 에지당 ns: 라우팅 표 (HAL_TIM_IC_CaptureCallback) vs 예전식 if 체인을 N 개로 늘린 것
+ *   - 발사당 ns (Sonar_Trigger), 한 바퀴(센서 N 개) ns
+ *   - 에지당 분배 비교 수 (라우팅 표 = 타이머 칸 찾기만, 체인 = 앞 센서 수만큼) — 보드 비용은 이 쪽이 가까움
+ *   - 거리 일치 (에코 폭 → 기대 mm)
+ *   - 캡처 프로브 (SONAR_PROF, 펌웨어와 같은 코드): 따로 한 번 더 돌린 에지당 평균 TSC 틱
+ *     체인 쪽도 같은 프로브로 감쌈. 시간 재는 루프에서는 DWT 대역이 값을 안 바꿈 (TSC 읽기 비용 빼려고)
+ *  호스트 x86 수치라 절대값은 보드와 다름 — 센서 수에 따른 증가 추세 비교용.
+ *  보드에서 한 바퀴를 정하는 건 음향 간격 (센서 수 x SONAR_GAP_MS), CPU 비용은 그보다 수천 배 작음.
+ *
+ *  HAL 은 여기서 최소 대역만 (sim_hal.c 없이): CCR 읽기, GPIO 쓰기, IC 시작, DWT, delay_us 는 빈 함수.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ultrasonic.h"
+#include "us_range.h"
+#include "tim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ==== HAL 최소 대역 ====
+TIM_TypeDef  SimHal_TIM1, SimHal_TIM3, SimHal_TIM4, SimHal_TIM11;
+GPIO_TypeDef SimHal_GPIOA, SimHal_GPIOB, SimHal_GPIOC;
+TIM_HandleTypeDef htim3, htim4, htim11;
+
+static uint32_t s_trig_edges;
+static volatile uint32_t s_sink;   // 측정 루프가 지워지지 않게
+
+uint32_t HAL_TIM_ReadCapturedValue(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+  switch (Channel) {
+  case TIM_CHANNEL_1: return htim->Instance->CCR1;
+  case TIM_CHANNEL_2: return htim->Instance->CCR2;
+  case TIM_CHANNEL_3: return htim->Instance->CCR3;
+  default:            return htim->Instance->CCR4;
+  }
+}
+
+HAL_StatusTypeDef HAL_TIM_IC_Start(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+  htim->Instance->CCER |= 1u << Channel;
+  return HAL_OK;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+  if (PinState != GPIO_PIN_RESET) { GPIOx->ODR |= GPIO_Pin; s_trig_edges++; }
+  else                            GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+}
+
+void delay_us(uint16_t us) { (void)us; }
+
+// DWT 대역: 프로브 패스에서만 CYCCNT = TSC 하위 32비트 (x86 밖에서는 ns)
+static DWT_Type s_dwt;
+static bool     s_tsc;
+CoreDebug_Type  SimHal_CoreDebug;
+
+DWT_Type *SimHal_Dwt(void)
+{
+  if (!s_tsc) return &s_dwt;
+#if defined(__x86_64__) || defined(__i386__)
+  s_dwt.CYCCNT = (uint32_t)__builtin_ia32_rdtsc();
+#else
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  s_dwt.CYCCNT = (uint32_t)((uint64_t)t.tv_sec * 1000000000u + (uint64_t)t.tv_nsec);
+#endif
+  return &s_dwt;
+}
+
+// ==== 배치: 센서 k → 타이머 k/4, 채널 k%4 ====
+static const uint32_t CH[4] = { TIM_CHANNEL_1, TIM_CHANNEL_2, TIM_CHANNEL_3, TIM_CHANNEL_4 };
+static SonarDesc_t s_desc[SONAR_MAX];
+
+static TIM_HandleTypeDef *tim_of(uint8_t k) { return (k < 4u) ? &htim4 : &htim3; }
+
+static void make_desc(uint8_t n)
+{
+  static const char *name[SONAR_MAX] = { "0", "1", "2", "3", "4", "5", "6", "7" };
+  for (uint8_t k = 0; k < n; ++k) {
+    s_desc[k] = (SonarDesc_t){ tim_of(k), CH[k % 4u], GPIOC, (uint16_t)(GPIO_PIN_0 << k),
+                               (int16_t)(90 - 180 * k / (n > 1u ? n - 1u : 1u)), name[k] };
+  }
+}
+
+static void set_ccr(TIM_HandleTypeDef *h, uint8_t ch, uint32_t v)
+{
+  switch (ch) {
+  case 0: h->Instance->CCR1 = v; break;
+  case 1: h->Instance->CCR2 = v; break;
+  case 2: h->Instance->CCR3 = v; break;
+  default: h->Instance->CCR4 = v; break;
+  }
+}
+
+// ==== 예전 ultrasonic.c 식 분배: 센서마다 if (타이머, 채널) 비교 ====
+// 펌웨어와 같게: 상태는 volatile, 콜백은 인라인 안 됨 (다른 번역 단위) → 차이는 분배만
+typedef struct { volatile uint8_t state; volatile uint32_t start; volatile uint16_t mm; volatile uint32_t count; } ref_sonar_t;
+static ref_sonar_t s_ref[SONAR_MAX];
+static uint8_t     s_ref_num;
+
+static const uint32_t ACTIVE[4] = { HAL_TIM_ACTIVE_CHANNEL_1, HAL_TIM_ACTIVE_CHANNEL_2,
+                                    HAL_TIM_ACTIVE_CHANNEL_3, HAL_TIM_ACTIVE_CHANNEL_4 };
+
+static uint16_t expect_mm(uint32_t echo_us, uint16_t prev)
+{
+  if (echo_us > 0xFFFFu) return 4000u;
+  const uint16_t v = US_EchoToMm((uint16_t)echo_us);
+  if (v < 20u) return prev;
+  return (v > 4000u) ? 4000u : v;
+}
+
+__attribute__((noinline)) static void ref_capture(TIM_HandleTypeDef *htim)
+{
+  for (uint8_t k = 0; k < s_ref_num; ++k) {
+    if (s_desc[k].timer == htim && ACTIVE[s_desc[k].channel >> 2] == (uint32_t)htim->Channel) {
+      ref_sonar_t *r = &s_ref[k];
+      const uint32_t v = HAL_TIM_ReadCapturedValue(htim, s_desc[k].channel);
+      if (r->state == 0u) {
+        r->start = v; r->state = 1u;
+        __HAL_TIM_SET_CAPTUREPOLARITY(htim, s_desc[k].channel, TIM_INPUTCHANNELPOLARITY_FALLING);
+      }
+      else {
+        uint32_t d = v - r->start;
+        if (v < r->start) d += __HAL_TIM_GET_AUTORELOAD(htim) + 1u;
+        r->mm = expect_mm(d, r->mm);
+        __HAL_TIM_DISABLE_IT(htim, TIM_IT_CC1 << (s_desc[k].channel >> 2));
+        r->count++;
+        r->state = 0u;
+      }
+      return;
+    }
+  }
+}
+
+// 체인 쪽 콜백 (펌웨어 HAL_TIM_IC_CaptureCallback 과 같은 프로브)
+static SonarProf_t s_ref_prof;
+
+static void ref_callback(TIM_HandleTypeDef *htim)
+{
+  const uint32_t t0 = DWT->CYCCNT;
+  ref_capture(htim);
+  const uint32_t dc = DWT->CYCCNT - t0;
+  s_ref_prof.calls++;
+  s_ref_prof.sum += dc;
+  if (dc > s_ref_prof.max) s_ref_prof.max = dc;
+}
+
+// ==== 에코 폭 ====
+static uint32_t s_rng;
+static uint32_t rng(void) { s_rng ^= s_rng << 13; s_rng ^= s_rng >> 17; s_rng ^= s_rng << 5; return s_rng; }
+
+typedef struct { uint16_t rise; uint16_t width; uint8_t who; } shot_t;   // who % N = 센서
+
+static double now_s(void)
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+static inline void edge(TIM_HandleTypeDef *h, uint8_t ch, uint32_t v)
+{
+  set_ccr(h, ch, v);
+  h->Channel = (HAL_TIM_ActiveChannel)ACTIVE[ch];
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t n = 4000000u;
+  s_rng = 1u;
+  for (int i = 1; i < argc; ++i) {
+    if      (!strcmp(argv[i], "-n") && i + 1 < argc) n = (uint32_t)strtoul(argv[++i], NULL, 0);
+    else if (!strcmp(argv[i], "-s") && i + 1 < argc) s_rng = (uint32_t)strtoul(argv[++i], NULL, 0) | 1u;
+    else { fprintf(stderr, "usage: %s [-n edges] [-s seed]\n", argv[0]); return 2; }
+  }
+
+  htim3  = (TIM_HandleTypeDef){ .Instance = &SimHal_TIM3,  .Init = { .Prescaler = 99, .Period = 65535 } };
+  htim4  = (TIM_HandleTypeDef){ .Instance = &SimHal_TIM4,  .Init = { .Prescaler = 99, .Period = 65535 } };
+  htim11 = (TIM_HandleTypeDef){ .Instance = &SimHal_TIM11, .Init = { .Prescaler = 99, .Period = 65535 } };
+  SimHal_TIM3.ARR = SimHal_TIM4.ARR = SimHal_TIM11.ARR = 65535u;
+
+  // 샷 표: 에코 100us~24ms (범위 밖/짧은 펄스 포함), 16비트 랩 포함
+  // 시간 재는 루프의 센서 순서는 랜덤 — 호스트 분기 예측이 체인 순서를 외우지 못하게 (보드 M4 는 예측기 없음)
+  const uint32_t shots = n / 2u;
+  shot_t *s = malloc((size_t)(shots ? shots : 1u) * sizeof *s);
+  if (s == NULL || shots == 0u) return 1;
+  for (uint32_t i = 0; i < shots; ++i) s[i] = (shot_t){ (uint16_t)rng(), (uint16_t)(100u + rng() % 24000u), (uint8_t)(rng() >> 8) };
+
+  printf("  N  tim   table ns/edge   chain ns/edge   trig ns   frame ns   cmp/edge tab/chain   probe tsc tab/chain  match\n");
+  bool all = true;
+  for (uint8_t num = 1u; num <= SONAR_MAX; ++num) {
+    make_desc(num);
+    if (!Sonar_Init(s_desc, num)) { printf("%3u  Sonar_Init 실패\n", num); return 4; }
+    s_ref_num = num;
+    memset(s_ref, 0, sizeof s_ref);
+    for (uint8_t k = 0; k < num; ++k) s_ref[k].mm = 4000u;
+
+    // 일치 검사: 샷마다 발사 → 두 에지 → 기대 mm, 라우팅 표 / 체인 모두
+    bool same = true;
+    uint32_t cmp_tab = 0, cmp_chain = 0;   // 에지 하나 분배에 드는 핸들/채널 비교 수 (합)
+    uint16_t want[SONAR_MAX];
+    for (uint8_t k = 0; k < num; ++k) want[k] = 4000u;
+    for (uint32_t i = 0; i < shots && same; ++i) {
+      const uint8_t k = (uint8_t)(i % num), ch = (uint8_t)(k % 4u);
+      TIM_HandleTypeDef *h = tim_of(k);
+      Sonar_Trigger(k);
+      edge(h, ch, s[i].rise);                               HAL_TIM_IC_CaptureCallback(h); ref_capture(h);
+      edge(h, ch, (uint16_t)(s[i].rise + s[i].width));      HAL_TIM_IC_CaptureCallback(h); ref_capture(h);
+      want[k] = expect_mm(s[i].width, want[k]);
+      cmp_tab   += 2u * (k / 4u + 1u);       // 타이머 칸 찾기 (htim4 칸 0, htim3 칸 1)
+      cmp_chain += 2u * (k + 1u);            // 앞 센서부터 차례로
+      same = (Sonar_GetMm(k) == want[k]) && (s_ref[k].mm == want[k]);
+    }
+
+    // 비용 (3번 중 최소): 발사만 / 발사 + 두 에지 (라우팅 표, 체인) → 에지 = 차 / 2
+    double dt_trig = 1e9, dt_tab = 1e9, dt_chain = 1e9;
+    uint32_t sum = 0;
+    for (uint8_t rep = 0; rep < 3u; ++rep) {
+      double t0 = now_s();
+      for (uint32_t i = 0; i < shots; ++i) Sonar_Trigger((uint8_t)(s[i].who % num));
+      double dt = now_s() - t0;
+      if (dt < dt_trig) dt_trig = dt;
+
+      t0 = now_s();
+      for (uint32_t i = 0; i < shots; ++i) {
+        const uint8_t k = (uint8_t)(s[i].who % num), ch = (uint8_t)(k % 4u);
+        TIM_HandleTypeDef *h = tim_of(k);
+        Sonar_Trigger(k);
+        edge(h, ch, s[i].rise);                             HAL_TIM_IC_CaptureCallback(h);
+        edge(h, ch, (uint16_t)(s[i].rise + s[i].width));    HAL_TIM_IC_CaptureCallback(h);
+        sum += Sonar_GetMm(k);
+      }
+      dt = now_s() - t0;
+      if (dt < dt_tab) dt_tab = dt;
+
+      t0 = now_s();
+      for (uint32_t i = 0; i < shots; ++i) {
+        const uint8_t k = (uint8_t)(s[i].who % num), ch = (uint8_t)(k % 4u);
+        TIM_HandleTypeDef *h = tim_of(k);
+        Sonar_Trigger(k);
+        edge(h, ch, s[i].rise);                             ref_callback(h);
+        edge(h, ch, (uint16_t)(s[i].rise + s[i].width));    ref_callback(h);
+        sum += s_ref[k].mm;
+      }
+      dt = now_s() - t0;
+      if (dt < dt_chain) dt_chain = dt;
+    }
+    // 프로브 패스: 같은 샷을 한 번, DWT = TSC
+    Sonar_ProfReset();
+    memset(&s_ref_prof, 0, sizeof s_ref_prof);
+    s_tsc = true;
+    for (uint32_t i = 0; i < shots; ++i) {
+      const uint8_t k = (uint8_t)(s[i].who % num), ch = (uint8_t)(k % 4u);
+      TIM_HandleTypeDef *h = tim_of(k);
+      Sonar_Trigger(k);
+      edge(h, ch, s[i].rise);                               HAL_TIM_IC_CaptureCallback(h);
+      edge(h, ch, (uint16_t)(s[i].rise + s[i].width));      HAL_TIM_IC_CaptureCallback(h);
+      Sonar_Trigger(k);
+      edge(h, ch, s[i].rise);                               ref_callback(h);
+      edge(h, ch, (uint16_t)(s[i].rise + s[i].width));      ref_callback(h);
+    }
+    s_tsc = false;
+
+    dt_tab -= dt_trig;
+    dt_chain -= dt_trig;
+
+    const double e_tab = dt_tab * 1e9 / (2.0 * shots), e_chain = dt_chain * 1e9 / (2.0 * shots);
+    const double trig = dt_trig * 1e9 / shots;
+    all = all && same;
+    s_sink += sum;
+    SonarProf_t pt;
+    Sonar_ProfGet(SONAR_PROF_CAPTURE, &pt);
+    const SonarProf_t pc = s_ref_prof;
+    printf("%3u  %3u  %14.1f  %14.1f  %8.1f  %9.1f  %9.2f / %-6.2f  %8.1f / %-6.1f  %s\n", num, num > 4u ? 2u : 1u,
+           e_tab, e_chain, trig, num * (trig + 2.0 * e_tab), cmp_tab / (2.0 * shots), cmp_chain / (2.0 * shots),
+           pt.calls ? (double)pt.sum / pt.calls : 0.0, pc.calls ? (double)pc.sum / pc.calls : 0.0, same ? "yes" : "NO");
+  }
+  printf("board frame = N x SONAR_GAP_MS (%u ms)  trig pulses %u\n", SONAR_GAP_MS, s_trig_edges);
+  printf("RAM (host sizeof): Sonar_t %zu B x SONAR_MAX %u, SonarDesc_t %zu B (const) — ARM 은 포인터 4 B 라 24 / 20 B\n",
+         sizeof(Sonar_t), SONAR_MAX, sizeof(SonarDesc_t));
+  free(s);
+  return all ? 0 : 4;
+}
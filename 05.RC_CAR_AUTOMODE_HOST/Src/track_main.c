@@ -0,0 +1,200 @@
+/*
+ * track_main.c — 2D 트랙 시뮬레이터 (가상 클럭, 실시간보다 빠르게)
+ *
+ *  사용법: track_sim -T track.trk [-t 최대초] [-l 랩수] [-o trace.csv] [-p NAME=VAL ...] [-r rec.bin] [-u seq|pair|risk[,adapt|fixed][,med=L/R/C][,temp=C]] [-a C] [-q]
+ *   -T  트랙 파일 (형식은 sim_track.h)
+ *   -t  최대 가상 시간(초, 기본 120) — 랩을 못 채우면 여기서 종료
+ *   -l  목표 랩 수 (기본 1)
+ *   -o  10ms 마다 자세/바퀴속도/센서 CSV 기록
+ *   -p  튜닝 파라미터 덮어쓰기 (param.h 이름, 여러 번 가능)
+ *   -r  주행 기록(recorder.c) USART2 송출을 파일로 (rec_decode 로 CSV)
+ *   -u  초음파 트리거 슬롯 순서 / 길이 (ultrasonic.c US_SetSchedule, US_SetAdaptiveGap)
+ *   -a  모델 공기 기온 [°C] (음속 331.3 + 0.606 T, 기본 20 — 펌웨어가 쓰는 기온은 -u temp=)
+ *   -q  한 줄 요약만 (배치용)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "sim_car.h"
+#include "sim_sonar.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+  SimCar_t *car;
+  uint8_t   laps_goal;
+  FILE     *trace;
+  uint32_t  drive_ms[SIM_DRIVE_NUM];
+  uint32_t  shots[SIM_DRIVE_NUM][SIM_US_NUM];   // 주행 상태별 센서 샷 수 (트리거 정책 확인용)
+  uint32_t  shots_prev[SIM_US_NUM];
+  uint8_t   fsm_laps;                               // 상태별 시간을 찍은 랩 수
+  uint32_t  fsm_ms[SIM_CAR_MAX_LAPS][SIM_FSM_MAX];  // 랩 끝 시각의 상태별 누적 시간 (fsm.c)
+  uint32_t  fsm_trans[SIM_CAR_MAX_LAPS];
+} run_ctx_t;
+
+static SimTrack_t s_trk;
+static SimCar_t   s_car;
+
+static void on_tick(uint32_t now_ms, void *ctx)
+{
+  run_ctx_t *rc = (run_ctx_t *)ctx;
+  SimCar_Step(rc->car, now_ms);
+
+  if (rc->car->laps > rc->fsm_laps && rc->fsm_laps < SIM_CAR_MAX_LAPS) {
+    const char *name[SIM_FSM_MAX];
+    SimBoard_FsmDwell(rc->fsm_ms[rc->fsm_laps], name, &rc->fsm_trans[rc->fsm_laps]);
+    rc->fsm_laps++;
+  }
+
+  const SimDrive_t d = SimBoard_Drive();
+  rc->drive_ms[d]++;
+  for (uint8_t i = 0; i < SIM_US_NUM; ++i) {
+    const uint32_t n = SimSonar_Shots(i);
+    rc->shots[d][i] += n - rc->shots_prev[i];
+    rc->shots_prev[i] = n;
+  }
+
+  if (rc->trace && (now_ms % 10u) == 0u) {
+    const SimCar_t *c = rc->car;
+    uint16_t cm[SIM_US_NUM];
+    SimBoard_ReadCm(cm);
+    fprintf(rc->trace, "%u,%.1f,%.1f,%.1f,%.1f,%.1f,%u,%u,%u,%lu,%lu,%s\n",
+            now_ms, c->pos.x, c->pos.y, c->heading * 57.2957795f, c->v_left, c->v_right,
+            cm[SIM_US_LEFT], cm[SIM_US_CENTER], cm[SIM_US_RIGHT],
+            (unsigned long)SimHal_PwmRight(), (unsigned long)SimHal_PwmLeft(), SimBoard_DriveName(d));
+  }
+  if (rc->car->laps >= rc->laps_goal) SimTask_Stop();
+}
+
+// 랩별 상태 시간 (상태기계가 있는 트리만) — 마지막 줄은 랩을 못 채운 나머지
+static void print_fsm_laps(const run_ctx_t *rc)
+{
+  uint32_t    end[SIM_FSM_MAX], trans;
+  const char *name[SIM_FSM_MAX];
+  const uint8_t n = SimBoard_FsmDwell(end, name, &trans);
+  if (n == 0u) return;
+
+  printf("fsm     ");
+  for (uint8_t i = 0; i < n; ++i) printf(" %8s", name[i]);
+  printf("  trans\n");
+  const uint32_t zero[SIM_FSM_MAX] = {0};
+  const uint32_t *prev = zero;
+  uint32_t prev_trans = 0;
+  for (uint8_t k = 0; k <= rc->fsm_laps; ++k) {
+    const uint32_t *cur = (k < rc->fsm_laps) ? rc->fsm_ms[k] : end;
+    const uint32_t  tr  = (k < rc->fsm_laps) ? rc->fsm_trans[k] : trans;
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < n; ++i) sum += cur[i] - prev[i];
+    if (k == rc->fsm_laps && sum == 0u) break;
+    if (k < rc->fsm_laps) printf("lap %-4u", k + 1u);
+    else                  printf("rest    ");
+    for (uint8_t i = 0; i < n; ++i) printf(" %7.2fs", (cur[i] - prev[i]) / 1000.0);
+    printf("  %5u\n", tr - prev_trans);
+    prev = cur; prev_trans = tr;
+  }
+}
+
+static double wall_seconds(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv)
+{
+  const char *track = NULL, *trace = NULL;
+  double      sec = 120.0;
+  int         laps = 1;
+  bool        quiet = false;
+  const char *params[SIM_PARAM_MAX];
+  int         np = 0;
+  const char *rec = NULL;
+  const char *sched = NULL;
+  float       air_c = 20.0f;
+
+  for (int i = 1; i < argc; ++i) {
+    if      (!strcmp(argv[i], "-T") && i + 1 < argc) track = argv[++i];
+    else if (!strcmp(argv[i], "-t") && i + 1 < argc) sec = atof(argv[++i]);
+    else if (!strcmp(argv[i], "-l") && i + 1 < argc) laps = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-o") && i + 1 < argc) trace = argv[++i];
+    else if (!strcmp(argv[i], "-r") && i + 1 < argc) rec = argv[++i];
+    else if (!strcmp(argv[i], "-u") && i + 1 < argc) sched = argv[++i];
+    else if (!strcmp(argv[i], "-a") && i + 1 < argc) air_c = (float)atof(argv[++i]);
+    else if (!strcmp(argv[i], "-q")) quiet = true;
+    else if (!strcmp(argv[i], "-p") && i + 1 < argc && np < (int)SIM_PARAM_MAX) params[np++] = argv[++i];
+    else { track = NULL; break; }
+  }
+  if (track == NULL || laps < 1 || laps > (int)SIM_CAR_MAX_LAPS) {
+    fprintf(stderr, "usage: %s -T track.trk [-t sec] [-l laps] [-o trace.csv] [-p NAME=VAL ...] [-r rec.bin] [-u seq|pair|risk[,adapt|fixed][,med=L/R/C][,temp=C]] [-a C] [-q]\n", argv[0]);
+    return 2;
+  }
+  if (!SimTrack_Load(&s_trk, track)) return 1;
+
+  run_ctx_t rc = { .car = &s_car, .laps_goal = (uint8_t)laps };
+  if (trace) {
+    rc.trace = fopen(trace, "w");
+    if (rc.trace == NULL) { perror(trace); return 1; }
+    fprintf(rc.trace, "t_ms,x,y,heading_deg,v_left,v_right,L,C,R,ccr1_right,ccr2_left,drive\n");
+  }
+
+  SimCarParams_t p;
+  SimCar_DefaultParams(&p);
+
+  SimBoard_Init(SimCar_Range, &s_car);
+  SimCar_Init(&s_car, &s_trk, &p);
+  if (!SimBoard_SetParams(params, np)) return 2;
+  if (sched && !SimBoard_Schedule(sched)) return 2;
+  SimSonar_SetSoundSpeed(331.3f + 0.606f * air_c);
+  FILE *recf = NULL;
+  if (rec) {
+    recf = fopen(rec, "wb");
+    if (recf == NULL) { perror(rec); return 1; }
+    if (!SimBoard_Record(recf)) return 2;
+  }
+
+  const double w0 = wall_seconds();
+  SimBoard_Run((uint32_t)(sec * 1000.0), on_tick, &rc);
+  const double w1 = wall_seconds();
+  if (rc.trace) fclose(rc.trace);
+  if (recf) { SimBoard_Record(NULL); fclose(recf); }
+
+  const double vsec = (double)HAL_GetTick() / 1000.0;
+  const SimCar_t *c = &s_car;
+  const SimBoardStats_t *st = SimBoard_Stats();
+  const double cyc = st->updates ? (double)st->cycles / st->updates : 0.0;
+
+  if (!quiet) {
+    printf("track    %s (%u walls, %u gates)\n", s_trk.name, s_trk.wall_num, s_trk.gate_num);
+    for (uint8_t k = 0; k < c->laps && k < SIM_CAR_MAX_LAPS; ++k)
+      printf("lap %-4u %.3f s\n", k + 1u, c->lap_ms[k] / 1000.0);
+    printf("clear    min %.1f cm\n", c->min_clear_cm);
+    printf("contact  %u times, %u ms\n", c->contacts, c->contact_ms);
+    printf("dist     %.0f cm\n", c->dist_cm);
+    for (uint8_t d = 0; d < SIM_DRIVE_NUM; ++d) {
+      printf("%-8s %.1f s", SimBoard_DriveName((SimDrive_t)d), rc.drive_ms[d] / 1000.0);
+      if (rc.drive_ms[d] >= 100u) {
+        const double s = rc.drive_ms[d] / 1000.0;
+        printf("  sonar L=%.1f R=%.1f C=%.1f /s", rc.shots[d][SIM_US_LEFT] / s,
+               rc.shots[d][SIM_US_RIGHT] / s, rc.shots[d][SIM_US_CENTER] / s);
+      }
+      printf("\n");
+    }
+    print_fsm_laps(&rc);
+    printf("update   %u calls, %.0f cycles mean, %llu max\n",
+           st->updates, cyc, (unsigned long long)st->cycles_max);
+    const double per_s = (vsec > 0.0) ? 1.0 / vsec : 0.0;
+    printf("irq      TIM4 %u (%.0f/s)  DMA %u (%.0f/s)  sonic wake %u (%.0f/s)\n", SimHal_Tim4Irq(), SimHal_Tim4Irq() * per_s,
+           SimHal_DmaIrq(), SimHal_DmaIrq() * per_s, st->sonic_runs, st->sonic_runs * per_s);
+  }
+  printf("%s laps=%u/%d lap_ms=%u min_clear=%.1f contacts=%u contact_ms=%u virtual=%.3f wall=%.4f x%.0f",
+         s_trk.name, c->laps, laps, c->laps ? c->lap_ms[0] : 0u, c->min_clear_cm,
+         c->contacts, c->contact_ms, vsec, w1 - w0, (w1 > w0) ? vsec / (w1 - w0) : 0.0);
+  for (uint8_t d = 0; d < SIM_DRIVE_NUM; ++d)
+    printf(" %s_ms=%u", SimBoard_DriveName((SimDrive_t)d), rc.drive_ms[d]);
+  printf(" cyc=%.0f\n", cyc);
+  return (c->laps >= (unsigned)laps) ? 0 : 3;
+}
@@ -0,0 +1,510 @@
+/*
+ * tune_main.c — 튜닝 파라미터 자동 탐색 (CMA-ES + 트랙 시뮬레이터)
+ *
+ *  사용법: tune [-g 세대] [-n 개체수] [-j 병렬수] [-t 트랙당 최대초] [-l 랩수]
+ *               [-c 최소여유cm] [-s 시드] [-o best.txt] 트랙.trk ...
+ *   -g  세대 수 (기본 60)
+ *   -n  세대당 후보 수 (기본 4 + 3 ln 차원)
+ *   -j  동시 실행 프로세스 (기본 코어 수)
+ *   -t  트랙당 최대 가상 시간(초, 기본 90) — 못 돌면 남은 게이트 비율만큼 벌점
+ *   -c  최소 여유(차체 외곽~벽, cm, 기본 3) — 제약: 전 트랙에서 이 이상
+ *   -o  최적 파라미터 출력 (기본 build/tune_best.txt, UART 에 그대로 붙여넣는 set 명령)
+ *
+ *  - 탐색 공간은 아래 DIMS (param.h 이름, 범위는 param.c 보다 좁게) 를 [0,1] 로 정규화
+ *  - 후보 × 트랙 을 프로세스 하나씩 fork (펌웨어가 전역 상태라 스레드 대신)
+ *  - 목적: Σ 랩 시간 (미완주 = 제한 시간 + 남은 비율), 여유 부족/접촉은 큰 벌점
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "sim_car.h"
+#include "param.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define TUNE_MAX_DIM     32u
+#define TUNE_MAX_POP     64u
+#define TUNE_MAX_TRACKS   8u
+
+// ==== 탐색 공간 ====
+typedef struct { const char *name; int16_t lo, hi; } dim_t;
+
+static const dim_t DIMS[] = {
+  { "FRONT_PIVOT_CM",    40,   90 },   // automode.c 가 40..90 으로 clamp
+  { "FRONT_ARC_CM",      55,  110 },
+  { "FRONT_CLEAR_CM",    50,   95 },
+  { "FRONT_TOO_CLOSE",    5,   30 },
+  { "TURN_MS",          150,  800 },
+  { "ARC_MIN_MS",       100,  700 },
+  { "ARC_MAX_MS",       400, 2000 },
+  { "DECIDE_EVERY_MS",   10,  100 },
+  { "HOLD_DRIVE_MS",      0,  400 },
+  { "HOLD_TURN_MS",       0,  400 },
+  { "VC_FAST_CLOSE_CMS",-300, -20 },
+  { "VC_FAST_OPEN_CMS",  20,  300 },
+  { "BUMP_WINDOW_MS",     0,  800 },
+  { "BUMP_HOLD_MS",       0,  600 },
+  { "CHAIN_MS",           0,  800 },
+  { "GOV_SLOW_CM",       40,  120 },
+  { "GOV_FAST_CM",       45,  130 },
+  { "SPEED_MIN",        250,  600 },
+  { "SPEED_BASE",       300,  700 },
+  { "SPEED_CRUISE",     350,  900 },
+  { "SPEED_MAX",        500, 1009 },
+  { "STEP_UP",           10,  150 },
+  { "STEP_DOWN",         30,  400 },
+  { "STEP_DIFF",         10,  200 },
+};
+#define NDIM  ((uint32_t)(sizeof DIMS / sizeof DIMS[0]))
+
+static int dim_of(const char *name)
+{
+  for (uint32_t i = 0; i < NDIM; ++i) if (!strcmp(DIMS[i].name, name)) return (int)i;
+  return -1;
+}
+
+// 정규화 좌표 → 정수 파라미터 (+ param.c check_all 과 같은 상호조건 보정)
+static void decode(const double *x, int16_t *v)
+{
+  for (uint32_t i = 0; i < NDIM; ++i) {
+    const double u = (x[i] < 0.0) ? 0.0 : (x[i] > 1.0) ? 1.0 : x[i];
+    v[i] = (int16_t)lround(DIMS[i].lo + u * (DIMS[i].hi - DIMS[i].lo));
+  }
+  const int amin = dim_of("ARC_MIN_MS"), amax = dim_of("ARC_MAX_MS");
+  const int gs = dim_of("GOV_SLOW_CM"), gf = dim_of("GOV_FAST_CM");
+  const int smin = dim_of("SPEED_MIN"), sb = dim_of("SPEED_BASE"), sc = dim_of("SPEED_CRUISE"), smax = dim_of("SPEED_MAX");
+
+  if (v[amax] < v[amin]) v[amax] = v[amin];
+  if (v[gf] < v[gs])     v[gf] = v[gs];
+  if (v[smin] > v[sb])   v[smin] = v[sb];
+  if (v[smin] > v[sc])   v[smin] = v[sc];
+  if (v[smax] < v[sb])   v[smax] = v[sb];
+  if (v[smax] < v[sc])   v[smax] = v[sc];
+}
+
+static void encode(const int16_t *v, double *x)
+{
+  for (uint32_t i = 0; i < NDIM; ++i)
+    x[i] = (double)(v[i] - DIMS[i].lo) / (double)(DIMS[i].hi - DIMS[i].lo);
+}
+
+// ==== 평가 (자식 프로세스) ====
+typedef struct {
+  uint8_t  ok;               // 파라미터 적용 성공
+  uint8_t  laps;
+  uint16_t gates;            // 통과한 게이트 수 (랩 포함 누적)
+  uint32_t lap_ms;           // 목표 랩 완료 시각
+  float    min_clear;
+  uint32_t contacts;
+} track_result_t;
+
+typedef struct {
+  SimCar_t *car;
+  uint8_t   laps_goal;
+} tick_ctx_t;
+
+static SimTrack_t s_trk[TUNE_MAX_TRACKS];
+static uint32_t   s_trk_num = 0;
+static SimCar_t   s_car;
+
+static double   s_sec = 90.0;
+static int      s_laps = 1;
+static double   s_clear_min = 3.0;
+
+static void on_tick(uint32_t now_ms, void *ctx)
+{
+  tick_ctx_t *tc = (tick_ctx_t *)ctx;
+  SimCar_Step(tc->car, now_ms);
+  if (tc->car->laps >= tc->laps_goal) SimTask_Stop();
+}
+
+static void run_track(const SimTrack_t *trk, const int16_t *v, track_result_t *out)
+{
+  char kvbuf[NDIM][40];
+  const char *kv[NDIM];
+  for (uint32_t i = 0; i < NDIM; ++i) {
+    snprintf(kvbuf[i], sizeof kvbuf[i], "%s=%d", DIMS[i].name, v[i]);
+    kv[i] = kvbuf[i];
+  }
+
+  SimCarParams_t p;
+  SimCar_DefaultParams(&p);
+  SimBoard_Init(SimCar_Range, &s_car);
+  SimCar_Init(&s_car, trk, &p);
+
+  *out = (track_result_t){0};
+  if (!SimBoard_SetParams(kv, (int)NDIM)) return;
+  out->ok = 1;
+
+  tick_ctx_t tc = { &s_car, (uint8_t)s_laps };
+  SimBoard_Run((uint32_t)(s_sec * 1000.0), on_tick, &tc);
+
+  out->laps      = s_car.laps;
+  out->gates     = (uint16_t)(s_car.laps * trk->gate_num + s_car.gate_next);
+  out->lap_ms    = (s_car.laps >= (unsigned)s_laps) ? HAL_GetTick() : 0u;
+  out->min_clear = s_car.min_clear_cm;
+  out->contacts  = s_car.contacts;
+}
+
+// ==== 병렬 실행: 후보 × 트랙 을 프로세스 하나씩 ====
+typedef struct { pid_t pid; int fd; uint32_t job; } slot_t;
+
+static void eval_all(int16_t (*v)[NDIM], uint32_t ncand, uint32_t jobs, track_result_t *res)
+{
+  const uint32_t njob = ncand * s_trk_num;
+  slot_t   slot[TUNE_MAX_POP];
+  uint32_t running = 0, next = 0;
+
+  if (jobs > TUNE_MAX_POP) jobs = TUNE_MAX_POP;
+  fflush(stdout);
+
+  while (next < njob || running > 0) {
+    while (next < njob && running < jobs) {
+      int fds[2];
+      if (pipe(fds) != 0) { perror("pipe"); exit(1); }
+      const pid_t pid = fork();
+      if (pid < 0) { perror("fork"); exit(1); }
+      if (pid == 0) {
+        close(fds[0]);
+        track_result_t r;
+        run_track(&s_trk[next % s_trk_num], v[next / s_trk_num], &r);
+        _exit(write(fds[1], &r, sizeof r) == (ssize_t)sizeof r ? 0 : 1);
+      }
+      close(fds[1]);
+      slot[running++] = (slot_t){ pid, fds[0], next++ };
+    }
+
+    int st;
+    const pid_t done = waitpid(-1, &st, 0);
+    for (uint32_t k = 0; k < running; ++k) {
+      if (slot[k].pid != done) continue;
+      track_result_t *r = &res[slot[k].job];
+      if (read(slot[k].fd, r, sizeof *r) != (ssize_t)sizeof *r) *r = (track_result_t){0};
+      close(slot[k].fd);
+      slot[k] = slot[--running];
+      break;
+    }
+  }
+}
+
+// 후보 하나의 점수 (작을수록 좋음). feasible = 전 트랙 완주 + 최소 여유 이상
+static double score(const track_result_t *r, bool *feasible, double *lap_s, double *clear)
+{
+  double f = 0.0, laps = 0.0, mc = 1e9;
+  bool ok = true;
+  for (uint32_t t = 0; t < s_trk_num; ++t) {
+    const uint32_t total = (uint32_t)s_laps * s_trk[t].gate_num;
+    if (!r[t].ok) { ok = false; f += 1e6; continue; }
+    if (r[t].lap_ms) {
+      f += r[t].lap_ms / 1000.0;
+      laps += r[t].lap_ms / 1000.0;
+    } else {
+      ok = false;
+      const uint32_t left = (r[t].gates < total) ? total - r[t].gates : 0u;
+      f += s_sec * (1.0 + (double)left / (double)total);
+    }
+    if (r[t].min_clear < mc) mc = r[t].min_clear;
+    if (r[t].min_clear < s_clear_min) { ok = false; f += 20.0 * (s_clear_min - r[t].min_clear); }
+    f += 10.0 * r[t].contacts;
+  }
+  *feasible = ok; *lap_s = laps; *clear = mc;
+  return f;
+}
+
+// ==== CMA-ES (Hansen, "The CMA Evolution Strategy: A Tutorial") ====
+static uint64_t s_rng = 0x9E3779B97F4A7C15ull;
+
+static double urand(void)
+{
+  s_rng ^= s_rng >> 12; s_rng ^= s_rng << 25; s_rng ^= s_rng >> 27;
+  return (double)((s_rng * 0x2545F4914F6CDD1Dull) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static double nrand(void)
+{
+  double u = urand();
+  if (u < 1e-300) u = 1e-300;
+  return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * urand());
+}
+
+// 대칭행렬 고유분해 (Jacobi 회전) — A = B diag(d) B^T, n ≤ 32 라 충분
+static void eigen_sym(uint32_t n, double A[][TUNE_MAX_DIM], double B[][TUNE_MAX_DIM], double *d)
+{
+  double a[TUNE_MAX_DIM][TUNE_MAX_DIM];
+  memcpy(a, A, sizeof a);
+  for (uint32_t i = 0; i < n; ++i)
+    for (uint32_t j = 0; j < n; ++j) B[i][j] = (i == j) ? 1.0 : 0.0;
+
+  for (int sweep = 0; sweep < 100; ++sweep) {
+    double off = 0.0;
+    for (uint32_t p = 0; p < n; ++p) for (uint32_t q = p + 1; q < n; ++q) off += a[p][q] * a[p][q];
+    if (off < 1e-30) break;
+
+    for (uint32_t p = 0; p < n; ++p) {
+      for (uint32_t q = p + 1; q < n; ++q) {
+        if (fabs(a[p][q]) < 1e-300) continue;
+        const double th = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+        const double t  = ((th >= 0.0) ? 1.0 : -1.0) / (fabs(th) + sqrt(th * th + 1.0));
+        const double c  = 1.0 / sqrt(t * t + 1.0), s = t * c;
+        for (uint32_t k = 0; k < n; ++k) {
+          const double akp = a[k][p], akq = a[k][q];
+          a[k][p] = c * akp - s * akq; a[k][q] = s * akp + c * akq;
+        }
+        for (uint32_t k = 0; k < n; ++k) {
+          const double apk = a[p][k], aqk = a[q][k];
+          a[p][k] = c * apk - s * aqk; a[q][k] = s * apk + c * aqk;
+        }
+        for (uint32_t k = 0; k < n; ++k) {
+          const double bkp = B[k][p], bkq = B[k][q];
+          B[k][p] = c * bkp - s * bkq; B[k][q] = s * bkp + c * bkq;
+        }
+      }
+    }
+  }
+  for (uint32_t i = 0; i < n; ++i) d[i] = a[i][i];
+}
+
+typedef struct {
+  uint32_t n, lambda, mu;
+  double   w[TUNE_MAX_POP], mueff;
+  double   cc, cs, c1, cmu, damps, chiN;
+
+  double   m[TUNE_MAX_DIM], sigma;
+  double   pc[TUNE_MAX_DIM], ps[TUNE_MAX_DIM];
+  double   C[TUNE_MAX_DIM][TUNE_MAX_DIM];
+  double   B[TUNE_MAX_DIM][TUNE_MAX_DIM], D[TUNE_MAX_DIM];
+  uint32_t gen, eigen_gen;
+} cma_t;
+
+static void cma_init(cma_t *c, uint32_t n, uint32_t lambda, const double *x0, double sigma0)
+{
+  memset(c, 0, sizeof *c);
+  c->n = n; c->lambda = lambda; c->mu = lambda / 2u;
+
+  double sw = 0.0, sw2 = 0.0;
+  for (uint32_t i = 0; i < c->mu; ++i) {
+    c->w[i] = log(c->mu + 0.5) - log(i + 1.0);
+    sw += c->w[i];
+  }
+  for (uint32_t i = 0; i < c->mu; ++i) { c->w[i] /= sw; sw2 += c->w[i] * c->w[i]; }
+  c->mueff = 1.0 / sw2;
+
+  const double N = (double)n;
+  c->cc    = (4.0 + c->mueff / N) / (N + 4.0 + 2.0 * c->mueff / N);
+  c->cs    = (c->mueff + 2.0) / (N + c->mueff + 5.0);
+  c->c1    = 2.0 / ((N + 1.3) * (N + 1.3) + c->mueff);
+  c->cmu   = fmin(1.0 - c->c1, 2.0 * (c->mueff - 2.0 + 1.0 / c->mueff) / ((N + 2.0) * (N + 2.0) + c->mueff));
+  c->damps = 1.0 + 2.0 * fmax(0.0, sqrt((c->mueff - 1.0) / (N + 1.0)) - 1.0) + c->cs;
+  c->chiN  = sqrt(N) * (1.0 - 1.0 / (4.0 * N) + 1.0 / (21.0 * N * N));
+
+  memcpy(c->m, x0, n * sizeof(double));
+  c->sigma = sigma0;
+  for (uint32_t i = 0; i < n; ++i) { c->C[i][i] = 1.0; c->B[i][i] = 1.0; c->D[i] = 1.0; }
+}
+
+// x = m + σ B D z
+static void cma_sample(const cma_t *c, double (*x)[TUNE_MAX_DIM])
+{
+  for (uint32_t k = 0; k < c->lambda; ++k) {
+    double z[TUNE_MAX_DIM];
+    for (uint32_t i = 0; i < c->n; ++i) z[i] = c->D[i] * nrand();
+    for (uint32_t i = 0; i < c->n; ++i) {
+      double y = 0.0;
+      for (uint32_t j = 0; j < c->n; ++j) y += c->B[i][j] * z[j];
+      x[k][i] = c->m[i] + c->sigma * y;
+    }
+  }
+}
+
+// order: 점수 오름차순 후보 인덱스
+static void cma_update(cma_t *c, double (*x)[TUNE_MAX_DIM], const uint32_t *order)
+{
+  const uint32_t n = c->n;
+  double m_old[TUNE_MAX_DIM], yw[TUNE_MAX_DIM] = {0};
+  memcpy(m_old, c->m, sizeof m_old);
+
+  for (uint32_t i = 0; i < n; ++i) {
+    double s = 0.0;
+    for (uint32_t k = 0; k < c->mu; ++k) s += c->w[k] * x[order[k]][i];
+    c->m[i] = s;
+    yw[i] = (s - m_old[i]) / c->sigma;
+  }
+
+  // C^{-1/2} yw = B D^-1 B^T yw
+  double t[TUNE_MAX_DIM], inv[TUNE_MAX_DIM];
+  for (uint32_t j = 0; j < n; ++j) {
+    double s = 0.0;
+    for (uint32_t i = 0; i < n; ++i) s += c->B[i][j] * yw[i];
+    t[j] = s / c->D[j];
+  }
+  for (uint32_t i = 0; i < n; ++i) {
+    double s = 0.0;
+    for (uint32_t j = 0; j < n; ++j) s += c->B[i][j] * t[j];
+    inv[i] = s;
+  }
+
+  const double ks = sqrt(c->cs * (2.0 - c->cs) * c->mueff);
+  double ps_norm = 0.0;
+  for (uint32_t i = 0; i < n; ++i) {
+    c->ps[i] = (1.0 - c->cs) * c->ps[i] + ks * inv[i];
+    ps_norm += c->ps[i] * c->ps[i];
+  }
+  ps_norm = sqrt(ps_norm);
+
+  c->gen++;
+  const bool hsig = ps_norm / sqrt(1.0 - pow(1.0 - c->cs, 2.0 * c->gen)) / c->chiN < 1.4 + 2.0 / (n + 1.0);
+  const double kc = sqrt(c->cc * (2.0 - c->cc) * c->mueff);
+  for (uint32_t i = 0; i < n; ++i) c->pc[i] = (1.0 - c->cc) * c->pc[i] + (hsig ? kc * yw[i] : 0.0);
+
+  const double dh = hsig ? 0.0 : c->cc * (2.0 - c->cc);
+  for (uint32_t i = 0; i < n; ++i) {
+    for (uint32_t j = 0; j <= i; ++j) {
+      double rank_mu = 0.0;
+      for (uint32_t k = 0; k < c->mu; ++k) {
+        const double *xk = x[order[k]];
+        rank_mu += c->w[k] * ((xk[i] - m_old[i]) / c->sigma) * ((xk[j] - m_old[j]) / c->sigma);
+      }
+      const double v = (1.0 - c->c1 - c->cmu) * c->C[i][j]
+                     + c->c1 * (c->pc[i] * c->pc[j] + dh * c->C[i][j])
+                     + c->cmu * rank_mu;
+      c->C[i][j] = c->C[j][i] = v;
+    }
+  }
+
+  c->sigma *= exp((c->cs / c->damps) * (ps_norm / c->chiN - 1.0));
+
+  // 고유분해는 몇 세대에 한 번 (O(n^3))
+  if (c->gen - c->eigen_gen > (uint32_t)(c->lambda / (c->c1 + c->cmu) / n / 10.0)) {
+    c->eigen_gen = c->gen;
+    eigen_sym(n, c->C, c->B, c->D);
+    for (uint32_t i = 0; i < n; ++i) c->D[i] = sqrt(fmax(c->D[i], 1e-20));
+  }
+}
+
+// ==== 출력 ====
+static double wall_seconds(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static bool write_best(const char *path, const int16_t *v, uint32_t gen, double lap_s, double clear, bool feasible)
+{
+  FILE *f = fopen(path, "w");
+  if (f == NULL) { perror(path); return false; }
+  fprintf(f, "# tune: gen %u  %s  lap_sum=%.3f s  min_clear=%.1f cm (limit %.1f)\n",
+          gen, feasible ? "feasible" : "INFEASIBLE", lap_s, clear, s_clear_min);
+  fprintf(f, "# tracks:");
+  for (uint32_t t = 0; t < s_trk_num; ++t) fprintf(f, " %s", s_trk[t].name);
+  fprintf(f, "\n# USART2 에 그대로 붙여넣기 (param.c 명령)\n");
+  for (uint32_t i = 0; i < NDIM; ++i) fprintf(f, "set %s %d\n", DIMS[i].name, v[i]);
+  fprintf(f, "save\n");
+  fclose(f);
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t gens = 60, lambda = 4u + (uint32_t)(3.0 * log((double)NDIM)), jobs = 0;
+  const char *out = "build/tune_best.txt";
+  const char *tracks[TUNE_MAX_TRACKS];
+  uint32_t ntrk = 0;
+
+  for (int i = 1; i < argc; ++i) {
+    if      (!strcmp(argv[i], "-g") && i + 1 < argc) gens = (uint32_t)atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-n") && i + 1 < argc) lambda = (uint32_t)atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-j") && i + 1 < argc) jobs = (uint32_t)atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-t") && i + 1 < argc) s_sec = atof(argv[++i]);
+    else if (!strcmp(argv[i], "-l") && i + 1 < argc) s_laps = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-c") && i + 1 < argc) s_clear_min = atof(argv[++i]);
+    else if (!strcmp(argv[i], "-s") && i + 1 < argc) s_rng ^= strtoull(argv[++i], NULL, 0) * 0xBF58476D1CE4E5B9ull;
+    else if (!strcmp(argv[i], "-o") && i + 1 < argc) out = argv[++i];
+    else if (argv[i][0] != '-' && ntrk < TUNE_MAX_TRACKS) tracks[ntrk++] = argv[i];
+    else { ntrk = 0; break; }
+  }
+  if (ntrk == 0 || lambda < 4 || lambda > TUNE_MAX_POP || s_laps < 1 || s_laps > (int)SIM_CAR_MAX_LAPS) {
+    fprintf(stderr, "usage: %s [-g gens] [-n pop(4..%u)] [-j jobs] [-t sec] [-l laps] [-c clear_cm] [-s seed] [-o best.txt] track.trk ...\n",
+            argv[0], TUNE_MAX_POP);
+    return 2;
+  }
+  if (jobs == 0) { const long nc = sysconf(_SC_NPROCESSORS_ONLN); jobs = (nc > 0) ? (uint32_t)nc : 1u; }
+  for (uint32_t t = 0; t < ntrk; ++t) if (!SimTrack_Load(&s_trk[t], tracks[t])) return 1;
+  s_trk_num = ntrk;
+
+  // 시작점 = 현재 param.c 기본값
+  static int16_t v[TUNE_MAX_POP][NDIM];
+  static double  x[TUNE_MAX_POP][TUNE_MAX_DIM];
+  static track_result_t res[TUNE_MAX_POP * TUNE_MAX_TRACKS];
+  static cma_t   cma;
+
+  int16_t v0[NDIM];
+  double  x0[TUNE_MAX_DIM];
+  for (uint32_t i = 0; i < NDIM; ++i) {
+    const int id = Param_Find(DIMS[i].name);
+    if (id < 0) { fprintf(stderr, "tune: %s not in param table\n", DIMS[i].name); return 1; }
+    v0[i] = Param_Desc((param_id_t)id)->def;
+  }
+  encode(v0, x0);
+  cma_init(&cma, NDIM, lambda, x0, 0.2);
+
+  // 기준선
+  memcpy(v[0], v0, sizeof v0);
+  eval_all(v, 1, jobs, res);
+  bool   feas;
+  double lap_s, clear;
+  double best_f = score(res, &feas, &lap_s, &clear);
+  int16_t best_v[NDIM];
+  memcpy(best_v, v0, sizeof v0);
+  bool   best_feas = feas;
+  double best_lap = lap_s, best_clear = clear;
+  uint32_t best_gen = 0;
+  printf("base   score %8.3f  %s  lap_sum %.3f s  min_clear %.1f\n", best_f, feas ? "ok " : "---", lap_s, clear);
+
+  const double w0 = wall_seconds();
+  for (uint32_t g = 1; g <= gens; ++g) {
+    cma_sample(&cma, x);
+    for (uint32_t k = 0; k < lambda; ++k) decode(x[k], v[k]);
+    eval_all(v, lambda, jobs, res);
+
+    double   f[TUNE_MAX_POP];
+    uint32_t order[TUNE_MAX_POP], nfeas = 0;
+    for (uint32_t k = 0; k < lambda; ++k) {
+      const double sk = score(&res[k * s_trk_num], &feas, &lap_s, &clear);
+      // 박스 밖은 경계값으로 평가하고 거리만큼 벌점 (경계 근처 발산 방지, 탐색용만)
+      f[k] = sk;
+      for (uint32_t i = 0; i < NDIM; ++i) {
+        const double o = (x[k][i] < 0.0) ? -x[k][i] : (x[k][i] > 1.0) ? x[k][i] - 1.0 : 0.0;
+        f[k] += 100.0 * o * o;
+      }
+      nfeas += feas;
+      order[k] = k;
+      // 최적은 제약 만족 우선, 그다음 점수
+      if ((feas && !best_feas) || (feas == best_feas && sk < best_f)) {
+        best_f = sk; best_feas = feas; best_lap = lap_s; best_clear = clear; best_gen = g;
+        memcpy(best_v, v[k], sizeof best_v);
+      }
+    }
+    for (uint32_t a = 1; a < lambda; ++a)
+      for (uint32_t b = a; b > 0 && f[order[b]] < f[order[b - 1]]; --b) {
+        const uint32_t t = order[b]; order[b] = order[b - 1]; order[b - 1] = t;
+      }
+
+    cma_update(&cma, x, order);
+    printf("gen %-3u best %8.3f  gen_best %8.3f  feasible %2u/%u  sigma %.3f  wall %.1f s\n",
+           g, best_f, f[order[0]], nfeas, lambda, cma.sigma, wall_seconds() - w0);
+    if (cma.sigma < 1e-3) break;
+  }
+
+  printf("\nbest (gen %u) %s  lap_sum %.3f s  min_clear %.1f cm\n",
+         best_gen, best_feas ? "feasible" : "INFEASIBLE", best_lap, best_clear);
+  for (uint32_t i = 0; i < NDIM; ++i) printf(" -p %s=%d", DIMS[i].name, best_v[i]);
+  printf("\n");
+  return write_best(out, best_v, best_gen, best_lap, best_clear, best_feas) ? (best_feas ? 0 : 3) : 1;
+}
@@ -0,0 +1,117 @@
+#!/usr/bin/env bash
+#
+# batch.sh — 전 automode 변형 × 전 트랙 병렬 평가 → 순위표
+#
+#   ./batch.sh [-t 최대초] [-l 랩수] [-j 병렬수] [트랙.trk ...]
+#
+#   변형: 05.RC_CAR_AUTOMODE(main) + 05.RC_CAR_AUTOMODE_TEST/AUTOMODE01~13
+#   각 변형을 build/v<이름>/track_sim 으로 빌드 (진입점/주기는 Inc/sim_variant.h)
+#   결과: build/batch/runs.txt (실행별 한 줄), build/batch/rank.txt (순위표)
+#
+#   순위: 완주 트랙 수 ↓ → 총 시간 ↑ (미완주 트랙은 제한 시간으로 계산) → 접촉 ↑
+#
+
+set -eu
+cd "$(dirname "$0")"
+
+SEC=120
+LAPS=1
+JOBS=$(nproc 2>/dev/null || echo 1)
+
+while getopts "t:l:j:" opt; do
+  case $opt in
+    t) SEC=$OPTARG ;;
+    l) LAPS=$OPTARG ;;
+    j) JOBS=$OPTARG ;;
+    *) echo "usage: $0 [-t sec] [-l laps] [-j jobs] [track.trk ...]" >&2; exit 2 ;;
+  esac
+done
+shift $((OPTIND - 1))
+if [ $# -gt 0 ]; then TRACKS=("$@"); else TRACKS=(tracks/*.trk); fi
+
+OUT=build/batch
+mkdir -p "$OUT"
+
+# ---- 변형 목록: "이름 펌웨어트리 VARIANT" ----
+VARIANTS=("main ../05.RC_CAR_AUTOMODE -")
+for d in ../05.RC_CAR_AUTOMODE_TEST/AUTOMODE[0-9][0-9]; do
+  [ -d "$d/Src" ] || continue
+  n=${d##*AUTOMODE}
+  VARIANTS+=("$n $d $((10#$n))")
+done
+
+# ---- 빌드 (변형별 독립 BUILD 디렉터리라 병렬 안전) ----
+build_one() {
+  set -- $1
+  local v=""
+  [ "$3" = "-" ] || v="VARIANT=$3"
+  if ! make -s FW="$2" BUILD="build/v$1" $v "build/v$1/track_sim" >"$OUT/build_$1.log" 2>&1; then
+    echo "build failed: $1 (see $OUT/build_$1.log)" >&2
+  fi
+}
+export -f build_one
+export OUT
+printf '%s\n' "${VARIANTS[@]}" | xargs -P "$JOBS" -I{} bash -c 'build_one "{}"'
+
+# ---- 실행: 변형 × 트랙 ----
+JOBLIST=()
+for v in "${VARIANTS[@]}"; do
+  name=${v%% *}
+  [ -x "build/v$name/track_sim" ] || continue
+  for t in "${TRACKS[@]}"; do JOBLIST+=("$name $t"); done
+done
+
+run_one() {
+  set -- $1
+  local line
+  line=$("build/v$1/track_sim" -T "$2" -t "$SEC" -l "$LAPS" -q 2>/dev/null) || true
+  [ -n "$line" ] && echo "$1 $line"
+}
+export -f run_one
+export SEC LAPS
+
+t0=$(date +%s.%N)
+printf '%s\n' "${JOBLIST[@]}" | xargs -P "$JOBS" -I{} bash -c 'run_one "{}"' | sort >"$OUT/runs.txt"
+t1=$(date +%s.%N)
+
+# ---- 집계 ----
+# runs.txt: 변형 트랙 laps=a/b lap_ms=.. min_clear=.. contacts=.. contact_ms=.. virtual=.. wall=.. xN
+#           straight_ms=.. arc_ms=.. pivot_ms=.. reverse_ms=.. stop_ms=.. cyc=..
+awk -v sec="$SEC" -v ntrk="${#TRACKS[@]}" '
+{
+  v = $1
+  for (i = 3; i <= NF; ++i) { split($i, kv, "="); f[kv[1]] = kv[2] }
+  split(f["laps"], lp, "/")
+  done = (lp[1] + 0 >= lp[2] + 0)
+  vsec = f["virtual"] + 0
+  names[v] = 1
+  nd[v]   += done
+  tsum[v] += done ? vsec : sec
+  if (done) lap[v] += f["lap_ms"] / 1000.0
+  cont[v] += f["contacts"]
+  cms[v]  += f["contact_ms"]
+  if (!(v in mclr) || f["min_clear"] + 0 < mclr[v]) mclr[v] = f["min_clear"] + 0
+  st[v] += f["straight_ms"]; ar[v] += f["arc_ms"]; pv[v] += f["pivot_ms"]
+  rv[v] += f["reverse_ms"]; sp[v] += f["stop_ms"]
+  cyc[v] += f["cyc"]; nrun[v]++
+}
+END {
+  for (v in names) {
+    tot = st[v] + ar[v] + pv[v] + rv[v] + sp[v]; if (tot == 0) tot = 1
+    printf "%d %.3f %d %s %d/%d %.1f %.1f %d %.1f %5.1f %5.1f %5.1f %5.1f %5.1f %.0f\n",
+      nd[v], tsum[v], cont[v], v, nd[v], ntrk, tsum[v], (nd[v] ? lap[v] / nd[v] : 0),
+      cont[v], mclr[v],
+      100 * st[v] / tot, 100 * ar[v] / tot, 100 * pv[v] / tot, 100 * rv[v] / tot, 100 * sp[v] / tot,
+      cyc[v] / nrun[v]
+  }
+}' "$OUT/runs.txt" | sort -k1,1nr -k2,2n -k3,3n | awk '
+BEGIN {
+  printf "%-4s %-6s %-6s %9s %9s %8s %9s %6s %6s %6s %6s %6s %8s\n",
+         "rank", "var", "done", "total_s", "lap_avg", "contacts", "min_clr", "str%", "arc%", "piv%", "rev%", "stop%", "cyc/upd"
+}
+{
+  printf "%-4d %-6s %-6s %9s %9s %8s %9s %6s %6s %6s %6s %6s %8s\n",
+         NR, $4, $5, $6, $7, $8, $9, $10, $11, $12, $13, $14, $15
+}' | tee "$OUT/rank.txt"
+
+echo "runs ${#JOBLIST[@]}  jobs $JOBS  wall $(awk -v a="$t0" -v b="$t1" 'BEGIN { printf "%.2f", b - a }') s  → $OUT/runs.txt, $OUT/rank.txt"
@@ -0,0 +1,66 @@
+#!/usr/bin/env bash
+#
+# regress.sh — 주행 기록 아카이브 전체를 현재 automode.c 로 재생 → 한 번이라도 어긋나면 실패
+#
+#   ./regress.sh [-j 병렬수] [디렉터리 또는 rec.bin ...]      (기본 logs/)
+#
+#   기록: 차에서 "rec on" 으로 받은 USART2 캡처, 또는 track_sim -r
+#   rec.bin 옆에 rec.bin.args 가 있으면 replay 인자로 붙임 (차에서 쓰던 -p, 중간부터 받은 기록의 -s 등)
+#   결과: build/regress/results.txt (기록별 한 줄), 불일치 기록은 build/regress/<이름>.txt 에 상세
+#
+#   종료 코드: 0 = 전부 일치, 4 = 불일치 있음, 2 = 빌드/인자 오류
+#
+
+set -eu
+cd "$(dirname "$0")"
+
+JOBS=$(nproc 2>/dev/null || echo 1)
+
+while getopts "j:" opt; do
+  case $opt in
+    j) JOBS=$OPTARG ;;
+    *) echo "usage: $0 [-j jobs] [dir | rec.bin ...]" >&2; exit 2 ;;
+  esac
+done
+shift $((OPTIND - 1))
+[ $# -gt 0 ] || set -- logs
+
+LOGS=()
+for a in "$@"; do
+  if [ -d "$a" ]; then
+    while IFS= read -r f; do LOGS+=("$f"); done < <(find "$a" -name '*.bin' | sort)
+  else
+    LOGS+=("$a")
+  fi
+done
+if [ ${#LOGS[@]} -eq 0 ]; then echo "no logs in $*" >&2; exit 2; fi
+
+make -s build/replay || exit 2
+
+OUT=build/regress
+mkdir -p "$OUT"
+rm -f "$OUT"/*.txt
+
+run_one() {
+  local args="" line
+  [ -f "$1.args" ] && args=$(cat "$1.args")
+  line=$(build/replay "$1" -q $args 2>/dev/null) || true
+  echo "$line"
+  case $line in
+    *DIVERGED*) build/replay "$1" $args >"$OUT/$(basename "$1").txt" 2>&1 || true ;;
+  esac
+}
+export -f run_one
+export OUT
+
+t0=$(date +%s.%N)
+printf '%s\n' "${LOGS[@]}" | xargs -P "$JOBS" -I{} bash -c 'run_one "{}"' | sort >"$OUT/results.txt"
+t1=$(date +%s.%N)
+
+bad=$(grep -c DIVERGED "$OUT/results.txt" || true)
+grep DIVERGED "$OUT/results.txt" || true
+awk -v a="$t0" -v b="$t1" -v bad="$bad" '
+{ for (i = 3; i <= NF; ++i) if ($i ~ /^log=/) { sub(/^log=/, "", $i); sub(/s$/, "", $i); sec += $i } n++ }
+END { printf "logs %d  diverged %d  log time %.1f h  wall %.2f s\n", n, bad, sec / 3600, b - a }' "$OUT/results.txt"
+
+[ "$bad" -eq 0 ] || exit 4
@@ -1,8 +1,19 @@
-/* ultrasonic.h */
+/* ultrasonic.h — 소나 배열 (센서 N개, 타이머 여러 개)
+ *
+ *  - 하드웨어 배치는 const 표 (SonarDesc_t) 하나: 타이머, 채널, TRIG 핀, 장착 각
+ *    센서 추가(대각선 등) = 아래 sonar_idx_t 에 이름 + SONAR_BOARD[] 에 한 줄 (+ CubeMX 에서 채널/핀 설정)
+ *  - Sonar_t 는 측정 상태만 (표는 desc 로 가리킴)
+ *  - 캡처 ISR 분배: 타이머 칸 x 채널 4 라우팅 표 → 센서 수와 무관하게 O(1)
+ *    (타이머 칸 찾기는 서로 다른 타이머 수 ≤ SONAR_TIM_MAX 만큼만 비교)
+ *  - 에코 타이머는 1MHz 틱 (16/32비트 모두, 폭 계산에 ARR 사용)
+ *  - 거리는 정수 mm (us_range.h, 기온 보정) — ISR 에 float 없음
+ */
 #ifndef ULTRASONIC_H_
 #define ULTRASONIC_H_
 
 #include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
 
 #define TRIG_PORT_LEFT	  GPIOC
 #define TRIG_PIN_LEFT	    GPIO_PIN_8
@@ -11,39 +22,73 @@
 #define TRIG_PORT_CENTER	GPIOC
 #define TRIG_PIN_CENTER	  GPIO_PIN_6
 
-#define MEDIAN_WIN           3u   // 3 또는 5 권장
+#define SONAR_MAX         8u   // 센서 최대 수
+#define SONAR_TIM_MAX     4u   // 서로 다른 에코 타이머 최대 수
+#define SONAR_GAP_MS     40u   // 2m 환경: 충분한 센서 간격 (한 바퀴 = 센서 수 x 간격)
 
-// [설계도] 소나(Sonar) 센서 객체 정의
+// [설계도 1] 하드웨어 배치 (변하지 않음 → const 표, 플래시)
 typedef struct {
-    // 1. 하드웨어 설정 (변하지 않음)
-    TIM_HandleTypeDef *timer;        // 사용할 타이머 핸들 (&htim4)
-    uint32_t          channel;       // 타이머 채널 (TIM_CHANNEL_1 등)
-    uint32_t          clear_flag_bit;// 인터럽트 클리어 플래그 (TIM_FLAG_CC1OF 등)
-    GPIO_TypeDef      *trig_port;    // Trig 포트 (GPIOA 등)
-    uint16_t          trig_pin;      // Trig 핀 (GPIO_PIN_0 등)
-
-    // 2. 측정 데이터 (계속 변함)
-    volatile uint8_t  state;         // 0:대기, 1:Rising완료, 2:Falling완료
+    TIM_HandleTypeDef *timer;        // 에코 캡처 타이머 (&htim4 등, 1MHz 틱)
+    uint32_t          channel;       // TIM_CHANNEL_1..4
+    GPIO_TypeDef      *trig_port;    // Trig 포트
+    uint16_t          trig_pin;      // Trig 핀
+    int16_t           angle_deg;     // 장착 각 (정면 0, 왼쪽 +, 오른쪽 -)
+    const char        *name;         // 로그용
+} SonarDesc_t;
+
+// [설계도 2] 센서 하나의 측정 상태 (계속 변함)
+// 큰 필드부터 → ARM 24 B (state 를 앞에 두면 패딩 포함 28 B). 예전 Sonar_t 는 40 B (핀 + 메디안 버퍼 포함)
+typedef struct {
+    const SonarDesc_t *desc;         // 표의 한 줄
+    uint32_t          it_bit;        // TIM_IT_CCx (채널에서 계산)
     volatile uint32_t ic_start;      // Rising 시점의 타이머 값
     volatile uint32_t ic_end;        // Falling 시점의 타이머 값
-    volatile float    distance;      // 최종 계산된 거리 (cm)
+    volatile uint32_t count;         // 완료된 측정 수
+    volatile uint16_t mm;            // 최종 거리 (mm, 범위 밖이면 MAX_VALID_CM x 10 = 트인 공간)
+    volatile uint8_t  state;         // 0:대기, 1:Rising완료, 2:Falling완료
+} Sonar_t;
 
-    // 3. 필터용 버퍼 (개별 사물함)
-    uint16_t med_buf[MEDIAN_WIN];    // 과거 값 저장용 배열
-    uint8_t  med_head;               // 버퍼 인덱스
-    uint8_t  med_count;              // 버퍼 채워진 개수
+// 이 보드의 배치 (순서 = SONAR_BOARD[] 순서)
+typedef enum {
+    SONAR_LEFT = 0,
+    SONAR_RIGHT,
+    SONAR_CENTER,
+    SONAR_NUM
+} sonar_idx_t;
 
-} Sonar_t;
+extern const SonarDesc_t SONAR_BOARD[SONAR_NUM];
 
 // [함수 선언]
-void Sonar_Init(void);
-void Sonar_Trigger(Sonar_t *sonar);
-void Sonar_ISR_Process(Sonar_t *sonar);
-float Sonar_Get_Distance(Sonar_t *sonar);
-
-// (전역 객체 접근용 - main이나 다른 곳에서 쓸 수 있게)
-extern Sonar_t sonarLeft;
-extern Sonar_t sonarRight;
-extern Sonar_t sonarCenter;
+bool     Sonar_Init(const SonarDesc_t *desc, uint8_t n);  // 라우팅 표 + 캡처 시작 (개수/타이머 초과, 채널 중복이면 false)
+uint8_t  Sonar_Count(void);
+const Sonar_t *Sonar_Get(uint8_t idx);
+void     Sonar_Trigger(uint8_t idx);
+void     Sonar_Next(void);                                 // 표 순서대로 다음 센서 발사
+void     Sonar_Capture(TIM_HandleTypeDef *htim);           // HAL_TIM_IC_CaptureCallback 에서
+uint16_t Sonar_GetMm(uint8_t idx);
+float    Sonar_Get_Distance(uint8_t idx);                  // cm
+
+// ===== DWT 사이클 프로브 (보드 측정용, SONAR_PROF=0 으로 빌드하면 사라짐) =====
+//  - CAPTURE: HAL_TIM_IC_CaptureCallback 한 번 (분배 + 에지 처리)
+//  - NEXT   : Sonar_Next 한 번 (10us 트리거 펄스 ≈ 1000 사이클 @100MHz 포함)
+//  프로브 하나에 DWT 읽기 두 번 + 덧셈/비교 (약 10 사이클), 한 프로브는 한 문맥에서만 갱신
+#ifndef SONAR_PROF
+#define SONAR_PROF  1
+#endif
+
+typedef enum {
+    SONAR_PROF_CAPTURE = 0,
+    SONAR_PROF_NEXT,
+    SONAR_PROF_NUM
+} sonar_prof_t;
+
+typedef struct {
+    uint32_t calls;
+    uint32_t max;                    // 사이클
+    uint64_t sum;                    // 사이클
+} SonarProf_t;
+
+void     Sonar_ProfGet(sonar_prof_t id, SonarProf_t *out);  // 일관된 스냅샷 (SONAR_PROF=0 이면 0)
+void     Sonar_ProfReset(void);
 
 #endif /* ULTRASONIC_H_ */
@@ -0,0 +1,34 @@
+/*
+ * us_range.h — 에코 시간 → 거리 [mm] 고정소수점 변환 (기온 보정 음속, ultrasonic.c)
+ *
+ *  - 음속 c = 331.3 + 0.606 T [m/s] (T 기온 °C), 왕복이라 거리 [mm] = 에코 [us] x c / 2000
+ *  - 계수 하나 (mm/us 의 Q16) — 기온을 바꿀 때만 계산 (US_RangeSetTemp, 64비트 나눗셈은 여기서만)
+ *  - 변환은 32비트 곱 + 반올림 시프트 → 나눗셈 / FPU 없음, ISR 에서 불러도 FPU 문맥 저장 없음
+ *    계수 최대 (60°C) 12047 x 에코 65535us < 2^32
+ *  - 예전 에코/58 (정수 cm, 버림) = 22°C 쯤 음속을 고정으로 쓴 것 — 20°C 에선 0.4% 길게, 버림으로 평균 0.5cm 짧게
+ */
+
+#ifndef INC_US_RANGE_H_
+#define INC_US_RANGE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// 기온 [0.1°C]
+#ifndef US_TEMP_DC
+#define US_TEMP_DC      200     // 빌드 기본 20.0°C
+#endif
+#define US_TEMP_DC_MIN  (-200)
+#define US_TEMP_DC_MAX  600
+
+extern volatile uint32_t us_mm_q16;   // mm/us x 65536 (쓰기는 US_RangeSetTemp 만)
+
+static inline uint16_t US_EchoToMm(uint16_t echo_us)
+{
+  return (uint16_t)(((uint32_t)echo_us * us_mm_q16 + 0x8000u) >> 16);
+}
+
+bool    US_RangeSetTemp(int16_t temp_dc);   // 범위 밖이면 false (그대로)
+int16_t US_RangeGetTemp(void);
+
+#endif /* INC_US_RANGE_H_ */
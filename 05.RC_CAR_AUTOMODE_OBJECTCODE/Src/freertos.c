@@ -26,7 +26,7 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "cmsis_os2.h"
-#include "ultrasonic.h"        // US_Left_cm/Right/Center
+#include "ultrasonic.h"        // Sonar_Next / Sonar_Get_Distance
 #include "automode.h"          // 자동주행 상태 getter (아래 참고)
 #include "stdio.h"
 #include "robot_driver.h"
@@ -143,6 +143,8 @@ void ultrasonic(void *argument)
   /* Infinite loop */
   for(;;)
   {
+	Sonar_Next();            // 배치 표 순서대로 한 개씩 (거리는 캡처 ISR 이 갱신)
+	osDelay(SONAR_GAP_MS);
   }
   /* USER CODE END ultrasonic */
 }
@@ -155,7 +157,6 @@ void ultrasonic(void *argument)
 */
 /* USER CODE END Header_automode */
 extern RobotCar_t myRobot; // 전역 로봇 객체
-extern Sonar_t sonarLeft, sonarRight, sonarCenter; // 외부 객체 가져오기
 
 void automode(void *argument)
 {
@@ -167,9 +168,9 @@ void automode(void *argument)
   {
   	// 1. [SENSE] 세상의 상태를 찰칵! 찍는다 (Input 생성)
 		AutoInput_t input = {
-				.Dist_L = (uint16_t)Sonar_Get_Distance(&sonarLeft),
-				.Dist_R = (uint16_t)Sonar_Get_Distance(&sonarRight),
-				.Dist_C = (uint16_t)Sonar_Get_Distance(&sonarCenter),
+				.Dist_L = (uint16_t)Sonar_Get_Distance(SONAR_LEFT),
+				.Dist_R = (uint16_t)Sonar_Get_Distance(SONAR_RIGHT),
+				.Dist_C = (uint16_t)Sonar_Get_Distance(SONAR_CENTER),
 				.Current_Time_ms = HAL_GetTick()
 		};
 
@@ -201,6 +202,16 @@ void debugtask(void *argument)
 //  		printf("[TURN] F=%u L=%u R=%u\n", US_Center_cm(), US_Left_cm(), US_Right_cm());
 //
 //      osDelay(200);
+#if SONAR_PROF
+	// 소나 프로브 (사이클 @ SystemCoreClock): 호출 수 / 평균 / 최대, 1초마다
+	SonarProf_t cap, nxt;
+	Sonar_ProfGet(SONAR_PROF_CAPTURE, &cap);
+	Sonar_ProfGet(SONAR_PROF_NEXT, &nxt);
+	printf("[SONAR] cap n=%lu avg=%lu max=%lu  next n=%lu avg=%lu max=%lu\r\n",
+	       (unsigned long)cap.calls, (unsigned long)(cap.calls ? cap.sum / cap.calls : 0u), (unsigned long)cap.max,
+	       (unsigned long)nxt.calls, (unsigned long)(nxt.calls ? nxt.sum / nxt.calls : 0u), (unsigned long)nxt.max);
+#endif
+	osDelay(1000);
   }
   /* USER CODE END debugtask */
 }
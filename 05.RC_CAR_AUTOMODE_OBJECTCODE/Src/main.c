@@ -98,7 +98,6 @@ void MX_FREERTOS_Init(void);
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
 extern RobotCar_t myRobot; // 전역 로봇 객체
-extern Sonar_t sonarLeft, sonarRight, sonarCenter;
 
 // [Actuator] 뇌의 명령을 하드웨어로 번역하는 함수
 // (이건 하드웨어를 건드리니까 main.c 에 두는 게 좋음)
@@ -161,9 +160,8 @@ int main(void)
   HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_1);
   HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_2);
   HAL_TIM_Base_Start(&htim11); // for delay_us() Function
-  HAL_TIM_IC_Start_IT(&htim4, TIM_CHANNEL_1);
-  HAL_TIM_IC_Start_IT(&htim4, TIM_CHANNEL_2);
-  HAL_TIM_IC_Start_IT(&htim4, TIM_CHANNEL_3);
+  // 에코 캡처 시작 + 채널 → 센서 라우팅 (배치는 ultrasonic.c SONAR_BOARD)
+  if (!Sonar_Init(SONAR_BOARD, SONAR_NUM)) Error_Handler();
 
   motor_speedInit(&myRobot);
   motor_init(&myRobot);
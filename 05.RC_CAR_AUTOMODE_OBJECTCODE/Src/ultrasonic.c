@@ -6,7 +6,9 @@
  */
 
 #include "ultrasonic.h"
+#include "us_range.h"
 #include "delay_us.h"
+#include "tim.h"
 #include <string.h> // memset 사용을 위해
 #include <stdint.h>
 #include <stdbool.h>
@@ -15,117 +17,235 @@
 #define MAX_VALID_CM       400u   // 상한(환경에 맞춰 조정)
 #define MIN_VALID_CM         2u   // 너무 작은 쓰레기 펄스 제거
 #define FRAME_TIMEOUT_MS    80u   // 2m 환경 기준, 프레임 타임아웃
-#define TRIG_GAP_MS         40u   // 2m 환경: 충분한 센서 간격 (L-C-R-C)
 
+#define ROUTE_NONE        0xFFu
 
-// 1. 전역 객체 생성 (배열 대신 이것들을 씁니다!)
-Sonar_t sonarLeft = {
-    .timer = &htim4,
-    .channel = TIM_CHANNEL_2,        // Left는 CH2
-    .clear_flag_bit = TIM_FLAG_CC2OF,
-    .trig_port = TRIG_PORT_LEFT,     // 기존 define 활용
-    .trig_pin  = TRIG_PIN_LEFT
+// 1. 보드 배치 표 (센서 추가는 여기 한 줄 + ultrasonic.h 의 sonar_idx_t)
+const SonarDesc_t SONAR_BOARD[SONAR_NUM] = {
+    [SONAR_LEFT]   = { &htim4, TIM_CHANNEL_2, TRIG_PORT_LEFT,   TRIG_PIN_LEFT,    90, "L" },
+    [SONAR_RIGHT]  = { &htim4, TIM_CHANNEL_1, TRIG_PORT_RIGHT,  TRIG_PIN_RIGHT,  -90, "R" },
+    [SONAR_CENTER] = { &htim4, TIM_CHANNEL_3, TRIG_PORT_CENTER, TRIG_PIN_CENTER,   0, "C" },
 };
-
-Sonar_t sonarRight = {
-    .timer = &htim4,
-    .channel = TIM_CHANNEL_1,        // Right는 CH1
-    .clear_flag_bit = TIM_FLAG_CC1OF,
-    .trig_port = TRIG_PORT_RIGHT,
-    .trig_pin  = TRIG_PIN_RIGHT
+_Static_assert(SONAR_NUM <= SONAR_MAX, "SONAR_BOARD 가 SONAR_MAX 보다 큼");
+
+// 2. 측정 상태 + ISR 라우팅 표
+static Sonar_t            sonar[SONAR_MAX];
+static uint8_t            sonar_num = 0;
+static uint8_t            next_idx  = 0;                        // Sonar_Next 순번
+static TIM_HandleTypeDef *tim_slot[SONAR_TIM_MAX];               // 라우팅 표의 타이머 칸
+static uint8_t            tim_num   = 0;
+static uint8_t            route[SONAR_TIM_MAX][4];              // [타이머 칸][채널 0..3] → 센서 번호
+
+// htim->Channel (HAL_TIM_ACTIVE_CHANNEL_1/2/3/4 = 1/2/4/8) → 채널 0..3
+static const uint8_t CH_OF_ACTIVE[9] = {
+    ROUTE_NONE, 0u, 1u, ROUTE_NONE, 2u, ROUTE_NONE, ROUTE_NONE, ROUTE_NONE, 3u
 };
 
-Sonar_t sonarCenter = {
-    .timer = &htim4,
-    .channel = TIM_CHANNEL_3,        // Center는 CH3
-    .clear_flag_bit = TIM_FLAG_CC3OF,
-    .trig_port = TRIG_PORT_CENTER,
-    .trig_pin  = TRIG_PIN_CENTER
-};
+// 3. DWT 사이클 프로브 (ultrasonic.h)
+#if SONAR_PROF
+static SonarProf_t prof[SONAR_PROF_NUM];
 
-// 2. 매니저 변수 (구조체에 포함 안 된 녀석들)
-static volatile uint8_t frame_mask = 0;
-// static uint32_t frame_start_ms = 0; // 필요하면 유지
+static inline uint32_t prof_begin(void) { return DWT->CYCCNT; }
 
-// [트리거 함수] 특정 소나 객체 하나를 동작시킴
-void Sonar_Trigger(Sonar_t *sonar)
+static inline void prof_end(sonar_prof_t id, uint32_t t0)
 {
-    // 1. 기존 플래그/상태 클리어
-    __HAL_TIM_CLEAR_FLAG(sonar->timer, sonar->clear_flag_bit);
-    // 오버캡처 플래그도 안전하게 지워줌 (옵션)
-    __HAL_TIM_CLEAR_FLAG(sonar->timer, TIM_FLAG_CC1OF | TIM_FLAG_CC2OF | TIM_FLAG_CC3OF | TIM_FLAG_CC4OF);
+    const uint32_t dc = DWT->CYCCNT - t0;
+    SonarProf_t *p = &prof[id];
+    p->calls++;
+    p->sum += dc;
+    if (dc > p->max) p->max = dc;
+}
+#else
+static inline uint32_t prof_begin(void) { return 0u; }
+static inline void     prof_end(sonar_prof_t id, uint32_t t0) { (void)id; (void)t0; }
+#endif
 
-    // 2. 상태 초기화
-    sonar->state = 0; // Rising 대기 상태로
+void Sonar_ProfGet(sonar_prof_t id, SonarProf_t *out)
+{
+#if SONAR_PROF
+    __disable_irq();
+    *out = prof[id];
+    __enable_irq();
+#else
+    (void)id;
+    memset(out, 0, sizeof *out);
+#endif
+}
 
-    // 3. 캡처 극성을 Rising으로 설정
-    __HAL_TIM_SET_CAPTUREPOLARITY(sonar->timer, sonar->channel, TIM_INPUTCHANNELPOLARITY_RISING);
+void Sonar_ProfReset(void)
+{
+#if SONAR_PROF
+    __disable_irq();
+    memset(prof, 0, sizeof prof);
+    __enable_irq();
+#endif
+}
+
+// TIM_CHANNEL_1/2/3/4 (0/4/8/C) → 0..3
+static inline uint8_t ch_index(uint32_t channel) { return (uint8_t)(channel >> 2); }
 
-    // 4. 인터럽트 활성화
-    __HAL_TIM_ENABLE_IT(sonar->timer, sonar->channel);
+static uint8_t tim_slot_of(TIM_HandleTypeDef *htim)
+{
+    for (uint8_t t = 0; t < tim_num; ++t) {
+        if (tim_slot[t] == htim) return t;
+    }
+    return ROUTE_NONE;
+}
+
+bool Sonar_Init(const SonarDesc_t *desc, uint8_t n)
+{
+    sonar_num = 0;
+    tim_num   = 0;
+    next_idx  = 0;
+    memset(route, ROUTE_NONE, sizeof route);
+    if (n > SONAR_MAX) return false;
+
+#if SONAR_PROF
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;   // 디버거 없이도 DWT 사용
+    DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+    Sonar_ProfReset();
+#endif
+
+    for (uint8_t i = 0; i < n; ++i) {
+        const SonarDesc_t *d = &desc[i];
+        if (d->channel > TIM_CHANNEL_4 || (d->channel & 3u) != 0u) return false;
+
+        uint8_t t = tim_slot_of(d->timer);
+        if (t == ROUTE_NONE) {
+            if (tim_num >= SONAR_TIM_MAX) return false;
+            t = tim_num++;
+            tim_slot[t] = d->timer;
+        }
+        const uint8_t ch = ch_index(d->channel);
+        if (route[t][ch] != ROUTE_NONE) return false;   // 같은 채널 두 번
+        route[t][ch] = i;
+
+        memset(&sonar[i], 0, sizeof sonar[i]);
+        sonar[i].desc   = d;
+        sonar[i].it_bit = TIM_IT_CC1 << ch;
+        sonar[i].mm     = MAX_VALID_CM * 10u;
+        sonar[i].state  = 2;
+    }
+    sonar_num = n;
+
+    // 캡처만 켬, CC 인터럽트는 발사할 때 그 채널만 (Sonar_Trigger)
+    for (uint8_t i = 0; i < n; ++i) {
+        if (HAL_TIM_IC_Start(desc[i].timer, desc[i].channel) != HAL_OK) return false;
+    }
+    return true;
+}
+
+uint8_t Sonar_Count(void) { return sonar_num; }
+
+const Sonar_t *Sonar_Get(uint8_t idx)
+{
+    return (idx < sonar_num) ? &sonar[idx] : NULL;
+}
 
-    // 5. 트리거 펄스 발사 (10us)
-    HAL_GPIO_WritePin(sonar->trig_port, sonar->trig_pin, GPIO_PIN_RESET);
-    // delay_us(1); // 필요시
-    HAL_GPIO_WritePin(sonar->trig_port, sonar->trig_pin, GPIO_PIN_SET);
+// [트리거 함수] 센서 하나를 동작시킴
+void Sonar_Trigger(uint8_t idx)
+{
+    if (idx >= sonar_num) return;
+    Sonar_t *s = &sonar[idx];
+    const SonarDesc_t *d = s->desc;
+    const uint8_t ch = ch_index(d->channel);
+
+    // 1. 이 채널의 인터럽트/플래그만 정리 (같은 타이머의 다른 센서는 건드리지 않음)
+    __HAL_TIM_DISABLE_IT(d->timer, s->it_bit);
+    __HAL_TIM_CLEAR_FLAG(d->timer, (TIM_FLAG_CC1 | TIM_FLAG_CC1OF) << ch);
+
+    // 2. 상태 초기화 + Rising 부터
+    s->state = 0;
+    __HAL_TIM_SET_CAPTUREPOLARITY(d->timer, d->channel, TIM_INPUTCHANNELPOLARITY_RISING);
+    __HAL_TIM_ENABLE_IT(d->timer, s->it_bit);
+
+    // 3. 트리거 펄스 발사 (10us)
+    HAL_GPIO_WritePin(d->trig_port, d->trig_pin, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(d->trig_port, d->trig_pin, GPIO_PIN_SET);
     delay_us(10);   // 10us 유지
-    HAL_GPIO_WritePin(sonar->trig_port, sonar->trig_pin, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(d->trig_port, d->trig_pin, GPIO_PIN_RESET);
+}
+
+// 배치 순서대로 한 개씩 (sonic 태스크가 SONAR_GAP_MS 마다)
+void Sonar_Next(void)
+{
+    if (sonar_num == 0u) return;
+    const uint32_t t0 = prof_begin();
+    Sonar_t *prev = &sonar[(next_idx + sonar_num - 1u) % sonar_num];
+    if (prev->state != 2) {
+        // 에코가 간격 안에 안 끝남 → 늦은 에지가 다음 센서 때 들어오지 않게 끔 (거리는 이전 값)
+        __HAL_TIM_DISABLE_IT(prev->desc->timer, prev->it_bit);
+        prev->state = 2;
+    }
+    Sonar_Trigger(next_idx);
+    next_idx = (uint8_t)((next_idx + 1u) % sonar_num);
+    prof_end(SONAR_PROF_NEXT, t0);
+}
+
+// 에코 폭 [us] → mm (범위 밖 = 트인 공간, 너무 짧으면 버림)
+static inline bool echo_mm(uint32_t echo_us, uint16_t *mm)
+{
+    if (echo_us > 0xFFFFu) { *mm = MAX_VALID_CM * 10u; return true; }
+    const uint16_t v = US_EchoToMm((uint16_t)echo_us);
+    if (v < MIN_VALID_CM * 10u) return false;
+    *mm = (v > MAX_VALID_CM * 10u) ? (uint16_t)(MAX_VALID_CM * 10u) : v;
+    return true;
 }
 
 // [인터럽트 로직] 한 센서의 Rising/Falling 처리 및 거리 계산
-void Sonar_ISR_Process(Sonar_t *sonar)
+static void Sonar_ISR_Process(Sonar_t *s)
 {
-    if (sonar->state == 0) {
-        // [Rising Edge] 시작 시간 기록
-        sonar->ic_start = HAL_TIM_ReadCapturedValue(sonar->timer, sonar->channel);
-        sonar->state = 1; // Falling 대기 상태로 변경
-          // 극성 반전: Rising -> Falling 감지하도록 변경
-        __HAL_TIM_SET_CAPTUREPOLARITY(sonar->timer, sonar->channel, TIM_INPUTCHANNELPOLARITY_FALLING);
+    const SonarDesc_t *d = s->desc;
+    if (s->state == 0) {
+        // [Rising Edge] 시작 시간 기록 → Falling 감지로 극성 반전
+        s->ic_start = HAL_TIM_ReadCapturedValue(d->timer, d->channel);
+        s->state = 1;
+        __HAL_TIM_SET_CAPTUREPOLARITY(d->timer, d->channel, TIM_INPUTCHANNELPOLARITY_FALLING);
     }
-    else if (sonar->state == 1) {
+    else if (s->state == 1) {
         // [Falling Edge] 종료 시간 기록 -> 거리 계산
-        sonar->ic_end = HAL_TIM_ReadCapturedValue(sonar->timer, sonar->channel);
-
-        // 시간 차이 계산 (Timer Overflow 고려)
-        uint32_t diff;
-        if (sonar->ic_end >= sonar->ic_start) {
-            diff = sonar->ic_end - sonar->ic_start;
-        } else {
-            // 타이머가 한 바퀴 돌았을 경우 (16bit 가정: 0xFFFF)
-            // 타이머가 16비트인지 32비트인지에 따라 0xFFFF 혹은 0xFFFFFFFF로 수정 필요
-            diff = (0xFFFF - sonar->ic_start) + sonar->ic_end + 1;
-        }
+        s->ic_end = HAL_TIM_ReadCapturedValue(d->timer, d->channel);
+
+        // 한 바퀴 돌았으면 ARR+1 더함 (16비트 +65536, 32비트는 뺄셈 랩으로 이미 맞음 → +0)
+        uint32_t diff = s->ic_end - s->ic_start;
+        if (s->ic_end < s->ic_start) diff += __HAL_TIM_GET_AUTORELOAD(d->timer) + 1u;
 
-        // 거리 계산 (소리 속도 340m/s -> 1us당 0.034cm -> 왕복이니까 나누기 2 -> 0.017)
-        // 1us tick 기준
-        sonar->distance = (float)diff * 0.017f;
+        uint16_t mm;
+        if (echo_mm(diff, &mm)) s->mm = mm;
 
         // 측정 완료! 인터럽트 끄기 (다음 트리거 때 다시 켬)
-        __HAL_TIM_DISABLE_IT(sonar->timer, sonar->channel);
-        sonar->state = 2; // 완료 상태
+        __HAL_TIM_DISABLE_IT(d->timer, s->it_bit);
+        s->count++;
+        s->state = 2; // 완료 상태
     }
 }
 
+// [분배] 타이머 칸 + 채널 → 센서 (센서 수와 무관)
+void Sonar_Capture(TIM_HandleTypeDef *htim)
+{
+    const uint32_t a = (uint32_t)htim->Channel;
+    if (a > HAL_TIM_ACTIVE_CHANNEL_4) return;
+    const uint8_t ch = CH_OF_ACTIVE[a];
+    const uint8_t t  = tim_slot_of(htim);
+    if (ch == ROUTE_NONE || t == ROUTE_NONE) return;
+    const uint8_t k = route[t][ch];
+    if (k != ROUTE_NONE) Sonar_ISR_Process(&sonar[k]);
+}
+
 // [글로벌 콜백] 하드웨어 인터럽트가 발생하면 여기서 분배함
 void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef *htim)
 {
-    // TIM4에서 온 인터럽트인가?
-    if (htim->Instance == TIM4)
-    {
-        // 채널별로 담당 객체를 호출
-        if (htim->Channel == sonarLeft.channel) {
-            Sonar_ISR_Process(&sonarLeft);
-        }
-        else if (htim->Channel == sonarRight.channel) {
-            Sonar_ISR_Process(&sonarRight);
-        }
-        else if (htim->Channel == sonarCenter.channel) {
-            Sonar_ISR_Process(&sonarCenter);
-        }
-    }
+    const uint32_t t0 = prof_begin();
+    Sonar_Capture(htim);
+    prof_end(SONAR_PROF_CAPTURE, t0);
+}
+
+uint16_t Sonar_GetMm(uint8_t idx)
+{
+    return (idx < sonar_num) ? sonar[idx].mm : (uint16_t)(MAX_VALID_CM * 10u);
 }
 
-float Sonar_Get_Distance(Sonar_t *sonar)
+float Sonar_Get_Distance(uint8_t idx)
 {
-	return (sonar -> distance);
+	return (float)Sonar_GetMm(idx) * 0.1f;
 }